@@ -0,0 +1,5 @@
+int h;
+int far;
+int i;
+int a = 2;
+int b;
@@ -0,0 +1,8 @@
+	.file	"test/input/pch-search-path.c"
+	.data
+	.globl	which
+	.align	4
+	.type	which, @object
+	.size	which, 4
+which:
+	.int	2
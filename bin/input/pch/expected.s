@@ -0,0 +1,47 @@
+	.file	"test/return-struct-integers.c"
+	.text
+	.globl	func
+	.type	func, @function
+func:
+	push	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+.L10:
+	movl	$1, -16(%rbp)
+	movl	$2, -12(%rbp)
+	movq	$3, -8(%rbp)
+	movq	-16(%rbp), %rax
+	movq	-8(%rbp), %rdx
+	leave
+	ret
+	.size	func, .-func
+	.text
+	.globl	main
+	.type	main, @function
+main:
+	push	%rbp
+	movq	%rsp, %rbp
+	push	%rbx
+	push	%r12
+	push	%r13
+	subq	$24, %rsp
+.L12:
+	call	func@PLT
+	movq	%rax, -40(%rbp)
+	movq	%rdx, -32(%rbp)
+	movl	-36(%rbp), %eax
+	addl	-40(%rbp), %eax
+	movl	%eax, %ebx
+	movslq	%ebx, %rax
+	movq	%rax, %r12
+	movq	-32(%rbp), %rax
+	addq	%r12, %rax
+	movq	%rax, %r13
+	movl	%r13d, %eax
+	lea	-24(%rbp), %rsp
+	pop	%r13
+	pop	%r12
+	pop	%rbx
+	leave
+	ret
+	.size	main, .-main
@@ -0,0 +1 @@
+	.file	"test/input/preprocess-thread-error.c"
@@ -0,0 +1,51 @@
+# 1 "test/stringify.c"
+int printf(const char *, ...);
+int puts(const char *);
+
+
+
+static char *c[] = {
+
+ ""
+ ""
+ "\n"
+ "$",
+ "*\\\a\t\\vv"
+ "@ #",
+ "`",
+ "\a\b\f\n\r\t\v\\\?"
+
+
+
+
+ "\001 \77 \x1A \xAt \0a",
+ "2.34",
+ "while",
+ "==",
+ "#",
+ "\"\\\\ \\\" \\t\"",
+ "\"\"",
+ "' '"
+};
+
+static int foo(void) {
+ int n = 0;
+ n += puts("this is some string");
+
+ n += puts("this -= '8' 2u '\\a' \"i\\ns\\t\" '\\n' a \"te\\0st\"");
+ return n;
+}
+
+int main(void) {
+ int i;
+ long n = 0;
+ for (i = 0; i < sizeof(c) / sizeof(*c); ++i) {
+  n += puts(c[i]);
+ }
+
+ n += foo();
+ n += '\302';
+ n += '\x98';
+ n += '\xA';
+ return printf("%ld\n", n);
+}
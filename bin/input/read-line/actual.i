@@ -0,0 +1,6099 @@
+# 1 "src/lacc.c"
+# 42 "src/lacc.c"
+# 1 "src/backend/compile.h" 1
+
+
+
+# 1 "src/backend/x86_64/encoding.h" 1
+
+
+
+# 1 "src/backend/x86_64/abi.h" 1
+
+
+
+# 1 "include/lacc/symbol.h" 1
+
+
+
+
+
+
+# 1 "include/lacc/string.h" 1
+
+
+
+
+
+
+# 1 "/root/repo/bin/include/stddef.h" 1 3 4
+
+
+
+typedef unsigned long size_t;
+typedef signed long ptrdiff_t;
+typedef signed int wchar_t;
+# 8 "include/lacc/string.h" 2
+# 1 "/usr/include/stdio.h" 1 3 4
+# 36 "/usr/include/stdio.h" 3 4
+# 1 "/root/repo/bin/include/stdarg.h" 1 3 4
+
+
+
+
+
+
+
+typedef __builtin_va_list va_list;
+
+
+
+
+typedef __builtin_va_list __gnuc_va_list;
+# 38 "/usr/include/stdio.h" 2 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/types.h" 1 3 4
+# 31 "/usr/include/x86_64-linux-gnu/bits/types.h" 3 4
+typedef unsigned char __u_char;
+typedef unsigned short int __u_short;
+typedef unsigned int __u_int;
+typedef unsigned long int __u_long;
+
+
+typedef signed char __int8_t;
+typedef unsigned char __uint8_t;
+typedef signed short int __int16_t;
+typedef unsigned short int __uint16_t;
+typedef signed int __int32_t;
+typedef unsigned int __uint32_t;
+
+typedef signed long int __int64_t;
+typedef unsigned long int __uint64_t;
+
+
+
+
+
+
+typedef __int8_t __int_least8_t;
+typedef __uint8_t __uint_least8_t;
+typedef __int16_t __int_least16_t;
+typedef __uint16_t __uint_least16_t;
+typedef __int32_t __int_least32_t;
+typedef __uint32_t __uint_least32_t;
+typedef __int64_t __int_least64_t;
+typedef __uint64_t __uint_least64_t;
+
+
+
+typedef long int __quad_t;
+typedef unsigned long int __u_quad_t;
+
+
+
+
+
+
+
+typedef long int __intmax_t;
+typedef unsigned long int __uintmax_t;
+# 145 "/usr/include/x86_64-linux-gnu/bits/types.h" 3 4
+typedef unsigned long int __dev_t;
+typedef unsigned int __uid_t;
+typedef unsigned int __gid_t;
+typedef unsigned long int __ino_t;
+typedef unsigned long int __ino64_t;
+typedef unsigned int __mode_t;
+typedef unsigned long int __nlink_t;
+typedef long int __off_t;
+typedef long int __off64_t;
+typedef int __pid_t;
+typedef struct { int __val[2]; } __fsid_t;
+typedef long int __clock_t;
+typedef unsigned long int __rlim_t;
+typedef unsigned long int __rlim64_t;
+typedef unsigned int __id_t;
+typedef long int __time_t;
+typedef unsigned int __useconds_t;
+typedef long int __suseconds_t;
+typedef long int __suseconds64_t;
+
+typedef int __daddr_t;
+typedef int __key_t;
+
+
+typedef int __clockid_t;
+
+
+typedef void * __timer_t;
+
+
+typedef long int __blksize_t;
+
+
+
+
+typedef long int __blkcnt_t;
+typedef long int __blkcnt64_t;
+
+
+typedef unsigned long int __fsblkcnt_t;
+typedef unsigned long int __fsblkcnt64_t;
+
+
+typedef unsigned long int __fsfilcnt_t;
+typedef unsigned long int __fsfilcnt64_t;
+
+
+typedef long int __fsword_t;
+
+typedef long int __ssize_t;
+
+
+typedef long int __syscall_slong_t;
+
+typedef unsigned long int __syscall_ulong_t;
+
+
+
+typedef __off64_t __loff_t;
+typedef char *__caddr_t;
+
+
+typedef long int __intptr_t;
+
+
+typedef unsigned int __socklen_t;
+
+
+
+
+typedef int __sig_atomic_t;
+# 39 "/usr/include/stdio.h" 2 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/types/__fpos_t.h" 1 3 4
+
+
+
+
+# 1 "/usr/include/x86_64-linux-gnu/bits/types/__mbstate_t.h" 1 3 4
+# 13 "/usr/include/x86_64-linux-gnu/bits/types/__mbstate_t.h" 3 4
+typedef struct
+{
+  int __count;
+  union
+  {
+    unsigned int __wch;
+    char __wchb[4];
+  } __value;
+} __mbstate_t;
+# 6 "/usr/include/x86_64-linux-gnu/bits/types/__fpos_t.h" 2 3 4
+
+
+
+
+typedef struct _G_fpos_t
+{
+  __off_t __pos;
+  __mbstate_t __state;
+} __fpos_t;
+# 40 "/usr/include/stdio.h" 2 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/types/__fpos64_t.h" 1 3 4
+# 10 "/usr/include/x86_64-linux-gnu/bits/types/__fpos64_t.h" 3 4
+typedef struct _G_fpos64_t
+{
+  __off64_t __pos;
+  __mbstate_t __state;
+} __fpos64_t;
+# 41 "/usr/include/stdio.h" 2 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/types/__FILE.h" 1 3 4
+
+
+
+struct _IO_FILE;
+typedef struct _IO_FILE __FILE;
+# 42 "/usr/include/stdio.h" 2 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/types/FILE.h" 1 3 4
+
+
+
+struct _IO_FILE;
+
+
+typedef struct _IO_FILE FILE;
+# 43 "/usr/include/stdio.h" 2 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/types/struct_FILE.h" 1 3 4
+# 35 "/usr/include/x86_64-linux-gnu/bits/types/struct_FILE.h" 3 4
+struct _IO_FILE;
+struct _IO_marker;
+struct _IO_codecvt;
+struct _IO_wide_data;
+
+
+
+
+typedef void _IO_lock_t;
+
+
+
+
+
+struct _IO_FILE
+{
+  int _flags;
+
+
+  char *_IO_read_ptr;
+  char *_IO_read_end;
+  char *_IO_read_base;
+  char *_IO_write_base;
+  char *_IO_write_ptr;
+  char *_IO_write_end;
+  char *_IO_buf_base;
+  char *_IO_buf_end;
+
+
+  char *_IO_save_base;
+  char *_IO_backup_base;
+  char *_IO_save_end;
+
+  struct _IO_marker *_markers;
+
+  struct _IO_FILE *_chain;
+
+  int _fileno;
+  int _flags2;
+  __off_t _old_offset;
+
+
+  unsigned short _cur_column;
+  signed char _vtable_offset;
+  char _shortbuf[1];
+
+  _IO_lock_t *_lock;
+
+
+
+
+
+
+
+  __off64_t _offset;
+
+  struct _IO_codecvt *_codecvt;
+  struct _IO_wide_data *_wide_data;
+  struct _IO_FILE *_freeres_list;
+  void *_freeres_buf;
+  size_t __pad5;
+  int _mode;
+
+  char _unused2[15 * sizeof (int) - 4 * sizeof (void *) - sizeof (size_t)];
+};
+# 44 "/usr/include/stdio.h" 2 3 4
+# 63 "/usr/include/stdio.h" 3 4
+typedef __off_t off_t;
+# 77 "/usr/include/stdio.h" 3 4
+typedef __ssize_t ssize_t;
+
+
+
+
+
+
+typedef __fpos_t fpos_t;
+# 143 "/usr/include/stdio.h" 3 4
+extern FILE *stdin;
+extern FILE *stdout;
+extern FILE *stderr;
+
+
+
+
+
+
+extern int remove (const char *__filename);
+
+extern int rename (const char *__old, const char *__new);
+
+
+
+extern int renameat (int __oldfd, const char *__old, int __newfd,
+       const char *__new);
+# 178 "/usr/include/stdio.h" 3 4
+extern int fclose (FILE *__stream);
+# 188 "/usr/include/stdio.h" 3 4
+extern FILE *tmpfile (void)
+;
+# 205 "/usr/include/stdio.h" 3 4
+extern char *tmpnam (char[20]);
+
+
+
+
+extern char *tmpnam_r (char __s[20]);
+# 222 "/usr/include/stdio.h" 3 4
+extern char *tempnam (const char *__dir, const char *__pfx)
+;
+
+
+
+
+
+
+extern int fflush (FILE *__stream);
+
+
+
+
+
+
+
+
+extern int fflush_unlocked (FILE *__stream);
+# 258 "/usr/include/stdio.h" 3 4
+extern FILE *fopen (const char *restrict __filename,
+      const char *restrict __modes)
+;
+
+
+
+
+extern FILE *freopen (const char *restrict __filename,
+        const char *restrict __modes,
+        FILE *restrict __stream);
+# 293 "/usr/include/stdio.h" 3 4
+extern FILE *fdopen (int __fd, const char *__modes)
+;
+# 308 "/usr/include/stdio.h" 3 4
+extern FILE *fmemopen (void *__s, size_t __len, const char *__modes)
+;
+
+
+
+
+extern FILE *open_memstream (char **__bufloc, size_t *__sizeloc)
+;
+# 328 "/usr/include/stdio.h" 3 4
+extern void setbuf (FILE *restrict __stream, char *restrict __buf);
+
+
+
+extern int setvbuf (FILE *restrict __stream, char *restrict __buf,
+      int __modes, size_t __n);
+
+
+
+
+extern void setbuffer (FILE *restrict __stream, char *restrict __buf,
+         size_t __size);
+
+
+extern void setlinebuf (FILE *__stream);
+
+
+
+
+
+
+
+extern int fprintf (FILE *restrict __stream,
+      const char *restrict __format, ...);
+
+
+
+
+extern int printf (const char *restrict __format, ...);
+
+extern int sprintf (char *restrict __s,
+      const char *restrict __format, ...);
+
+
+
+
+
+extern int vfprintf (FILE *restrict __s, const char *restrict __format,
+       __gnuc_va_list __arg);
+
+
+
+
+extern int vprintf (const char *restrict __format, __gnuc_va_list __arg);
+
+extern int vsprintf (char *restrict __s, const char *restrict __format,
+       __gnuc_va_list __arg);
+
+
+
+extern int snprintf (char *restrict __s, size_t __maxlen,
+       const char *restrict __format, ...)
+;
+
+extern int vsnprintf (char *restrict __s, size_t __maxlen,
+        const char *restrict __format, __gnuc_va_list __arg)
+;
+# 403 "/usr/include/stdio.h" 3 4
+extern int vdprintf (int __fd, const char *restrict __fmt,
+       __gnuc_va_list __arg)
+;
+extern int dprintf (int __fd, const char *restrict __fmt, ...)
+;
+
+
+
+
+
+
+
+extern int fscanf (FILE *restrict __stream,
+     const char *restrict __format, ...);
+
+
+
+
+extern int scanf (const char *restrict __format, ...);
+
+extern int sscanf (const char *restrict __s,
+     const char *restrict __format, ...);
+# 1 "/usr/include/x86_64-linux-gnu/bits/floatn.h" 1 3 4
+# 120 "/usr/include/x86_64-linux-gnu/bits/floatn.h" 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/floatn-common.h" 1 3 4
+# 214 "/usr/include/x86_64-linux-gnu/bits/floatn-common.h" 3 4
+typedef float _Float32;
+# 251 "/usr/include/x86_64-linux-gnu/bits/floatn-common.h" 3 4
+typedef double _Float64;
+# 268 "/usr/include/x86_64-linux-gnu/bits/floatn-common.h" 3 4
+typedef double _Float32x;
+# 285 "/usr/include/x86_64-linux-gnu/bits/floatn-common.h" 3 4
+typedef long double _Float64x;
+# 121 "/usr/include/x86_64-linux-gnu/bits/floatn.h" 2 3 4
+# 426 "/usr/include/stdio.h" 2 3 4
+# 443 "/usr/include/stdio.h" 3 4
+extern int __isoc99_fscanf (FILE *restrict __stream,
+       const char *restrict __format, ...);
+extern int __isoc99_scanf (const char *restrict __format, ...);
+extern int __isoc99_sscanf (const char *restrict __s,
+       const char *restrict __format, ...);
+# 459 "/usr/include/stdio.h" 3 4
+extern int vfscanf (FILE *restrict __s, const char *restrict __format,
+      __gnuc_va_list __arg)
+;
+
+
+
+
+
+extern int vscanf (const char *restrict __format, __gnuc_va_list __arg)
+;
+
+
+extern int vsscanf (const char *restrict __s,
+      const char *restrict __format, __gnuc_va_list __arg)
+;
+# 493 "/usr/include/stdio.h" 3 4
+extern int __isoc99_vfscanf (FILE *restrict __s,
+        const char *restrict __format,
+        __gnuc_va_list __arg);
+extern int __isoc99_vscanf (const char *restrict __format,
+       __gnuc_va_list __arg);
+extern int __isoc99_vsscanf (const char *restrict __s,
+        const char *restrict __format,
+        __gnuc_va_list __arg);
+# 513 "/usr/include/stdio.h" 3 4
+extern int fgetc (FILE *__stream);
+extern int getc (FILE *__stream);
+
+
+
+
+
+extern int getchar (void);
+
+
+
+
+
+
+extern int getc_unlocked (FILE *__stream);
+extern int getchar_unlocked (void);
+# 538 "/usr/include/stdio.h" 3 4
+extern int fgetc_unlocked (FILE *__stream);
+# 549 "/usr/include/stdio.h" 3 4
+extern int fputc (int __c, FILE *__stream);
+extern int putc (int __c, FILE *__stream);
+
+
+
+
+
+extern int putchar (int __c);
+
+
+
+
+
+
+
+
+extern int fputc_unlocked (int __c, FILE *__stream);
+
+
+
+
+
+
+
+extern int putc_unlocked (int __c, FILE *__stream);
+extern int putchar_unlocked (int __c);
+
+
+
+
+
+
+extern int getw (FILE *__stream);
+
+
+extern int putw (int __w, FILE *__stream);
+
+
+
+
+
+
+
+extern char *fgets (char *restrict __s, int __n, FILE *restrict __stream)
+;
+# 605 "/usr/include/stdio.h" 3 4
+extern char *gets (char *__s);
+# 632 "/usr/include/stdio.h" 3 4
+extern __ssize_t __getdelim (char **restrict __lineptr,
+                             size_t *restrict __n, int __delimiter,
+                             FILE *restrict __stream);
+extern __ssize_t getdelim (char **restrict __lineptr,
+                           size_t *restrict __n, int __delimiter,
+                           FILE *restrict __stream);
+
+
+
+
+
+
+
+extern __ssize_t getline (char **restrict __lineptr,
+                          size_t *restrict __n,
+                          FILE *restrict __stream);
+
+
+
+
+
+
+
+extern int fputs (const char *restrict __s, FILE *restrict __stream);
+
+
+
+
+
+extern int puts (const char *__s);
+
+
+
+
+
+
+extern int ungetc (int __c, FILE *__stream);
+
+
+
+
+
+
+extern size_t fread (void *restrict __ptr, size_t __size,
+       size_t __n, FILE *restrict __stream);
+
+
+
+
+extern size_t fwrite (const void *restrict __ptr, size_t __size,
+        size_t __n, FILE *restrict __s);
+# 702 "/usr/include/stdio.h" 3 4
+extern size_t fread_unlocked (void *restrict __ptr, size_t __size,
+         size_t __n, FILE *restrict __stream);
+extern size_t fwrite_unlocked (const void *restrict __ptr, size_t __size,
+          size_t __n, FILE *restrict __stream);
+
+
+
+
+
+
+
+extern int fseek (FILE *__stream, long int __off, int __whence);
+
+
+
+
+extern long int ftell (FILE *__stream);
+
+
+
+
+extern void rewind (FILE *__stream);
+# 736 "/usr/include/stdio.h" 3 4
+extern int fseeko (FILE *__stream, __off_t __off, int __whence);
+
+
+
+
+extern __off_t ftello (FILE *__stream);
+# 760 "/usr/include/stdio.h" 3 4
+extern int fgetpos (FILE *restrict __stream, fpos_t *restrict __pos);
+
+
+
+
+extern int fsetpos (FILE *__stream, const fpos_t *__pos);
+# 786 "/usr/include/stdio.h" 3 4
+extern void clearerr (FILE *__stream);
+
+extern int feof (FILE *__stream);
+
+extern int ferror (FILE *__stream);
+
+
+
+extern void clearerr_unlocked (FILE *__stream);
+extern int feof_unlocked (FILE *__stream);
+extern int ferror_unlocked (FILE *__stream);
+
+
+
+
+
+
+
+extern void perror (const char *__s);
+
+
+
+
+extern int fileno (FILE *__stream);
+
+
+
+
+extern int fileno_unlocked (FILE *__stream);
+
+
+
+
+
+
+
+
+extern int pclose (FILE *__stream);
+
+
+
+
+
+extern FILE *popen (const char *__command, const char *__modes)
+;
+
+
+
+
+
+
+extern char *ctermid (char *__s)
+;
+# 867 "/usr/include/stdio.h" 3 4
+extern void flockfile (FILE *__stream);
+
+
+
+extern int ftrylockfile (FILE *__stream);
+
+
+extern void funlockfile (FILE *__stream);
+# 885 "/usr/include/stdio.h" 3 4
+extern int __uflow (FILE *);
+extern int __overflow (FILE *, int);
+# 9 "include/lacc/string.h" 2
+# 22 "include/lacc/string.h"
+typedef union {
+    struct {
+        unsigned short len;
+        char str[14];
+    } a;
+    struct {
+        unsigned short len;
+        unsigned int size;
+        const char *str;
+    } p;
+    unsigned short len;
+} String;
+# 51 "include/lacc/string.h"
+ String str_init(const char *str);
+
+
+ int str_cmp(String s1, String s2);
+
+
+
+
+
+ const char *str_chr(String s, char c);
+
+
+
+
+
+ int fprintstr(FILE *stream, String str);
+# 8 "include/lacc/symbol.h" 2
+# 1 "include/lacc/token.h" 1
+
+
+
+
+
+
+
+# 1 "include/lacc/type.h" 1
+
+
+
+
+
+
+
+
+# 1 "/usr/include/stdlib.h" 1 3 4
+# 59 "/usr/include/stdlib.h" 3 4
+typedef struct
+  {
+    int quot;
+    int rem;
+  } div_t;
+
+
+
+typedef struct
+  {
+    long int quot;
+    long int rem;
+  } ldiv_t;
+
+
+
+
+
+ typedef struct
+  {
+    long long int quot;
+    long long int rem;
+  } lldiv_t;
+# 98 "/usr/include/stdlib.h" 3 4
+extern size_t __ctype_get_mb_cur_max (void);
+
+
+
+extern double atof (const char *__nptr)
+;
+
+extern int atoi (const char *__nptr)
+;
+
+extern long int atol (const char *__nptr)
+;
+
+
+
+ extern long long int atoll (const char *__nptr)
+;
+
+
+
+extern double strtod (const char *restrict __nptr,
+        char **restrict __endptr)
+;
+
+
+
+extern float strtof (const char *restrict __nptr,
+       char **restrict __endptr);
+
+extern long double strtold (const char *restrict __nptr,
+       char **restrict __endptr)
+;
+# 177 "/usr/include/stdlib.h" 3 4
+extern long int strtol (const char *restrict __nptr,
+   char **restrict __endptr, int __base)
+;
+
+extern unsigned long int strtoul (const char *restrict __nptr,
+      char **restrict __endptr, int __base)
+;
+
+
+
+
+extern long long int strtoq (const char *restrict __nptr,
+        char **restrict __endptr, int __base)
+;
+
+
+extern unsigned long long int strtouq (const char *restrict __nptr,
+           char **restrict __endptr, int __base)
+;
+
+
+
+
+
+extern long long int strtoll (const char *restrict __nptr,
+         char **restrict __endptr, int __base)
+;
+
+
+extern unsigned long long int strtoull (const char *restrict __nptr,
+     char **restrict __endptr, int __base)
+;
+# 386 "/usr/include/stdlib.h" 3 4
+extern char *l64a (long int __n);
+
+
+extern long int a64l (const char *__s)
+;
+# 1 "/usr/include/x86_64-linux-gnu/sys/types.h" 1 3 4
+# 33 "/usr/include/x86_64-linux-gnu/sys/types.h" 3 4
+typedef __u_char u_char;
+typedef __u_short u_short;
+typedef __u_int u_int;
+typedef __u_long u_long;
+typedef __quad_t quad_t;
+typedef __u_quad_t u_quad_t;
+typedef __fsid_t fsid_t;
+
+
+typedef __loff_t loff_t;
+
+
+
+
+typedef __ino_t ino_t;
+# 59 "/usr/include/x86_64-linux-gnu/sys/types.h" 3 4
+typedef __dev_t dev_t;
+
+
+
+
+typedef __gid_t gid_t;
+
+
+
+
+typedef __mode_t mode_t;
+
+
+
+
+typedef __nlink_t nlink_t;
+
+
+
+
+typedef __uid_t uid_t;
+# 97 "/usr/include/x86_64-linux-gnu/sys/types.h" 3 4
+typedef __pid_t pid_t;
+
+
+
+
+
+typedef __id_t id_t;
+# 114 "/usr/include/x86_64-linux-gnu/sys/types.h" 3 4
+typedef __daddr_t daddr_t;
+typedef __caddr_t caddr_t;
+
+
+
+
+
+typedef __key_t key_t;
+# 1 "/usr/include/x86_64-linux-gnu/bits/types/clock_t.h" 1 3 4
+
+
+
+
+
+
+typedef __clock_t clock_t;
+# 128 "/usr/include/x86_64-linux-gnu/sys/types.h" 2 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/types/clockid_t.h" 1 3 4
+
+
+
+
+
+
+typedef __clockid_t clockid_t;
+# 129 "/usr/include/x86_64-linux-gnu/sys/types.h" 2 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/types/time_t.h" 1 3 4
+# 10 "/usr/include/x86_64-linux-gnu/bits/types/time_t.h" 3 4
+typedef __time_t time_t;
+# 130 "/usr/include/x86_64-linux-gnu/sys/types.h" 2 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/types/timer_t.h" 1 3 4
+
+
+
+
+
+
+typedef __timer_t timer_t;
+# 131 "/usr/include/x86_64-linux-gnu/sys/types.h" 2 3 4
+# 148 "/usr/include/x86_64-linux-gnu/sys/types.h" 3 4
+typedef unsigned long int ulong;
+typedef unsigned short int ushort;
+typedef unsigned int uint;
+# 1 "/usr/include/x86_64-linux-gnu/bits/stdint-intn.h" 1 3 4
+# 24 "/usr/include/x86_64-linux-gnu/bits/stdint-intn.h" 3 4
+typedef __int8_t int8_t;
+typedef __int16_t int16_t;
+typedef __int32_t int32_t;
+typedef __int64_t int64_t;
+# 152 "/usr/include/x86_64-linux-gnu/sys/types.h" 2 3 4
+
+
+
+
+
+
+typedef __uint8_t u_int8_t;
+typedef __uint16_t u_int16_t;
+typedef __uint32_t u_int32_t;
+typedef __uint64_t u_int64_t;
+
+
+
+
+typedef int register_t;
+# 1 "/usr/include/endian.h" 1 3 4
+# 35 "/usr/include/endian.h" 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/byteswap.h" 1 3 4
+# 33 "/usr/include/x86_64-linux-gnu/bits/byteswap.h" 3 4
+static inline __uint16_t
+__bswap_16 (__uint16_t __bsx)
+{
+
+
+
+  return ((__uint16_t) (((( __bsx) >> 8) & 0xff) | ((( __bsx) & 0xff) << 8)));
+
+}
+
+
+
+
+
+
+static inline __uint32_t
+__bswap_32 (__uint32_t __bsx)
+{
+
+
+
+  return (((( __bsx) & 0xff000000u) >> 24) | ((( __bsx) & 0x00ff0000u) >> 8)    | ((( __bsx) & 0x0000ff00u) << 8) | ((( __bsx) & 0x000000ffu) << 24));
+
+}
+# 69 "/usr/include/x86_64-linux-gnu/bits/byteswap.h" 3 4
+ static inline __uint64_t
+__bswap_64 (__uint64_t __bsx)
+{
+
+
+
+  return (((( __bsx) & 0xff00000000000000ull) >> 56)    | ((( __bsx) & 0x00ff000000000000ull) >> 40)    | ((( __bsx) & 0x0000ff0000000000ull) >> 24)    | ((( __bsx) & 0x000000ff00000000ull) >> 8)    | ((( __bsx) & 0x00000000ff000000ull) << 8)    | ((( __bsx) & 0x0000000000ff0000ull) << 24)    | ((( __bsx) & 0x000000000000ff00ull) << 40)    | ((( __bsx) & 0x00000000000000ffull) << 56));
+
+}
+# 36 "/usr/include/endian.h" 2 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/uintn-identity.h" 1 3 4
+# 32 "/usr/include/x86_64-linux-gnu/bits/uintn-identity.h" 3 4
+static inline __uint16_t
+__uint16_identity (__uint16_t __x)
+{
+  return __x;
+}
+
+static inline __uint32_t
+__uint32_identity (__uint32_t __x)
+{
+  return __x;
+}
+
+static inline __uint64_t
+__uint64_identity (__uint64_t __x)
+{
+  return __x;
+}
+# 37 "/usr/include/endian.h" 2 3 4
+# 179 "/usr/include/x86_64-linux-gnu/sys/types.h" 2 3 4
+# 1 "/usr/include/x86_64-linux-gnu/sys/select.h" 1 3 4
+# 33 "/usr/include/x86_64-linux-gnu/sys/select.h" 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/types/sigset_t.h" 1 3 4
+
+
+
+# 1 "/usr/include/x86_64-linux-gnu/bits/types/__sigset_t.h" 1 3 4
+
+
+
+
+typedef struct
+{
+  unsigned long int __val[(1024 / (8 * sizeof (unsigned long int)))];
+} __sigset_t;
+# 5 "/usr/include/x86_64-linux-gnu/bits/types/sigset_t.h" 2 3 4
+
+
+typedef __sigset_t sigset_t;
+# 37 "/usr/include/x86_64-linux-gnu/sys/select.h" 2 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/types/struct_timeval.h" 1 3 4
+
+
+
+
+
+
+
+struct timeval
+{
+
+
+
+
+  __time_t tv_sec;
+  __suseconds_t tv_usec;
+
+};
+# 39 "/usr/include/x86_64-linux-gnu/sys/select.h" 2 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/types/struct_timespec.h" 1 3 4
+# 11 "/usr/include/x86_64-linux-gnu/bits/types/struct_timespec.h" 3 4
+struct timespec
+{
+
+
+
+  __time_t tv_sec;
+
+
+
+
+  __syscall_slong_t tv_nsec;
+# 31 "/usr/include/x86_64-linux-gnu/bits/types/struct_timespec.h" 3 4
+};
+# 40 "/usr/include/x86_64-linux-gnu/sys/select.h" 2 3 4
+
+
+
+typedef __suseconds_t suseconds_t;
+
+
+
+
+
+typedef long int __fd_mask;
+# 59 "/usr/include/x86_64-linux-gnu/sys/select.h" 3 4
+typedef struct
+  {
+
+
+
+
+
+
+    __fd_mask __fds_bits[1024 / (8 * (int) sizeof (__fd_mask))];
+
+
+  } fd_set;
+
+
+
+
+
+
+typedef __fd_mask fd_mask;
+# 102 "/usr/include/x86_64-linux-gnu/sys/select.h" 3 4
+extern int select (int __nfds, fd_set *restrict __readfds,
+     fd_set *restrict __writefds,
+     fd_set *restrict __exceptfds,
+     struct timeval *restrict __timeout);
+# 127 "/usr/include/x86_64-linux-gnu/sys/select.h" 3 4
+extern int pselect (int __nfds, fd_set *restrict __readfds,
+      fd_set *restrict __writefds,
+      fd_set *restrict __exceptfds,
+      const struct timespec *restrict __timeout,
+      const __sigset_t *restrict __sigmask);
+# 180 "/usr/include/x86_64-linux-gnu/sys/types.h" 2 3 4
+
+
+
+
+
+typedef __blksize_t blksize_t;
+
+
+
+
+
+
+typedef __blkcnt_t blkcnt_t;
+
+
+
+typedef __fsblkcnt_t fsblkcnt_t;
+
+
+
+typedef __fsfilcnt_t fsfilcnt_t;
+# 1 "/usr/include/x86_64-linux-gnu/bits/pthreadtypes.h" 1 3 4
+# 23 "/usr/include/x86_64-linux-gnu/bits/pthreadtypes.h" 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/thread-shared-types.h" 1 3 4
+# 46 "/usr/include/x86_64-linux-gnu/bits/thread-shared-types.h" 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/atomic_wide_counter.h" 1 3 4
+# 25 "/usr/include/x86_64-linux-gnu/bits/atomic_wide_counter.h" 3 4
+typedef union
+{
+ unsigned long long int __value64;
+  struct
+  {
+    unsigned int __low;
+    unsigned int __high;
+  } __value32;
+} __atomic_wide_counter;
+# 47 "/usr/include/x86_64-linux-gnu/bits/thread-shared-types.h" 2 3 4
+
+
+
+
+typedef struct __pthread_internal_list
+{
+  struct __pthread_internal_list *__prev;
+  struct __pthread_internal_list *__next;
+} __pthread_list_t;
+
+typedef struct __pthread_internal_slist
+{
+  struct __pthread_internal_slist *__next;
+} __pthread_slist_t;
+# 1 "/usr/include/x86_64-linux-gnu/bits/struct_mutex.h" 1 3 4
+# 22 "/usr/include/x86_64-linux-gnu/bits/struct_mutex.h" 3 4
+struct __pthread_mutex_s
+{
+  int __lock;
+  unsigned int __count;
+  int __owner;
+
+  unsigned int __nusers;
+
+
+
+  int __kind;
+
+  short __spins;
+  short __elision;
+  __pthread_list_t __list;
+# 53 "/usr/include/x86_64-linux-gnu/bits/struct_mutex.h" 3 4
+};
+# 89 "/usr/include/x86_64-linux-gnu/bits/thread-shared-types.h" 2 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/struct_rwlock.h" 1 3 4
+# 23 "/usr/include/x86_64-linux-gnu/bits/struct_rwlock.h" 3 4
+struct __pthread_rwlock_arch_t
+{
+  unsigned int __readers;
+  unsigned int __writers;
+  unsigned int __wrphase_futex;
+  unsigned int __writers_futex;
+  unsigned int __pad3;
+  unsigned int __pad4;
+
+  int __cur_writer;
+  int __shared;
+  signed char __rwelision;
+
+
+
+
+  unsigned char __pad1[7];
+
+
+  unsigned long int __pad2;
+
+
+  unsigned int __flags;
+# 55 "/usr/include/x86_64-linux-gnu/bits/struct_rwlock.h" 3 4
+};
+# 90 "/usr/include/x86_64-linux-gnu/bits/thread-shared-types.h" 2 3 4
+
+
+
+
+struct __pthread_cond_s
+{
+  __atomic_wide_counter __wseq;
+  __atomic_wide_counter __g1_start;
+  unsigned int __g_refs[2];
+  unsigned int __g_size[2];
+  unsigned int __g1_orig_size;
+  unsigned int __wrefs;
+  unsigned int __g_signals[2];
+};
+
+typedef unsigned int __tss_t;
+typedef unsigned long int __thrd_t;
+
+typedef struct
+{
+  int __data;
+} __once_flag;
+# 24 "/usr/include/x86_64-linux-gnu/bits/pthreadtypes.h" 2 3 4
+
+
+
+typedef unsigned long int pthread_t;
+
+
+
+
+typedef union
+{
+  char __size[4];
+  int __align;
+} pthread_mutexattr_t;
+
+
+
+
+typedef union
+{
+  char __size[4];
+  int __align;
+} pthread_condattr_t;
+
+
+
+typedef unsigned int pthread_key_t;
+
+
+
+typedef int pthread_once_t;
+
+
+union pthread_attr_t
+{
+  char __size[56];
+  long int __align;
+};
+
+typedef union pthread_attr_t pthread_attr_t;
+
+
+
+
+typedef union
+{
+  struct __pthread_mutex_s __data;
+  char __size[40];
+  long int __align;
+} pthread_mutex_t;
+
+
+typedef union
+{
+  struct __pthread_cond_s __data;
+  char __size[48];
+ long long int __align;
+} pthread_cond_t;
+
+
+
+
+
+typedef union
+{
+  struct __pthread_rwlock_arch_t __data;
+  char __size[56];
+  long int __align;
+} pthread_rwlock_t;
+
+typedef union
+{
+  char __size[8];
+  long int __align;
+} pthread_rwlockattr_t;
+
+
+
+
+
+typedef volatile int pthread_spinlock_t;
+
+
+
+
+typedef union
+{
+  char __size[32];
+  long int __align;
+} pthread_barrier_t;
+
+typedef union
+{
+  char __size[4];
+  int __align;
+} pthread_barrierattr_t;
+# 202 "/usr/include/x86_64-linux-gnu/sys/types.h" 2 3 4
+# 392 "/usr/include/stdlib.h" 2 3 4
+# 402 "/usr/include/stdlib.h" 3 4
+extern long int random (void);
+
+
+extern void srandom (unsigned int __seed);
+
+
+
+
+
+extern char *initstate (unsigned int __seed, char *__statebuf,
+   size_t __statelen);
+
+
+
+extern char *setstate (char *__statebuf);
+
+
+
+
+
+
+
+struct random_data
+  {
+    int32_t *fptr;
+    int32_t *rptr;
+    int32_t *state;
+    int rand_type;
+    int rand_deg;
+    int rand_sep;
+    int32_t *end_ptr;
+  };
+
+extern int random_r (struct random_data *restrict __buf,
+       int32_t *restrict __result);
+
+extern int srandom_r (unsigned int __seed, struct random_data *__buf)
+;
+
+extern int initstate_r (unsigned int __seed, char *restrict __statebuf,
+   size_t __statelen,
+   struct random_data *restrict __buf)
+;
+
+extern int setstate_r (char *restrict __statebuf,
+         struct random_data *restrict __buf)
+;
+
+
+
+
+
+extern int rand (void);
+
+extern void srand (unsigned int __seed);
+
+
+
+extern int rand_r (unsigned int *__seed);
+
+
+
+
+
+
+
+extern double drand48 (void);
+extern double erand48 (unsigned short int __xsubi[3]);
+
+
+extern long int lrand48 (void);
+extern long int nrand48 (unsigned short int __xsubi[3])
+;
+
+
+extern long int mrand48 (void);
+extern long int jrand48 (unsigned short int __xsubi[3])
+;
+
+
+extern void srand48 (long int __seedval);
+extern unsigned short int *seed48 (unsigned short int __seed16v[3])
+;
+extern void lcong48 (unsigned short int __param[7]);
+
+
+
+
+
+struct drand48_data
+  {
+    unsigned short int __x[3];
+    unsigned short int __old_x[3];
+    unsigned short int __c;
+    unsigned short int __init;
+
+ unsigned long long int __a;
+  };
+
+
+extern int drand48_r (struct drand48_data *restrict __buffer,
+        double *restrict __result);
+extern int erand48_r (unsigned short int __xsubi[3],
+        struct drand48_data *restrict __buffer,
+        double *restrict __result);
+
+
+extern int lrand48_r (struct drand48_data *restrict __buffer,
+        long int *restrict __result)
+;
+extern int nrand48_r (unsigned short int __xsubi[3],
+        struct drand48_data *restrict __buffer,
+        long int *restrict __result)
+;
+
+
+extern int mrand48_r (struct drand48_data *restrict __buffer,
+        long int *restrict __result)
+;
+extern int jrand48_r (unsigned short int __xsubi[3],
+        struct drand48_data *restrict __buffer,
+        long int *restrict __result)
+;
+
+
+extern int srand48_r (long int __seedval, struct drand48_data *__buffer)
+;
+
+extern int seed48_r (unsigned short int __seed16v[3],
+       struct drand48_data *__buffer);
+
+extern int lcong48_r (unsigned short int __param[7],
+        struct drand48_data *__buffer)
+;
+
+
+extern __uint32_t arc4random (void)
+;
+
+
+extern void arc4random_buf (void *__buf, size_t __size)
+;
+
+
+
+extern __uint32_t arc4random_uniform (__uint32_t __upper_bound)
+;
+
+
+
+
+extern void *malloc (size_t __size)
+;
+
+extern void *calloc (size_t __nmemb, size_t __size)
+;
+
+
+
+
+
+
+extern void *realloc (void *__ptr, size_t __size)
+;
+
+
+extern void free (void *__ptr);
+
+
+
+
+
+
+
+extern void *reallocarray (void *__ptr, size_t __nmemb, size_t __size)
+
+
+;
+
+
+extern void *reallocarray (void *__ptr, size_t __nmemb, size_t __size)
+;
+# 593 "/usr/include/stdlib.h" 3 4
+extern void *valloc (size_t __size)
+;
+
+
+
+
+extern int posix_memalign (void **__memptr, size_t __alignment, size_t __size)
+;
+# 611 "/usr/include/stdlib.h" 3 4
+extern void abort (void);
+
+
+
+extern int atexit (void (*__func) (void));
+# 630 "/usr/include/stdlib.h" 3 4
+extern int on_exit (void (*__func) (int __status, void *__arg), void *__arg)
+;
+
+
+
+
+
+extern void exit (int __status);
+# 649 "/usr/include/stdlib.h" 3 4
+extern void _Exit (int __status);
+
+
+
+
+extern char *getenv (const char *__name);
+# 667 "/usr/include/stdlib.h" 3 4
+extern int putenv (char *__string);
+
+
+
+
+
+extern int setenv (const char *__name, const char *__value, int __replace)
+;
+
+
+extern int unsetenv (const char *__name);
+
+
+
+
+
+
+extern int clearenv (void);
+# 695 "/usr/include/stdlib.h" 3 4
+extern char *mktemp (char *__template);
+# 708 "/usr/include/stdlib.h" 3 4
+extern int mkstemp (char *__template);
+# 730 "/usr/include/stdlib.h" 3 4
+extern int mkstemps (char *__template, int __suffixlen);
+# 751 "/usr/include/stdlib.h" 3 4
+extern char *mkdtemp (char *__template);
+# 804 "/usr/include/stdlib.h" 3 4
+extern int system (const char *__command);
+# 821 "/usr/include/stdlib.h" 3 4
+extern char *realpath (const char *restrict __name,
+         char *restrict __resolved);
+
+
+
+
+
+
+typedef int (*__compar_fn_t) (const void *, const void *);
+# 841 "/usr/include/stdlib.h" 3 4
+extern void *bsearch (const void *__key, const void *__base,
+        size_t __nmemb, size_t __size, __compar_fn_t __compar)
+;
+
+
+
+
+
+
+
+extern void qsort (void *__base, size_t __nmemb, size_t __size,
+     __compar_fn_t __compar);
+
+
+
+
+
+
+
+
+extern int abs (int __x);
+extern long int labs (long int __x);
+
+
+ extern long long int llabs (long long int __x)
+;
+
+
+
+
+
+
+extern div_t div (int __numer, int __denom)
+;
+extern ldiv_t ldiv (long int __numer, long int __denom)
+;
+
+
+ extern lldiv_t lldiv (long long int __numer,
+        long long int __denom)
+;
+# 893 "/usr/include/stdlib.h" 3 4
+extern char *ecvt (double __value, int __ndigit, int *restrict __decpt,
+     int *restrict __sign);
+
+
+
+
+extern char *fcvt (double __value, int __ndigit, int *restrict __decpt,
+     int *restrict __sign);
+
+
+
+
+extern char *gcvt (double __value, int __ndigit, char *__buf)
+;
+
+
+
+
+extern char *qecvt (long double __value, int __ndigit,
+      int *restrict __decpt, int *restrict __sign)
+;
+extern char *qfcvt (long double __value, int __ndigit,
+      int *restrict __decpt, int *restrict __sign)
+;
+extern char *qgcvt (long double __value, int __ndigit, char *__buf)
+;
+
+
+
+
+extern int ecvt_r (double __value, int __ndigit, int *restrict __decpt,
+     int *restrict __sign, char *restrict __buf,
+     size_t __len);
+extern int fcvt_r (double __value, int __ndigit, int *restrict __decpt,
+     int *restrict __sign, char *restrict __buf,
+     size_t __len);
+
+extern int qecvt_r (long double __value, int __ndigit,
+      int *restrict __decpt, int *restrict __sign,
+      char *restrict __buf, size_t __len)
+;
+extern int qfcvt_r (long double __value, int __ndigit,
+      int *restrict __decpt, int *restrict __sign,
+      char *restrict __buf, size_t __len)
+;
+
+
+
+
+
+extern int mblen (const char *__s, size_t __n);
+
+
+extern int mbtowc (wchar_t *restrict __pwc,
+     const char *restrict __s, size_t __n);
+
+
+extern int wctomb (char *__s, wchar_t __wchar);
+
+
+
+extern size_t mbstowcs (wchar_t *restrict  __pwcs,
+   const char *restrict __s, size_t __n)
+;
+
+extern size_t wcstombs (char *restrict __s,
+   const wchar_t *restrict __pwcs, size_t __n)
+
+
+;
+
+
+
+
+
+
+extern int rpmatch (const char *__response);
+# 980 "/usr/include/stdlib.h" 3 4
+extern int getsubopt (char **restrict __optionp,
+        char *const *restrict __tokens,
+        char **restrict __valuep)
+;
+# 1026 "/usr/include/stdlib.h" 3 4
+extern int getloadavg (double __loadavg[], int __nelem)
+;
+# 10 "include/lacc/type.h" 2
+# 1 "/usr/include/string.h" 1 3 4
+# 43 "/usr/include/string.h" 3 4
+extern void *memcpy (void *restrict __dest, const void *restrict __src,
+       size_t __n);
+
+
+extern void *memmove (void *__dest, const void *__src, size_t __n)
+;
+
+
+
+
+
+extern void *memccpy (void *restrict __dest, const void *restrict __src,
+        int __c, size_t __n)
+;
+
+
+
+
+extern void *memset (void *__s, int __c, size_t __n);
+
+
+extern int memcmp (const void *__s1, const void *__s2, size_t __n)
+;
+# 80 "/usr/include/string.h" 3 4
+extern int __memcmpeq (const void *__s1, const void *__s2, size_t __n)
+;
+# 107 "/usr/include/string.h" 3 4
+extern void *memchr (const void *__s, int __c, size_t __n)
+;
+# 141 "/usr/include/string.h" 3 4
+extern char *strcpy (char *restrict __dest, const char *restrict __src)
+;
+
+extern char *strncpy (char *restrict __dest,
+        const char *restrict __src, size_t __n)
+;
+
+
+extern char *strcat (char *restrict __dest, const char *restrict __src)
+;
+
+extern char *strncat (char *restrict __dest, const char *restrict __src,
+        size_t __n);
+
+
+extern int strcmp (const char *__s1, const char *__s2)
+;
+
+extern int strncmp (const char *__s1, const char *__s2, size_t __n)
+;
+
+
+extern int strcoll (const char *__s1, const char *__s2)
+;
+
+extern size_t strxfrm (char *restrict __dest,
+         const char *restrict __src, size_t __n)
+;
+# 1 "/usr/include/x86_64-linux-gnu/bits/types/locale_t.h" 1 3 4
+# 22 "/usr/include/x86_64-linux-gnu/bits/types/locale_t.h" 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/types/__locale_t.h" 1 3 4
+# 27 "/usr/include/x86_64-linux-gnu/bits/types/__locale_t.h" 3 4
+struct __locale_struct
+{
+
+  struct __locale_data *__locales[13];
+
+
+  const unsigned short int *__ctype_b;
+  const int *__ctype_tolower;
+  const int *__ctype_toupper;
+
+
+  const char *__names[13];
+};
+
+typedef struct __locale_struct *__locale_t;
+# 23 "/usr/include/x86_64-linux-gnu/bits/types/locale_t.h" 2 3 4
+
+typedef __locale_t locale_t;
+# 170 "/usr/include/string.h" 2 3 4
+
+
+
+
+
+extern int strcoll_l (const char *__s1, const char *__s2, locale_t __l)
+;
+
+
+extern size_t strxfrm_l (char *__dest, const char *__src, size_t __n,
+    locale_t __l)
+;
+
+
+
+
+
+extern char *strdup (const char *__s)
+;
+
+
+
+
+
+
+extern char *strndup (const char *__string, size_t __n)
+;
+# 246 "/usr/include/string.h" 3 4
+extern char *strchr (const char *__s, int __c)
+;
+# 273 "/usr/include/string.h" 3 4
+extern char *strrchr (const char *__s, int __c)
+;
+# 293 "/usr/include/string.h" 3 4
+extern size_t strcspn (const char *__s, const char *__reject)
+;
+
+
+extern size_t strspn (const char *__s, const char *__accept)
+;
+# 323 "/usr/include/string.h" 3 4
+extern char *strpbrk (const char *__s, const char *__accept)
+;
+# 350 "/usr/include/string.h" 3 4
+extern char *strstr (const char *__haystack, const char *__needle)
+;
+
+
+
+
+extern char *strtok (char *restrict __s, const char *restrict __delim)
+;
+
+
+
+extern char *__strtok_r (char *restrict __s,
+    const char *restrict __delim,
+    char **restrict __save_ptr)
+;
+
+extern char *strtok_r (char *restrict __s, const char *restrict __delim,
+         char **restrict __save_ptr)
+;
+# 407 "/usr/include/string.h" 3 4
+extern size_t strlen (const char *__s)
+;
+
+
+
+
+extern size_t strnlen (const char *__string, size_t __maxlen)
+;
+
+
+
+
+extern char *strerror (int __errnum);
+# 437 "/usr/include/string.h" 3 4
+extern int __xpg_strerror_r (int __errnum, char *__buf, size_t __buflen)
+;
+# 458 "/usr/include/string.h" 3 4
+extern char *strerror_l (int __errnum, locale_t __l);
+# 1 "/usr/include/strings.h" 1 3 4
+# 34 "/usr/include/strings.h" 3 4
+extern int bcmp (const void *__s1, const void *__s2, size_t __n)
+;
+
+
+extern void bcopy (const void *__src, void *__dest, size_t __n)
+;
+
+
+extern void bzero (void *__s, size_t __n);
+# 68 "/usr/include/strings.h" 3 4
+extern char *index (const char *__s, int __c)
+;
+# 96 "/usr/include/strings.h" 3 4
+extern char *rindex (const char *__s, int __c)
+;
+
+
+
+
+
+
+extern int ffs (int __i);
+
+
+
+
+
+extern int ffsl (long int __l);
+ extern int ffsll (long long int __ll)
+;
+
+
+
+extern int strcasecmp (const char *__s1, const char *__s2)
+;
+
+
+extern int strncasecmp (const char *__s1, const char *__s2, size_t __n)
+;
+
+
+
+
+
+
+extern int strcasecmp_l (const char *__s1, const char *__s2, locale_t __loc)
+;
+
+
+
+extern int strncasecmp_l (const char *__s1, const char *__s2,
+     size_t __n, locale_t __loc)
+;
+# 460 "/usr/include/string.h" 2 3 4
+
+
+
+
+
+
+extern void explicit_bzero (void *__s, size_t __n)
+;
+
+
+
+extern char *strsep (char **restrict __stringp,
+       const char *restrict __delim)
+;
+
+
+
+
+extern char *strsignal (int __sig);
+# 489 "/usr/include/string.h" 3 4
+extern char *__stpcpy (char *restrict __dest, const char *restrict __src)
+;
+extern char *stpcpy (char *restrict __dest, const char *restrict __src)
+;
+
+
+
+extern char *__stpncpy (char *restrict __dest,
+   const char *restrict __src, size_t __n)
+;
+extern char *stpncpy (char *restrict __dest,
+        const char *restrict __src, size_t __n)
+;
+# 11 "include/lacc/type.h" 2
+
+enum type {
+    T_VOID,
+    T_BOOL,
+    T_CHAR,
+    T_SHORT,
+    T_INT,
+    T_LONG,
+    T_FLOAT,
+    T_DOUBLE,
+    T_LDOUBLE,
+    T_POINTER,
+    T_FUNCTION,
+    T_ARRAY,
+    T_STRUCT,
+    T_UNION
+};
+# 46 "include/lacc/type.h"
+typedef struct {
+    int type : 5;
+    unsigned int is_unsigned : 1;
+    unsigned int is_const : 1;
+    unsigned int is_volatile : 1;
+    unsigned int is_restrict : 1;
+    unsigned int is_pointer : 1;
+    unsigned int is_pointer_const : 1;
+    unsigned int is_pointer_volatile : 1;
+    unsigned int is_pointer_restrict : 1;
+    unsigned int ref : 19;
+} Type;
+# 91 "include/lacc/type.h"
+extern const Type
+    basic_type__void,
+    basic_type__bool,
+    basic_type__char,
+    basic_type__short,
+    basic_type__int,
+    basic_type__long,
+    basic_type__unsigned_char,
+    basic_type__unsigned_short,
+    basic_type__unsigned_int,
+    basic_type__unsigned_long,
+    basic_type__float,
+    basic_type__double,
+    basic_type__long_double;
+# 128 "include/lacc/type.h"
+struct member {
+    String name;
+    Type type;
+    size_t offset;
+    short field_width;
+    short field_offset;
+    short field_backing;
+    struct symbol *sym;
+};
+
+
+ int nmembers(Type type);
+
+
+ struct member *get_member(Type type, int n);
+
+
+ Type type_next(Type type);
+
+
+ int is_vararg(Type type);
+
+
+
+
+
+ int is_vla(Type type);
+
+
+
+
+
+ int is_flexible(Type type);
+
+
+ size_t size_of(Type type);
+
+
+ size_t type_alignment(Type type);
+
+
+ int type_equal(Type l, Type r);
+
+
+
+
+
+ Type usual_arithmetic_conversion(Type t1, Type t2);
+
+
+
+
+
+ int fprinttype(FILE *stream, Type type, const struct symbol *expand);
+# 9 "include/lacc/token.h" 2
+
+
+
+
+
+
+
+enum token_type {
+    END = 0,
+    AUTO,
+    BREAK,
+    CASE,
+    CHAR,
+    CONST,
+    CONTINUE,
+    DEFAULT,
+    DO,
+    DOUBLE,
+    NEWLINE = '\n',
+    ELSE,
+    ENUM,
+    EXTERN,
+    FLOAT,
+    FOR,
+    GOTO,
+    IF,
+    INT,
+    LONG,
+    REGISTER,
+    RETURN,
+    SHORT,
+    SIGNED,
+    SIZEOF,
+    STATIC,
+    STRUCT,
+    SWITCH,
+    TYPEDEF,
+    UNION,
+    UNSIGNED,
+    VOID,
+    INLINE,
+
+    NOT = '!',
+    VOLATILE,
+    HASH = '#',
+    DOLLAR = '$',
+    MODULO = '%',
+    AND = '&',
+    WHILE,
+
+    OPEN_PAREN = '(',
+    CLOSE_PAREN = ')',
+    STAR = '*',
+    PLUS = '+',
+    COMMA = ',',
+    MINUS = '-',
+    DOT = '.',
+    SLASH = '/',
+    RESTRICT,
+    ALIGNOF,
+    BOOL,
+
+    STATIC_ASSERT = BOOL + 6,
+
+    COLON = ':',
+    SEMICOLON = ';',
+    LT = '<',
+    ASSIGN = '=',
+    GT = '>',
+    QUESTION = '?',
+    AMPERSAND = '@',
+    LOGICAL_OR,
+    LOGICAL_AND,
+    LEQ,
+    GEQ,
+    EQ,
+    NEQ,
+    ARROW,
+    INCREMENT,
+    DECREMENT,
+    LSHIFT,
+    RSHIFT,
+    MUL_ASSIGN,
+    DIV_ASSIGN,
+    MOD_ASSIGN,
+    PLUS_ASSIGN,
+    MINUS_ASSIGN,
+    LSHIFT_ASSIGN,
+    RSHIFT_ASSIGN,
+    AND_ASSIGN,
+    XOR_ASSIGN,
+    OR_ASSIGN,
+    TOKEN_PASTE,
+    DOTS,
+
+    OPEN_BRACKET = '[',
+    BACKSLASH = '\\',
+    CLOSE_BRACKET = ']',
+    XOR = '^',
+    BACKTICK = '`',
+    OPEN_CURLY = '{',
+    OR = '|',
+    CLOSE_CURLY = '}',
+    NEG = '~',
+
+
+    ASM = 0x68,
+
+
+
+
+
+    NUMBER = 116,
+    IDENTIFIER,
+    STRING,
+
+
+
+
+
+    PARAM,
+
+
+
+
+
+
+    PREP_NUMBER,
+    PREP_CHAR,
+    PREP_STRING
+};
+
+
+
+
+
+union value {
+    unsigned long u;
+    signed long i;
+    float f;
+    double d;
+    long double ld;
+};
+
+ union value convert(union value val, Type from, Type to);
+# 163 "include/lacc/token.h"
+struct token {
+    enum token_type token;
+    unsigned int leading_whitespace : 16;
+    unsigned int is_expandable : 1;
+    unsigned int disable_expand : 1;
+    Type type;
+
+
+
+
+
+    unsigned int id;
+
+    union {
+        String string;
+        union value val;
+    } d;
+};
+
+
+ struct token peek(void);
+
+
+ struct token peekn(int n);
+
+
+ struct token next(void);
+
+
+ struct token consume(enum token_type type);
+
+struct macro;
+struct symbol;
+# 206 "include/lacc/token.h"
+struct ident {
+    String name;
+    unsigned int id;
+    struct macro *macro;
+    struct symbol *sym;
+    struct symbol *tag;
+    struct symbol *label;
+};
+
+
+ unsigned int ident_register(const char *str, size_t len);
+
+
+ struct ident *ident_get(unsigned int id);
+
+
+ struct ident *ident_lookup(String name);
+# 9 "include/lacc/symbol.h" 2
+
+
+
+
+struct block;
+
+enum symtype {
+    SYM_DEFINITION = 0,
+    SYM_TENTATIVE,
+    SYM_DECLARATION,
+    SYM_TYPEDEF,
+    SYM_LITERAL,
+    SYM_CONSTANT,
+    SYM_LABEL,
+    SYM_TAG
+};
+
+
+enum linkage {
+    LINK_NONE = 0,
+    LINK_INTERN,
+    LINK_EXTERN
+};
+
+
+
+
+
+struct symbol {
+    String name;
+    Type type;
+
+    unsigned int symtype : 8;
+    unsigned int linkage : 8;
+    unsigned int referenced : 1;
+    unsigned int memory : 1;
+    unsigned int inlined : 1;
+    unsigned int : 1;
+    unsigned int slot : 4;
+    unsigned int index : 8;
+
+
+
+
+
+    short n;
+
+
+
+
+
+    short depth;
+
+
+
+
+
+
+
+    int stack_offset;
+
+    union {
+
+
+
+
+
+        union value constant;
+
+
+
+
+
+
+        String string;
+
+
+
+
+
+        struct block *label;
+
+
+
+
+
+
+        const struct symbol *vla_address;
+    } value;
+};
+
+
+  const struct symbol *decl_memcpy;
+
+
+ const char *sym_name(const struct symbol *sym);
+
+
+
+
+
+ int is_temporary(const struct symbol *sym);
+
+
+
+
+
+ struct symbol *sym_create_constant(Type type, union value val);
+# 5 "src/backend/x86_64/abi.h" 2
+# 16 "src/backend/x86_64/abi.h"
+struct param_class {
+    unsigned char eightbyte[4];
+};
+# 40 "src/backend/x86_64/abi.h"
+ struct param_class classify(Type type);
+
+
+ int sym_alignment(const struct symbol *sym);
+# 5 "src/backend/x86_64/encoding.h" 2
+
+
+
+
+
+
+
+enum reg {
+    AX  = 1,
+    CX  = 2,
+    DX  = 3,
+    BX  = 4,
+    SP  = 5,
+    BP  = 6,
+    SI  = 7,
+    DI  = 8,
+    R8  = 9,
+    R9  = 10,
+    R10 = 11,
+    R11 = 12,
+    R12 = 13,
+    R13 = 14,
+    R14 = 15,
+    R15 = 16,
+
+
+
+
+
+    XMM0, XMM1,  XMM2,  XMM3,  XMM4,  XMM5,  XMM6,  XMM7,
+    XMM8, XMM9, XMM10, XMM11, XMM12, XMM13, XMM14, XMM15,
+
+
+    IP,
+
+
+    ST0,
+    ST1,
+    ST2,
+    ST3,
+    ST4,
+    ST5,
+    ST6,
+    ST7
+};
+
+
+
+ int x87_stack_pos(enum reg r);
+
+
+struct registr {
+    int width;
+    enum reg r;
+};
+# 77 "src/backend/x86_64/encoding.h"
+struct address {
+    enum {
+        ADDR_NORMAL,
+        ADDR_GLOBAL_OFFSET,
+        ADDR_PLT
+    } type;
+
+    const struct symbol *sym;
+    int displacement;
+
+    enum reg base;
+    enum reg index;
+    unsigned scale;
+};
+
+
+struct memory {
+    int width;
+    struct address addr;
+};
+
+
+
+
+
+
+struct immediate {
+    int width;
+    enum {
+        IMM_INT,
+        IMM_ADDR,
+        IMM_STRING
+    } type;
+    union {
+        char byte;
+        short word;
+        int dword;
+        long qword;
+        struct address addr;
+        String string;
+    } d;
+};
+
+
+
+
+enum opcode {
+    INSTR_ADD = 0,
+    INSTR_AND = INSTR_ADD + 2,
+    INSTR_CALL = INSTR_AND + 3,
+    INSTR_CMP = INSTR_CALL + 2,
+    INSTR_Cxy = INSTR_CMP + 3,
+    INSTR_DIV = INSTR_Cxy + 2,
+    INSTR_IDIV = INSTR_DIV + 1,
+    INSTR_Jcc = INSTR_IDIV + 1,
+    INSTR_JMP = INSTR_Jcc + 1,
+    INSTR_LEA = INSTR_JMP + 1,
+    INSTR_LEAVE = INSTR_LEA + 1,
+    INSTR_MOV = INSTR_LEAVE + 1,
+    INSTR_MOV_STR = INSTR_MOV + 5,
+    INSTR_MOVSX = INSTR_MOV_STR + 1,
+    INSTR_MOVZX = INSTR_MOVSX + 2,
+    INSTR_MUL = INSTR_MOVZX + 2,
+    INSTR_NOT = INSTR_MUL + 1,
+    INSTR_OR = INSTR_NOT + 1,
+    INSTR_POP = INSTR_OR + 2,
+    INSTR_PUSH = INSTR_POP + 1,
+    INSTR_RET = INSTR_PUSH + 3,
+    INSTR_SAR = INSTR_RET + 1,
+    INSTR_SETcc = INSTR_SAR + 2,
+    INSTR_SHL = INSTR_SETcc + 1,
+    INSTR_SHR = INSTR_SHL + 2,
+    INSTR_SUB = INSTR_SHR + 2,
+    INSTR_TEST = INSTR_SUB + 2,
+    INSTR_XOR = INSTR_TEST + 2,
+
+    INSTR_ADDS = INSTR_XOR + 2,
+    INSTR_CVTSI2S = INSTR_ADDS + 6,
+    INSTR_CVTS2S = INSTR_CVTSI2S + 2,
+    INSTR_CVTTS2SI = INSTR_CVTS2S + 2,
+    INSTR_DIVS = INSTR_CVTTS2SI + 2,
+    INSTR_MULS = INSTR_DIVS + 2,
+    INSTR_SUBS = INSTR_MULS + 3,
+    INSTR_MOVAP = INSTR_SUBS + 2,
+    INSTR_MOVS = INSTR_MOVAP + 2,
+    INSTR_UCOMIS = INSTR_MOVS + 6,
+    INSTR_PXOR = INSTR_UCOMIS + 2,
+
+    INSTR_FADDP = INSTR_PXOR + 1,
+    INSTR_FDIVRP = INSTR_FADDP + 1,
+    INSTR_FILD = INSTR_FDIVRP + 1,
+    INSTR_FISTP = INSTR_FILD + 3,
+    INSTR_FLD = INSTR_FISTP + 3,
+    INSTR_FLDCW = INSTR_FLD + 4,
+    INSTR_FMULP = INSTR_FLDCW + 1,
+    INSTR_FNSTCW = INSTR_FMULP + 1,
+    INSTR_FSTP = INSTR_FNSTCW + 1,
+    INSTR_FSUBRP = INSTR_FSTP + 4,
+    INSTR_FUCOMIP = INSTR_FSUBRP + 1,
+    INSTR_FXCH = INSTR_FUCOMIP + 1
+};
+
+enum prefix {
+    PREFIX_NONE = 0x0,
+    PREFIX_REP = 0xF3,
+    PREFIX_REPE = 0xF3,
+    PREFIX_REPNE = 0xF2
+};
+
+
+
+
+
+enum tttn {
+    CC_O = 0x0,
+    CC_NO = 0x1,
+    CC_NAE = 0x2,
+    CC_AE = 0x3,
+    CC_E = 0x4,
+    CC_NE = 0x5,
+    CC_NA = 0x6,
+    CC_A = 0x7,
+    CC_S = 0x8,
+    CC_NS = 0x9,
+    CC_P = 0xA,
+    CC_NP = 0xB,
+    CC_NGE = 0xC,
+    CC_GE = 0xD,
+    CC_NG = 0xE,
+    CC_G = 0xF
+};
+
+
+struct instruction {
+    enum opcode opcode;
+    enum tttn cc;
+    enum prefix prefix;
+    enum instr_optype {
+        OPT_NONE = 0,
+        OPT_IMM = 1,
+        OPT_REG = 2,
+        OPT_MEM = 4,
+        OPT_REG_REG = 8,
+        OPT_REG_MEM = 16,
+        OPT_MEM_REG = 32,
+        OPT_IMM_REG = 64,
+        OPT_IMM_MEM = 128
+    } optype;
+    union operand {
+        int width;
+        struct registr reg;
+        struct memory mem;
+        struct immediate imm;
+    } source, dest;
+};
+# 243 "src/backend/x86_64/encoding.h"
+struct code {
+    unsigned char val[15];
+    signed char len;
+};
+
+
+ struct code encode(struct instruction instr);
+
+
+ void get_mnemonic(struct instruction instr, char *buf);
+
+
+
+
+
+ int mnemonic_match_operands(
+    const char *mnemonic,
+    size_t length,
+    struct instruction *instr);
+# 5 "src/backend/compile.h" 2
+# 1 "include/lacc/ir.h" 1
+
+
+
+
+
+
+# 1 "include/lacc/arena.h" 1
+# 17 "include/lacc/arena.h"
+struct arena {
+    struct {                                                                           unsigned capacity;                                                             unsigned length; char * *data;                                                                   } chunks;
+    struct {                                                                           unsigned capacity;                                                             unsigned length; void * *data;                                                                   } large;
+    unsigned chunk;
+    char *ptr, *end;
+};
+
+
+struct arena_mark {
+    unsigned chunk;
+    unsigned large;
+    char *ptr, *end;
+};
+
+
+
+
+
+ void *arena_alloc(struct arena *arena, size_t size);
+
+
+ struct arena_mark arena_mark(const struct arena *arena);
+
+
+ void arena_rewind(struct arena *arena, struct arena_mark mark);
+
+
+ void arena_reset(struct arena *arena);
+
+
+ void arena_destroy(struct arena *arena);
+# 8 "include/lacc/ir.h" 2
+# 20 "include/lacc/ir.h"
+struct var {
+    enum {
+
+
+
+
+
+
+
+
+        DIRECT,
+
+
+
+
+
+
+
+        ADDRESS,
+
+
+
+
+
+
+
+
+        DEREF,
+
+
+
+
+        IMMEDIATE
+    } kind;
+
+    Type type;
+
+    const struct symbol *symbol;
+
+
+
+
+
+
+    size_t offset;
+
+
+
+
+
+    short field_width;
+    short field_offset;
+
+    int lvalue;
+
+    union value imm;
+};
+# 89 "include/lacc/ir.h"
+struct expression {
+    enum optype {
+        IR_OP_CAST,
+        IR_OP_CALL,
+        IR_OP_VA_ARG,
+        IR_OP_NOT,
+        IR_OP_NEG,
+        IR_OP_ADD,
+        IR_OP_SUB,
+        IR_OP_MUL,
+        IR_OP_DIV,
+        IR_OP_MOD,
+        IR_OP_AND,
+        IR_OP_OR,
+        IR_OP_XOR,
+        IR_OP_SHL,
+        IR_OP_SHR,
+        IR_OP_EQ,
+        IR_OP_NE,
+        IR_OP_GE,
+        IR_OP_GT
+    } op;
+    Type type;
+    struct var l, r;
+};
+# 131 "include/lacc/ir.h"
+struct statement {
+    enum sttype {
+        IR_EXPR,
+        IR_PARAM,
+        IR_VA_START,
+        IR_ASSIGN,
+        IR_VLA_ALLOC,
+        IR_ASM
+    } st;
+    int asm_index;
+    unsigned long out;
+    struct var t;
+    struct expression expr;
+};
+
+
+
+
+
+
+struct block {
+    const struct symbol *label;
+
+
+
+
+
+
+    struct {                                                                           unsigned capacity;                                                             unsigned length; struct statement *data;                                                                   } code;
+    struct arena *arena;
+
+
+
+
+
+
+
+    struct expression expr;
+
+
+
+
+
+
+
+    struct block *jump[2];
+
+
+
+
+
+
+
+    char has_return_value;
+
+
+
+
+
+    char has_init_value;
+
+
+    enum color {
+        WHITE,
+        BLACK
+    } color;
+
+
+    unsigned long in;
+    unsigned long out;
+};
+
+
+
+
+
+
+
+
+struct asm_operand {
+    struct var variable;
+    String alias;
+    String constraint;
+};
+# 225 "include/lacc/ir.h"
+struct asm_statement {
+    String template;
+    struct {                                                                           unsigned capacity;                                                             unsigned length; struct asm_operand *data;                                                                   } operands;
+    struct {                                                                           unsigned capacity;                                                             unsigned length; String *data;                                                                   } clobbers;
+    struct {                                                                           unsigned capacity;                                                             unsigned length; struct block * *data;                                                                   } targets;
+};
+# 254 "include/lacc/ir.h"
+struct definition {
+
+
+
+
+    const struct symbol *symbol;
+
+
+
+
+
+
+    struct block *body;
+
+
+
+
+
+
+    struct {                                                                           unsigned capacity;                                                             unsigned length; struct symbol * *data;                                                                   }
+        params,
+        locals,
+        labels;
+
+
+
+
+
+    struct arena arena;
+
+
+    struct {                                                                           unsigned capacity;                                                             unsigned length; struct asm_statement *data;                                                                   } asm_statements;
+};
+
+
+ struct expression as_expr(struct var var);
+
+
+
+
+
+ struct var var_direct(const struct symbol *sym);
+
+
+ struct var var_int(int value);
+
+
+ struct var var_numeric(Type type, union value val);
+
+
+
+
+
+ struct symbol *create_label(struct definition *def);
+# 6 "src/backend/compile.h" 2
+
+
+
+
+
+
+
+ void set_compile_target(FILE *stream, const char *file);
+
+
+ int compile(struct definition *def);
+
+
+
+
+
+
+ int declare(const struct symbol *sym);
+
+
+ void flush(void);
+
+
+ void finalize(void);
+
+ enum instr_optype allocation(struct var var, union operand *op);
+# 43 "src/lacc.c" 2
+# 1 "src/backend/linker.h" 1
+
+
+
+
+
+
+ int add_linker_arg(const char *opt);
+
+
+ int invoke_linker(void);
+
+
+ void clear_linker_args(void);
+# 44 "src/lacc.c" 2
+# 1 "src/optimizer/optimize.h" 1
+
+
+
+# 1 "src/optimizer/liveness.h" 1
+# 10 "src/optimizer/liveness.h"
+ int live_variable_analysis(struct block *block);
+
+
+
+
+
+ int is_live_after(
+ const struct symbol *sym,
+ const struct statement *st);
+# 5 "src/optimizer/optimize.h" 2
+
+
+
+
+ void push_optimization(int level);
+
+
+
+
+
+
+ void optimize(struct definition *def);
+
+
+ void pop_optimization(void);
+# 45 "src/lacc.c" 2
+# 1 "src/parser/parse.h" 1
+# 10 "src/parser/parse.h"
+ struct definition *parse(void);
+# 22 "src/parser/parse.h"
+ struct definition *cfg_init(void);
+
+
+ void cfg_define(struct definition *def, const struct symbol *sym);
+
+
+ void cfg_discard(struct definition *def);
+
+
+ struct block *cfg_block_init(struct definition *def);
+
+
+
+
+
+
+ void cfg_push_statement(struct block *block, struct statement st);
+
+
+ void cfg_append_statements(
+    struct block *block,
+    const struct block *from);
+
+
+ void parse_finalize(void);
+# 46 "src/lacc.c" 2
+# 1 "src/parser/symtab.h" 1
+
+
+
+
+# 1 "include/lacc/hash.h" 1
+
+
+
+
+
+
+
+
+struct hash_table {
+
+    unsigned capacity;
+
+
+    unsigned count;
+
+
+
+
+
+
+    String (*key)(void *);
+
+
+
+
+
+
+    void *(*add)(void *);
+
+
+
+
+
+    void (*del)(void *);
+# 47 "include/lacc/hash.h"
+    struct hash_entry *table;
+};
+
+
+
+
+
+ struct hash_table *hash_init(
+    struct hash_table *tab,
+    unsigned cap,
+    String (*key)(void *),
+    void *(*add)(void *),
+    void (*del)(void *));
+
+
+ void hash_clear(struct hash_table *tab);
+
+
+ void hash_destroy(struct hash_table *tab);
+
+
+ void *hash_insert(struct hash_table *tab, void *val);
+
+
+ void *hash_lookup(struct hash_table *tab, String key);
+
+
+ void hash_remove(struct hash_table *tab, String key);
+# 6 "src/parser/symtab.h" 2
+
+
+
+
+
+
+
+struct binding {
+    struct symbol **slot;
+    struct symbol *shadowed;
+};
+
+
+
+
+
+struct namespace {
+
+
+
+
+    const char *name;
+
+
+
+
+
+    struct {                                                                           unsigned capacity;                                                             unsigned length; struct symbol * *data;                                                                   } symbol;
+
+
+
+
+
+
+    struct {                                                                           unsigned capacity;                                                             unsigned length; struct binding *data;                                                                   } bindings;
+
+
+    struct {                                                                           unsigned capacity;                                                             unsigned length; unsigned *data;                                                                   } scope;
+
+
+    int cursor;
+};
+
+extern struct namespace
+    ns_ident,
+    ns_label,
+    ns_tag;
+
+
+ void push_scope(struct namespace *ns);
+
+
+ void pop_scope(struct namespace *ns);
+
+
+
+
+
+
+ unsigned current_scope_depth(struct namespace *ns);
+
+
+
+
+
+ struct symbol *sym_lookup(struct namespace *ns, String name);
+
+
+
+
+
+ struct symbol *sym_lookup_ident(struct token t);
+
+
+
+
+
+ struct symbol *sym_add(
+    struct namespace *ns,
+    String name,
+    Type type,
+    enum symtype symtype,
+    enum linkage linkage);
+
+
+ void sym_make_visible(struct namespace *ns, struct symbol *sym);
+
+
+
+
+
+
+ struct symbol *sym_create_temporary(Type type);
+
+
+ struct symbol *sym_create_unnamed(Type type);
+
+
+ struct symbol *sym_create_label(void);
+
+
+ struct symbol *sym_create_string(String str);
+
+
+
+
+
+ void sym_discard(struct symbol *sym);
+
+
+
+
+ const struct symbol *yield_declaration(struct namespace *ns);
+
+
+
+
+
+
+
+ int can_write_declarations(void);
+
+
+ void write_declarations(FILE *stream);
+
+
+
+
+
+ void read_declarations(FILE *stream);
+
+
+ void output_symbols(FILE *stream, struct namespace *ns);
+
+
+ void output_symbol_stats(FILE *stream);
+
+
+ void symtab_finalize(void);
+# 47 "src/lacc.c" 2
+# 1 "src/parser/typetree.h" 1
+# 20 "src/parser/typetree.h"
+ void clear_types(FILE *stream);
+
+
+
+
+
+
+
+ int write_types(
+    FILE *stream,
+    long (*sym_index)(const struct symbol *));
+
+
+
+
+
+ void read_types(FILE *stream, struct symbol *(*sym_get)(long));
+
+
+ Type type_create(enum type);
+ Type type_create_pointer(Type next);
+ Type type_create_function(Type next);
+ Type type_create_array(Type next, size_t count);
+ Type type_create_incomplete(Type next);
+ Type type_create_vla(Type next, const struct symbol *count);
+
+
+ Type type_set_const(Type type);
+ Type type_set_volatile(Type type);
+ Type type_set_restrict(Type type);
+
+
+ Type type_apply_qualifiers(Type type, Type other);
+
+
+ int is_type_placeholder(Type type);
+ Type get_type_placeholder(void);
+
+
+
+
+
+
+
+
+ struct member *type_add_member(Type parent, String name, Type type);
+
+
+
+
+
+
+
+ void type_add_anonymous_member(Type parent, Type type);
+
+
+
+
+
+
+ void type_add_field(Type parent, String name, Type type, size_t width);
+
+
+
+
+
+ void type_seal(Type parent);
+
+
+
+
+
+ void set_array_length(Type type, size_t length);
+
+
+ size_t type_array_len(Type type);
+# 112 "src/parser/typetree.h"
+ Type type_patch_declarator(Type head, Type target);
+# 122 "src/parser/typetree.h"
+ void type_clean_prototype(Type type);
+
+
+
+
+
+ void type_set_tag(Type type, const struct symbol *tag);
+
+
+
+
+
+
+
+
+ const struct member *find_type_member(
+ Type type,
+ String name,
+ int *index);
+
+
+ const struct symbol *type_vla_length(Type type);
+
+
+ int is_compatible(Type l, Type r);
+
+
+
+
+
+
+ int is_compatible_unqualified(Type l, Type r);
+
+
+ int is_variably_modified(Type type);
+
+
+ int is_complete(Type type);
+
+
+ Type type_deref(Type type);
+
+
+
+
+
+
+ Type promote_integer(Type type);
+# 48 "src/lacc.c" 2
+# 1 "src/preprocessor/preprocess.h" 1
+# 13 "src/preprocessor/preprocess.h"
+ void preprocess(FILE *output);
+
+
+
+
+
+
+
+
+ void inject_line(char *line);
+
+
+
+
+
+ void begin_pch(void);
+
+
+
+
+
+
+
+
+ void write_pch(
+    FILE *output,
+    const char *path,
+    const char *config,
+    int is_parsed);
+
+
+
+
+
+
+
+ void include_pch(const char *path, const char *config);
+
+
+
+
+
+ FILE *open_pch_declarations(void);
+
+
+
+
+
+ void preprocess_start_thread(void);
+# 71 "src/preprocessor/preprocess.h"
+ int diagnostic_begin(String *path, int *line);
+
+
+ void diagnostic_end(int is_held);
+
+
+ void preprocess_reset(void);
+
+
+ void preprocess_finalize(void);
+# 49 "src/lacc.c" 2
+# 1 "src/preprocessor/input.h" 1
+# 13 "src/preprocessor/input.h"
+ void set_input_file(const char *);
+
+
+ void input_finalize(void);
+
+
+
+
+
+ int add_include_search_path(const char *);
+
+
+
+
+
+ int add_system_include_search_path(const char *);
+
+
+
+
+
+ const char *get_include_search_path(int n, int *is_system);
+
+
+
+
+
+ void include_file(const char *);
+ void include_system_file(const char *);
+
+
+ void set_pragma_once(void);
+
+
+ int add_include_file(const char *path);
+
+
+ void clear_include_files(void);
+
+
+
+
+
+ int is_reading_include_files(void);
+
+
+
+
+
+
+ void save_header_state(void);
+ void restore_header_state(void);
+
+
+
+
+
+ void add_saved_header(const char *path);
+
+
+ void write_header_state(FILE *stream);
+ void read_header_state(FILE *stream);
+
+
+
+
+
+ void write_header_dependencies(FILE *stream);
+ int read_header_dependencies(FILE *stream);
+
+
+
+
+
+
+
+ void write_dependencies(
+    FILE *stream,
+    const char *target,
+    int exclude_system,
+    int phony_targets);
+
+
+
+
+
+
+ char *getprepline(void);
+
+
+
+
+
+
+
+ const char *getrawline(void);
+
+
+
+
+
+ char *getprepline_rest(const char *line);
+
+
+
+
+
+
+
+ const struct token *getlinetokens(void);
+
+
+
+
+
+
+ int is_line_recorded(void);
+ void set_line_tokens(const struct token *tokens, unsigned n);
+
+
+
+
+
+
+
+ int include_depth(void);
+ unsigned include_stack_entry(
+    int depth,
+    String *path,
+    int *line,
+    int *is_system);
+
+
+extern String current_file_path;
+extern int current_file_line;
+# 50 "src/lacc.c" 2
+# 1 "src/preprocessor/macro.h" 1
+
+
+
+
+# 1 "include/lacc/context.h" 1
+
+
+
+
+
+
+
+
+enum target {
+    TARGET_PREPROCESS,
+    TARGET_IR_DOT,
+    TARGET_x86_64_ASM,
+    TARGET_x86_64_OBJ,
+    TARGET_x86_64_EXE
+};
+
+enum cstd {
+    STD_C89,
+    STD_C99,
+    STD_C11
+};
+
+
+ struct context {
+    int errors;
+    int verbose;
+    int suppress_warning;
+    unsigned int pic : 1;
+    unsigned int debug : 1;
+    unsigned int no_common : 1;
+    unsigned int no_sse : 1;
+    unsigned int fused_lexer : 1;
+    unsigned int snapshot_include : 1;
+    unsigned int trace_includes : 1;
+    unsigned int profile_macros : 1;
+    unsigned int preprocess_thread : 1;
+    unsigned int no_linemarkers : 1;
+    enum target target;
+    enum cstd standard;
+} context;
+
+
+
+
+
+ void verbose(const char *, ...);
+
+
+
+
+ void warning(const char *, ...);
+
+
+ void error(const char *, ...);
+# 6 "src/preprocessor/macro.h" 2
+
+
+
+
+typedef struct {                                                                           unsigned capacity;                                                             unsigned length; struct token *data;                                                                   } TokenArray;
+
+
+ TokenArray get_token_array(void);
+
+
+ void release_token_array(TokenArray list);
+
+struct macro {
+    String name;
+
+    enum {
+        OBJECT_LIKE,
+        FUNCTION_LIKE
+    } type;
+
+
+    int params;
+
+    unsigned int is__line__ : 1;
+    unsigned int is__file__ : 1;
+    unsigned int is_vararg : 1;
+
+
+    unsigned long expand_scope;
+
+
+
+
+
+
+    TokenArray replacement;
+};
+
+
+
+
+
+ void macro_reset(void);
+
+
+ void macro_finalize(void);
+
+
+
+
+
+ void register_builtin_definitions(enum cstd version);
+
+
+ struct token stringify(const TokenArray *list);
+
+
+
+
+
+ void define(struct macro macro);
+
+
+
+
+
+ void undef(String name);
+
+
+
+
+
+
+ void macro_snapshot_begin(void);
+ void macro_snapshot_end(void);
+ void macro_snapshot_restore(void);
+
+
+
+
+
+ void macro_snapshot_write(FILE *stream);
+ void macro_snapshot_read(FILE *stream);
+
+
+ const struct macro *macro_definition(String name);
+
+
+
+
+
+ const struct macro *macro_definition_of(struct token t);
+
+
+
+
+
+ int expand(TokenArray *list);
+
+
+
+
+ int tok_cmp(struct token a, struct token b);
+# 51 "src/lacc.c" 2
+# 1 "src/preprocessor/tokencache.h" 1
+# 16 "src/preprocessor/tokencache.h"
+struct cached_line {
+    int line;
+    int tokens;
+    int text;
+};
+
+
+
+
+
+struct token_cache {
+    struct {                                                                           unsigned capacity;                                                             unsigned length; struct cached_line *data;                                                                   } lines;
+    struct {                                                                           unsigned capacity;                                                             unsigned length; struct token *data;                                                                   } tokens;
+    struct {                                                                           unsigned capacity;                                                             unsigned length; char *data;                                                                   } text;
+};
+
+
+
+
+
+ int set_token_cache_directory(const char *path);
+
+
+ int has_token_cache(void);
+
+
+
+
+
+ struct token_cache *token_cache_load(
+    const char *path,
+    const char *data,
+    size_t size);
+
+
+ struct token_cache *token_cache_create(void);
+
+
+
+
+
+ void token_cache_add_line(
+    struct token_cache *cache,
+    const char *text,
+    int line);
+
+
+ void token_cache_set_tokens(
+    struct token_cache *cache,
+    const struct token *tokens,
+    unsigned n);
+
+
+
+
+
+
+ void token_cache_store(
+    struct token_cache *cache,
+    const char *path,
+    const char *data,
+    size_t size);
+
+
+ void token_cache_free(struct token_cache *cache);
+# 52 "src/lacc.c" 2
+# 1 "src/preprocessor/trace.h" 1
+# 18 "src/preprocessor/trace.h"
+ int set_include_trace_file(const char *path);
+
+
+ void trace_include_push(String path);
+ void trace_include_pop(size_t bytes, int lines);
+
+
+ void trace_include_skip(String path);
+
+
+ void trace_include_token(void);
+# 40 "src/preprocessor/trace.h"
+ int set_macro_profile_file(const char *path);
+
+
+
+
+
+ void trace_macro_begin(void);
+ void trace_macro_end(
+    String name,
+    unsigned depth,
+    unsigned produced,
+    unsigned copied);
+
+
+
+
+
+ void trace_report(void);
+
+
+ void trace_finalize(void);
+# 53 "src/lacc.c" 2
+# 1 "src/util/argparse.h" 1
+# 22 "src/util/argparse.h"
+struct option {
+    const char *rule;
+    int (*callback)(const char *);
+};
+# 37 "src/util/argparse.h"
+ int parse_args(struct option *optv, int argc, char *argv[]);
+# 58 "src/lacc.c" 2
+# 1 "/usr/include/assert.h" 1 3 4
+# 69 "/usr/include/assert.h" 3 4
+extern void __assert_fail (const char *__assertion, const char *__file,
+      unsigned int __line, const char *__function)
+;
+
+
+extern void __assert_perror_fail (int __errnum, const char *__file,
+      unsigned int __line, const char *__function)
+;
+
+
+
+
+extern void __assert (const char *__assertion, const char *__file, int __line)
+;
+# 59 "src/lacc.c" 2
+# 1 "/usr/include/ctype.h" 1 3 4
+# 46 "/usr/include/ctype.h" 3 4
+enum
+{
+  _ISupper = (( 0) < 8 ? ((1 << ( 0)) << 8) : ((1 << ( 0)) >> 8)),
+  _ISlower = (( 1) < 8 ? ((1 << ( 1)) << 8) : ((1 << ( 1)) >> 8)),
+  _ISalpha = (( 2) < 8 ? ((1 << ( 2)) << 8) : ((1 << ( 2)) >> 8)),
+  _ISdigit = (( 3) < 8 ? ((1 << ( 3)) << 8) : ((1 << ( 3)) >> 8)),
+  _ISxdigit = (( 4) < 8 ? ((1 << ( 4)) << 8) : ((1 << ( 4)) >> 8)),
+  _ISspace = (( 5) < 8 ? ((1 << ( 5)) << 8) : ((1 << ( 5)) >> 8)),
+  _ISprint = (( 6) < 8 ? ((1 << ( 6)) << 8) : ((1 << ( 6)) >> 8)),
+  _ISgraph = (( 7) < 8 ? ((1 << ( 7)) << 8) : ((1 << ( 7)) >> 8)),
+  _ISblank = (( 8) < 8 ? ((1 << ( 8)) << 8) : ((1 << ( 8)) >> 8)),
+  _IScntrl = (( 9) < 8 ? ((1 << ( 9)) << 8) : ((1 << ( 9)) >> 8)),
+  _ISpunct = (( 10) < 8 ? ((1 << ( 10)) << 8) : ((1 << ( 10)) >> 8)),
+  _ISalnum = (( 11) < 8 ? ((1 << ( 11)) << 8) : ((1 << ( 11)) >> 8))
+};
+# 79 "/usr/include/ctype.h" 3 4
+extern const unsigned short int **__ctype_b_loc (void)
+;
+extern const __int32_t **__ctype_tolower_loc (void)
+;
+extern const __int32_t **__ctype_toupper_loc (void)
+;
+# 108 "/usr/include/ctype.h" 3 4
+extern int isalnum (int);
+extern int isalpha (int);
+extern int iscntrl (int);
+extern int isdigit (int);
+extern int islower (int);
+extern int isgraph (int);
+extern int isprint (int);
+extern int ispunct (int);
+extern int isspace (int);
+extern int isupper (int);
+extern int isxdigit (int);
+
+
+
+extern int tolower (int __c);
+
+
+extern int toupper (int __c);
+
+
+
+
+extern int isblank (int);
+# 142 "/usr/include/ctype.h" 3 4
+extern int isascii (int __c);
+
+
+
+extern int toascii (int __c);
+
+
+
+extern int _toupper (int);
+extern int _tolower (int);
+# 251 "/usr/include/ctype.h" 3 4
+extern int isalnum_l (int, locale_t);
+extern int isalpha_l (int, locale_t);
+extern int iscntrl_l (int, locale_t);
+extern int isdigit_l (int, locale_t);
+extern int islower_l (int, locale_t);
+extern int isgraph_l (int, locale_t);
+extern int isprint_l (int, locale_t);
+extern int ispunct_l (int, locale_t);
+extern int isspace_l (int, locale_t);
+extern int isupper_l (int, locale_t);
+extern int isxdigit_l (int, locale_t);
+
+extern int isblank_l (int, locale_t);
+
+
+
+extern int __tolower_l (int __c, locale_t __l);
+extern int tolower_l (int __c, locale_t __l);
+
+
+extern int __toupper_l (int __c, locale_t __l);
+extern int toupper_l (int __c, locale_t __l);
+# 61 "src/lacc.c" 2
+# 1 "/usr/include/unistd.h" 1 3 4
+# 255 "/usr/include/unistd.h" 3 4
+typedef __useconds_t useconds_t;
+# 267 "/usr/include/unistd.h" 3 4
+typedef __intptr_t intptr_t;
+
+
+
+
+
+
+typedef __socklen_t socklen_t;
+# 287 "/usr/include/unistd.h" 3 4
+extern int access (const char *__name, int __type);
+# 309 "/usr/include/unistd.h" 3 4
+extern int faccessat (int __fd, const char *__file, int __type, int __flag)
+;
+# 339 "/usr/include/unistd.h" 3 4
+extern __off_t lseek (int __fd, __off_t __offset, int __whence);
+# 358 "/usr/include/unistd.h" 3 4
+extern int close (int __fd);
+
+
+
+
+extern void closefrom (int __lowfd);
+
+
+
+
+
+
+
+extern ssize_t read (int __fd, void *__buf, size_t __nbytes)
+;
+
+
+
+
+
+extern ssize_t write (int __fd, const void *__buf, size_t __n)
+;
+# 389 "/usr/include/unistd.h" 3 4
+extern ssize_t pread (int __fd, void *__buf, size_t __nbytes,
+        __off_t __offset)
+;
+
+
+
+
+
+
+extern ssize_t pwrite (int __fd, const void *__buf, size_t __n,
+         __off_t __offset)
+;
+# 437 "/usr/include/unistd.h" 3 4
+extern int pipe (int __pipedes[2]);
+# 452 "/usr/include/unistd.h" 3 4
+extern unsigned int alarm (unsigned int __seconds);
+# 464 "/usr/include/unistd.h" 3 4
+extern unsigned int sleep (unsigned int __seconds);
+
+
+
+
+
+
+
+extern __useconds_t ualarm (__useconds_t __value, __useconds_t __interval)
+;
+
+
+
+
+
+
+extern int usleep (__useconds_t __useconds);
+
+
+
+
+
+
+
+
+extern int pause (void);
+
+
+
+extern int chown (const char *__file, __uid_t __owner, __gid_t __group)
+;
+
+
+
+extern int fchown (int __fd, __uid_t __owner, __gid_t __group);
+
+
+
+
+extern int lchown (const char *__file, __uid_t __owner, __gid_t __group)
+;
+
+
+
+
+
+
+extern int fchownat (int __fd, const char *__file, __uid_t __owner,
+       __gid_t __group, int __flag)
+;
+
+
+
+extern int chdir (const char *__path);
+
+
+
+extern int fchdir (int __fd);
+# 531 "/usr/include/unistd.h" 3 4
+extern char *getcwd (char *__buf, size_t __size);
+# 545 "/usr/include/unistd.h" 3 4
+extern char *getwd (char *__buf)
+
+;
+
+
+
+
+extern int dup (int __fd);
+
+
+extern int dup2 (int __fd, int __fd2);
+
+
+
+
+
+
+
+
+extern char **__environ;
+
+
+
+
+
+
+
+extern int execve (const char *__path, char *const __argv[],
+     char *const __envp[]);
+
+
+
+
+extern int fexecve (int __fd, char *const __argv[], char *const __envp[])
+;
+
+
+
+
+extern int execv (const char *__path, char *const __argv[])
+;
+
+
+
+extern int execle (const char *__path, const char *__arg, ...)
+;
+
+
+
+extern int execl (const char *__path, const char *__arg, ...)
+;
+
+
+
+extern int execvp (const char *__file, char *const __argv[])
+;
+
+
+
+
+extern int execlp (const char *__file, const char *__arg, ...)
+;
+# 619 "/usr/include/unistd.h" 3 4
+extern int nice (int __inc);
+
+
+
+
+extern void _exit (int __status);
+# 1 "/usr/include/x86_64-linux-gnu/bits/confname.h" 1 3 4
+# 24 "/usr/include/x86_64-linux-gnu/bits/confname.h" 3 4
+enum
+  {
+    _PC_LINK_MAX,
+
+    _PC_MAX_CANON,
+
+    _PC_MAX_INPUT,
+
+    _PC_NAME_MAX,
+
+    _PC_PATH_MAX,
+
+    _PC_PIPE_BUF,
+
+    _PC_CHOWN_RESTRICTED,
+
+    _PC_NO_TRUNC,
+
+    _PC_VDISABLE,
+
+    _PC_SYNC_IO,
+
+    _PC_ASYNC_IO,
+
+    _PC_PRIO_IO,
+
+    _PC_SOCK_MAXBUF,
+
+    _PC_FILESIZEBITS,
+
+    _PC_REC_INCR_XFER_SIZE,
+
+    _PC_REC_MAX_XFER_SIZE,
+
+    _PC_REC_MIN_XFER_SIZE,
+
+    _PC_REC_XFER_ALIGN,
+
+    _PC_ALLOC_SIZE_MIN,
+
+    _PC_SYMLINK_MAX,
+
+    _PC_2_SYMLINKS
+
+  };
+
+
+enum
+  {
+    _SC_ARG_MAX,
+
+    _SC_CHILD_MAX,
+
+    _SC_CLK_TCK,
+
+    _SC_NGROUPS_MAX,
+
+    _SC_OPEN_MAX,
+
+    _SC_STREAM_MAX,
+
+    _SC_TZNAME_MAX,
+
+    _SC_JOB_CONTROL,
+
+    _SC_SAVED_IDS,
+
+    _SC_REALTIME_SIGNALS,
+
+    _SC_PRIORITY_SCHEDULING,
+
+    _SC_TIMERS,
+
+    _SC_ASYNCHRONOUS_IO,
+
+    _SC_PRIORITIZED_IO,
+
+    _SC_SYNCHRONIZED_IO,
+
+    _SC_FSYNC,
+
+    _SC_MAPPED_FILES,
+
+    _SC_MEMLOCK,
+
+    _SC_MEMLOCK_RANGE,
+
+    _SC_MEMORY_PROTECTION,
+
+    _SC_MESSAGE_PASSING,
+
+    _SC_SEMAPHORES,
+
+    _SC_SHARED_MEMORY_OBJECTS,
+
+    _SC_AIO_LISTIO_MAX,
+
+    _SC_AIO_MAX,
+
+    _SC_AIO_PRIO_DELTA_MAX,
+
+    _SC_DELAYTIMER_MAX,
+
+    _SC_MQ_OPEN_MAX,
+
+    _SC_MQ_PRIO_MAX,
+
+    _SC_VERSION,
+
+    _SC_PAGESIZE,
+
+
+    _SC_RTSIG_MAX,
+
+    _SC_SEM_NSEMS_MAX,
+
+    _SC_SEM_VALUE_MAX,
+
+    _SC_SIGQUEUE_MAX,
+
+    _SC_TIMER_MAX,
+
+
+
+
+    _SC_BC_BASE_MAX,
+
+    _SC_BC_DIM_MAX,
+
+    _SC_BC_SCALE_MAX,
+
+    _SC_BC_STRING_MAX,
+
+    _SC_COLL_WEIGHTS_MAX,
+
+    _SC_EQUIV_CLASS_MAX,
+
+    _SC_EXPR_NEST_MAX,
+
+    _SC_LINE_MAX,
+
+    _SC_RE_DUP_MAX,
+
+    _SC_CHARCLASS_NAME_MAX,
+
+
+    _SC_2_VERSION,
+
+    _SC_2_C_BIND,
+
+    _SC_2_C_DEV,
+
+    _SC_2_FORT_DEV,
+
+    _SC_2_FORT_RUN,
+
+    _SC_2_SW_DEV,
+
+    _SC_2_LOCALEDEF,
+
+
+    _SC_PII,
+
+    _SC_PII_XTI,
+
+    _SC_PII_SOCKET,
+
+    _SC_PII_INTERNET,
+
+    _SC_PII_OSI,
+
+    _SC_POLL,
+
+    _SC_SELECT,
+
+    _SC_UIO_MAXIOV,
+
+    _SC_IOV_MAX = _SC_UIO_MAXIOV,
+
+    _SC_PII_INTERNET_STREAM,
+
+    _SC_PII_INTERNET_DGRAM,
+
+    _SC_PII_OSI_COTS,
+
+    _SC_PII_OSI_CLTS,
+
+    _SC_PII_OSI_M,
+
+    _SC_T_IOV_MAX,
+
+
+
+    _SC_THREADS,
+
+    _SC_THREAD_SAFE_FUNCTIONS,
+
+    _SC_GETGR_R_SIZE_MAX,
+
+    _SC_GETPW_R_SIZE_MAX,
+
+    _SC_LOGIN_NAME_MAX,
+
+    _SC_TTY_NAME_MAX,
+
+    _SC_THREAD_DESTRUCTOR_ITERATIONS,
+
+    _SC_THREAD_KEYS_MAX,
+
+    _SC_THREAD_STACK_MIN,
+
+    _SC_THREAD_THREADS_MAX,
+
+    _SC_THREAD_ATTR_STACKADDR,
+
+    _SC_THREAD_ATTR_STACKSIZE,
+
+    _SC_THREAD_PRIORITY_SCHEDULING,
+
+    _SC_THREAD_PRIO_INHERIT,
+
+    _SC_THREAD_PRIO_PROTECT,
+
+    _SC_THREAD_PROCESS_SHARED,
+
+
+    _SC_NPROCESSORS_CONF,
+
+    _SC_NPROCESSORS_ONLN,
+
+    _SC_PHYS_PAGES,
+
+    _SC_AVPHYS_PAGES,
+
+    _SC_ATEXIT_MAX,
+
+    _SC_PASS_MAX,
+
+
+    _SC_XOPEN_VERSION,
+
+    _SC_XOPEN_XCU_VERSION,
+
+    _SC_XOPEN_UNIX,
+
+    _SC_XOPEN_CRYPT,
+
+    _SC_XOPEN_ENH_I18N,
+
+    _SC_XOPEN_SHM,
+
+
+    _SC_2_CHAR_TERM,
+
+    _SC_2_C_VERSION,
+
+    _SC_2_UPE,
+
+
+    _SC_XOPEN_XPG2,
+
+    _SC_XOPEN_XPG3,
+
+    _SC_XOPEN_XPG4,
+
+
+    _SC_CHAR_BIT,
+
+    _SC_CHAR_MAX,
+
+    _SC_CHAR_MIN,
+
+    _SC_INT_MAX,
+
+    _SC_INT_MIN,
+
+    _SC_LONG_BIT,
+
+    _SC_WORD_BIT,
+
+    _SC_MB_LEN_MAX,
+
+    _SC_NZERO,
+
+    _SC_SSIZE_MAX,
+
+    _SC_SCHAR_MAX,
+
+    _SC_SCHAR_MIN,
+
+    _SC_SHRT_MAX,
+
+    _SC_SHRT_MIN,
+
+    _SC_UCHAR_MAX,
+
+    _SC_UINT_MAX,
+
+    _SC_ULONG_MAX,
+
+    _SC_USHRT_MAX,
+
+
+    _SC_NL_ARGMAX,
+
+    _SC_NL_LANGMAX,
+
+    _SC_NL_MSGMAX,
+
+    _SC_NL_NMAX,
+
+    _SC_NL_SETMAX,
+
+    _SC_NL_TEXTMAX,
+
+
+    _SC_XBS5_ILP32_OFF32,
+
+    _SC_XBS5_ILP32_OFFBIG,
+
+    _SC_XBS5_LP64_OFF64,
+
+    _SC_XBS5_LPBIG_OFFBIG,
+
+
+    _SC_XOPEN_LEGACY,
+
+    _SC_XOPEN_REALTIME,
+
+    _SC_XOPEN_REALTIME_THREADS,
+
+
+    _SC_ADVISORY_INFO,
+
+    _SC_BARRIERS,
+
+    _SC_BASE,
+
+    _SC_C_LANG_SUPPORT,
+
+    _SC_C_LANG_SUPPORT_R,
+
+    _SC_CLOCK_SELECTION,
+
+    _SC_CPUTIME,
+
+    _SC_THREAD_CPUTIME,
+
+    _SC_DEVICE_IO,
+
+    _SC_DEVICE_SPECIFIC,
+
+    _SC_DEVICE_SPECIFIC_R,
+
+    _SC_FD_MGMT,
+
+    _SC_FIFO,
+
+    _SC_PIPE,
+
+    _SC_FILE_ATTRIBUTES,
+
+    _SC_FILE_LOCKING,
+
+    _SC_FILE_SYSTEM,
+
+    _SC_MONOTONIC_CLOCK,
+
+    _SC_MULTI_PROCESS,
+
+    _SC_SINGLE_PROCESS,
+
+    _SC_NETWORKING,
+
+    _SC_READER_WRITER_LOCKS,
+
+    _SC_SPIN_LOCKS,
+
+    _SC_REGEXP,
+
+    _SC_REGEX_VERSION,
+
+    _SC_SHELL,
+
+    _SC_SIGNALS,
+
+    _SC_SPAWN,
+
+    _SC_SPORADIC_SERVER,
+
+    _SC_THREAD_SPORADIC_SERVER,
+
+    _SC_SYSTEM_DATABASE,
+
+    _SC_SYSTEM_DATABASE_R,
+
+    _SC_TIMEOUTS,
+
+    _SC_TYPED_MEMORY_OBJECTS,
+
+    _SC_USER_GROUPS,
+
+    _SC_USER_GROUPS_R,
+
+    _SC_2_PBS,
+
+    _SC_2_PBS_ACCOUNTING,
+
+    _SC_2_PBS_LOCATE,
+
+    _SC_2_PBS_MESSAGE,
+
+    _SC_2_PBS_TRACK,
+
+    _SC_SYMLOOP_MAX,
+
+    _SC_STREAMS,
+
+    _SC_2_PBS_CHECKPOINT,
+
+
+    _SC_V6_ILP32_OFF32,
+
+    _SC_V6_ILP32_OFFBIG,
+
+    _SC_V6_LP64_OFF64,
+
+    _SC_V6_LPBIG_OFFBIG,
+
+
+    _SC_HOST_NAME_MAX,
+
+    _SC_TRACE,
+
+    _SC_TRACE_EVENT_FILTER,
+
+    _SC_TRACE_INHERIT,
+
+    _SC_TRACE_LOG,
+
+
+    _SC_LEVEL1_ICACHE_SIZE,
+
+    _SC_LEVEL1_ICACHE_ASSOC,
+
+    _SC_LEVEL1_ICACHE_LINESIZE,
+
+    _SC_LEVEL1_DCACHE_SIZE,
+
+    _SC_LEVEL1_DCACHE_ASSOC,
+
+    _SC_LEVEL1_DCACHE_LINESIZE,
+
+    _SC_LEVEL2_CACHE_SIZE,
+
+    _SC_LEVEL2_CACHE_ASSOC,
+
+    _SC_LEVEL2_CACHE_LINESIZE,
+
+    _SC_LEVEL3_CACHE_SIZE,
+
+    _SC_LEVEL3_CACHE_ASSOC,
+
+    _SC_LEVEL3_CACHE_LINESIZE,
+
+    _SC_LEVEL4_CACHE_SIZE,
+
+    _SC_LEVEL4_CACHE_ASSOC,
+
+    _SC_LEVEL4_CACHE_LINESIZE,
+
+
+
+    _SC_IPV6 = _SC_LEVEL1_ICACHE_SIZE + 50,
+
+    _SC_RAW_SOCKETS,
+
+
+    _SC_V7_ILP32_OFF32,
+
+    _SC_V7_ILP32_OFFBIG,
+
+    _SC_V7_LP64_OFF64,
+
+    _SC_V7_LPBIG_OFFBIG,
+
+
+    _SC_SS_REPL_MAX,
+
+
+    _SC_TRACE_EVENT_NAME_MAX,
+
+    _SC_TRACE_NAME_MAX,
+
+    _SC_TRACE_SYS_MAX,
+
+    _SC_TRACE_USER_EVENT_MAX,
+
+
+    _SC_XOPEN_STREAMS,
+
+
+    _SC_THREAD_ROBUST_PRIO_INHERIT,
+
+    _SC_THREAD_ROBUST_PRIO_PROTECT,
+
+
+    _SC_MINSIGSTKSZ,
+
+
+    _SC_SIGSTKSZ
+
+  };
+
+
+enum
+  {
+    _CS_PATH,
+
+
+    _CS_V6_WIDTH_RESTRICTED_ENVS,
+
+
+
+    _CS_GNU_LIBC_VERSION,
+
+    _CS_GNU_LIBPTHREAD_VERSION,
+
+
+    _CS_V5_WIDTH_RESTRICTED_ENVS,
+
+
+
+    _CS_V7_WIDTH_RESTRICTED_ENVS,
+
+
+
+    _CS_LFS_CFLAGS = 1000,
+
+    _CS_LFS_LDFLAGS,
+
+    _CS_LFS_LIBS,
+
+    _CS_LFS_LINTFLAGS,
+
+    _CS_LFS64_CFLAGS,
+
+    _CS_LFS64_LDFLAGS,
+
+    _CS_LFS64_LIBS,
+
+    _CS_LFS64_LINTFLAGS,
+
+
+    _CS_XBS5_ILP32_OFF32_CFLAGS = 1100,
+
+    _CS_XBS5_ILP32_OFF32_LDFLAGS,
+
+    _CS_XBS5_ILP32_OFF32_LIBS,
+
+    _CS_XBS5_ILP32_OFF32_LINTFLAGS,
+
+    _CS_XBS5_ILP32_OFFBIG_CFLAGS,
+
+    _CS_XBS5_ILP32_OFFBIG_LDFLAGS,
+
+    _CS_XBS5_ILP32_OFFBIG_LIBS,
+
+    _CS_XBS5_ILP32_OFFBIG_LINTFLAGS,
+
+    _CS_XBS5_LP64_OFF64_CFLAGS,
+
+    _CS_XBS5_LP64_OFF64_LDFLAGS,
+
+    _CS_XBS5_LP64_OFF64_LIBS,
+
+    _CS_XBS5_LP64_OFF64_LINTFLAGS,
+
+    _CS_XBS5_LPBIG_OFFBIG_CFLAGS,
+
+    _CS_XBS5_LPBIG_OFFBIG_LDFLAGS,
+
+    _CS_XBS5_LPBIG_OFFBIG_LIBS,
+
+    _CS_XBS5_LPBIG_OFFBIG_LINTFLAGS,
+
+
+    _CS_POSIX_V6_ILP32_OFF32_CFLAGS,
+
+    _CS_POSIX_V6_ILP32_OFF32_LDFLAGS,
+
+    _CS_POSIX_V6_ILP32_OFF32_LIBS,
+
+    _CS_POSIX_V6_ILP32_OFF32_LINTFLAGS,
+
+    _CS_POSIX_V6_ILP32_OFFBIG_CFLAGS,
+
+    _CS_POSIX_V6_ILP32_OFFBIG_LDFLAGS,
+
+    _CS_POSIX_V6_ILP32_OFFBIG_LIBS,
+
+    _CS_POSIX_V6_ILP32_OFFBIG_LINTFLAGS,
+
+    _CS_POSIX_V6_LP64_OFF64_CFLAGS,
+
+    _CS_POSIX_V6_LP64_OFF64_LDFLAGS,
+
+    _CS_POSIX_V6_LP64_OFF64_LIBS,
+
+    _CS_POSIX_V6_LP64_OFF64_LINTFLAGS,
+
+    _CS_POSIX_V6_LPBIG_OFFBIG_CFLAGS,
+
+    _CS_POSIX_V6_LPBIG_OFFBIG_LDFLAGS,
+
+    _CS_POSIX_V6_LPBIG_OFFBIG_LIBS,
+
+    _CS_POSIX_V6_LPBIG_OFFBIG_LINTFLAGS,
+
+
+    _CS_POSIX_V7_ILP32_OFF32_CFLAGS,
+
+    _CS_POSIX_V7_ILP32_OFF32_LDFLAGS,
+
+    _CS_POSIX_V7_ILP32_OFF32_LIBS,
+
+    _CS_POSIX_V7_ILP32_OFF32_LINTFLAGS,
+
+    _CS_POSIX_V7_ILP32_OFFBIG_CFLAGS,
+
+    _CS_POSIX_V7_ILP32_OFFBIG_LDFLAGS,
+
+    _CS_POSIX_V7_ILP32_OFFBIG_LIBS,
+
+    _CS_POSIX_V7_ILP32_OFFBIG_LINTFLAGS,
+
+    _CS_POSIX_V7_LP64_OFF64_CFLAGS,
+
+    _CS_POSIX_V7_LP64_OFF64_LDFLAGS,
+
+    _CS_POSIX_V7_LP64_OFF64_LIBS,
+
+    _CS_POSIX_V7_LP64_OFF64_LINTFLAGS,
+
+    _CS_POSIX_V7_LPBIG_OFFBIG_CFLAGS,
+
+    _CS_POSIX_V7_LPBIG_OFFBIG_LDFLAGS,
+
+    _CS_POSIX_V7_LPBIG_OFFBIG_LIBS,
+
+    _CS_POSIX_V7_LPBIG_OFFBIG_LINTFLAGS,
+
+
+    _CS_V6_ENV,
+
+    _CS_V7_ENV
+
+  };
+# 626 "/usr/include/unistd.h" 2 3 4
+
+
+
+
+
+
+
+extern long int pathconf (const char *__path, int __name)
+;
+
+
+extern long int fpathconf (int __fd, int __name);
+
+
+extern long int sysconf (int __name);
+
+
+
+extern size_t confstr (int __name, char *__buf, size_t __len)
+;
+
+
+
+
+extern __pid_t getpid (void);
+
+
+extern __pid_t getppid (void);
+
+
+extern __pid_t getpgrp (void);
+
+
+extern __pid_t __getpgid (__pid_t __pid);
+
+extern __pid_t getpgid (__pid_t __pid);
+
+
+
+
+
+
+extern int setpgid (__pid_t __pid, __pid_t __pgid);
+# 682 "/usr/include/unistd.h" 3 4
+extern int setpgrp (void);
+
+
+
+
+
+
+extern __pid_t setsid (void);
+
+
+
+extern __pid_t getsid (__pid_t __pid);
+
+
+
+extern __uid_t getuid (void);
+
+
+extern __uid_t geteuid (void);
+
+
+extern __gid_t getgid (void);
+
+
+extern __gid_t getegid (void);
+
+
+
+
+extern int getgroups (int __size, __gid_t __list[])
+;
+# 722 "/usr/include/unistd.h" 3 4
+extern int setuid (__uid_t __uid);
+
+
+
+
+extern int setreuid (__uid_t __ruid, __uid_t __euid);
+
+
+
+
+extern int seteuid (__uid_t __uid);
+
+
+
+
+
+
+extern int setgid (__gid_t __gid);
+
+
+
+
+extern int setregid (__gid_t __rgid, __gid_t __egid);
+
+
+
+
+extern int setegid (__gid_t __gid);
+# 778 "/usr/include/unistd.h" 3 4
+extern __pid_t fork (void);
+
+
+
+
+
+
+
+extern __pid_t vfork (void);
+# 799 "/usr/include/unistd.h" 3 4
+extern char *ttyname (int __fd);
+
+
+
+extern int ttyname_r (int __fd, char *__buf, size_t __buflen)
+
+;
+
+
+
+extern int isatty (int __fd);
+
+
+
+
+extern int ttyslot (void);
+
+
+
+
+extern int link (const char *__from, const char *__to)
+;
+
+
+
+
+extern int linkat (int __fromfd, const char *__from, int __tofd,
+     const char *__to, int __flags)
+;
+
+
+
+
+extern int symlink (const char *__from, const char *__to)
+;
+
+
+
+
+extern ssize_t readlink (const char *restrict __path,
+    char *restrict __buf, size_t __len)
+
+;
+
+
+
+
+
+extern int symlinkat (const char *__from, int __tofd,
+        const char *__to);
+
+
+extern ssize_t readlinkat (int __fd, const char *restrict __path,
+      char *restrict __buf, size_t __len)
+
+;
+
+
+
+extern int unlink (const char *__name);
+
+
+
+extern int unlinkat (int __fd, const char *__name, int __flag)
+;
+
+
+
+extern int rmdir (const char *__path);
+
+
+
+extern __pid_t tcgetpgrp (int __fd);
+
+
+extern int tcsetpgrp (int __fd, __pid_t __pgrp_id);
+
+
+
+
+
+
+extern char *getlogin (void);
+
+
+
+
+
+
+
+extern int getlogin_r (char *__name, size_t __name_len)
+;
+
+
+
+
+extern int setlogin (const char *__name);
+# 1 "/usr/include/x86_64-linux-gnu/bits/getopt_posix.h" 1 3 4
+# 27 "/usr/include/x86_64-linux-gnu/bits/getopt_posix.h" 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/getopt_core.h" 1 3 4
+# 36 "/usr/include/x86_64-linux-gnu/bits/getopt_core.h" 3 4
+extern char *optarg;
+# 50 "/usr/include/x86_64-linux-gnu/bits/getopt_core.h" 3 4
+extern int optind;
+
+
+
+
+extern int opterr;
+
+
+
+extern int optopt;
+# 91 "/usr/include/x86_64-linux-gnu/bits/getopt_core.h" 3 4
+extern int getopt (int ___argc, char *const *___argv, const char *__shortopts)
+;
+# 28 "/usr/include/x86_64-linux-gnu/bits/getopt_posix.h" 2 3 4
+# 897 "/usr/include/unistd.h" 2 3 4
+# 911 "/usr/include/unistd.h" 3 4
+extern int gethostname (char *__name, size_t __len)
+;
+
+
+
+
+
+
+extern int sethostname (const char *__name, size_t __len)
+;
+
+
+
+extern int sethostid (long int __id);
+
+
+
+
+
+extern int getdomainname (char *__name, size_t __len)
+
+;
+extern int setdomainname (const char *__name, size_t __len)
+;
+
+
+
+
+extern int vhangup (void);
+
+
+extern int revoke (const char *__file);
+
+
+
+
+
+
+
+extern int profil (unsigned short int *__sample_buffer, size_t __size,
+     size_t __offset, unsigned int __scale)
+;
+
+
+
+
+
+extern int acct (const char *__name);
+
+
+
+extern char *getusershell (void);
+extern void endusershell (void);
+extern void setusershell (void);
+
+
+
+
+
+extern int daemon (int __nochdir, int __noclose);
+
+
+
+
+
+
+extern int chroot (const char *__path);
+
+
+
+extern char *getpass (const char *__prompt);
+
+
+
+
+
+
+
+extern int fsync (int __fd);
+# 1002 "/usr/include/unistd.h" 3 4
+extern long int gethostid (void);
+
+
+extern void sync (void);
+
+
+
+
+
+extern int getpagesize (void);
+
+
+
+
+extern int getdtablesize (void);
+# 1026 "/usr/include/unistd.h" 3 4
+extern int truncate (const char *__file, __off_t __length)
+;
+# 1049 "/usr/include/unistd.h" 3 4
+extern int ftruncate (int __fd, __off_t __length);
+# 1070 "/usr/include/unistd.h" 3 4
+extern int brk (void *__addr);
+
+
+
+
+
+extern void *sbrk (intptr_t __delta);
+# 1091 "/usr/include/unistd.h" 3 4
+extern long int syscall (long int __sysno, ...);
+# 1114 "/usr/include/unistd.h" 3 4
+extern int lockf (int __fd, int __cmd, __off_t __len);
+# 1150 "/usr/include/unistd.h" 3 4
+extern int fdatasync (int __fildes);
+
+
+
+
+
+
+
+
+extern char *crypt (const char *__key, const char *__salt)
+;
+# 1198 "/usr/include/unistd.h" 3 4
+int getentropy (void *__buffer, size_t __length)
+;
+# 62 "src/lacc.c" 2
+# 83 "src/lacc.c"
+static enum lang {
+    LANG_UNKNOWN,
+    LANG_C,
+    LANG_C_HEADER,
+    LANG_ASM
+} source_language;
+
+struct input_file {
+    const char *name;
+    const char *output_name;
+    int is_default_name;
+    enum lang language;
+};
+
+static const char *program, *output_name, *pch_name;
+static int optimization_level;
+static int dump_symbols, dump_types, print_stats;
+static int nostdinc, emit_pch;
+static char *pch_config;
+
+
+
+
+
+
+static enum {
+    DEPS_NONE,
+    DEPS_ONLY,
+    DEPS_WITH_OUTPUT
+} dependency_mode;
+
+static int dependency_exclude_system, dependency_phony_targets;
+static int is_dependency_file_opened;
+static const char *dependency_file, *dependency_target;
+
+static struct {                                                                           unsigned capacity;                                                             unsigned length; struct input_file *data;                                                                   } input_files;
+static struct {                                                                           unsigned capacity;                                                             unsigned length; char * *data;                                                                   } predefined_macros;
+static struct {                                                                           unsigned capacity;                                                             unsigned length; const char * *data;                                                                   } system_include_paths;
+
+static int help(const char *arg)
+{
+    fprintf(
+        stderr,
+        "Usage: %s [-(S|E|c)] [-I <path>] [-o <file>] <file ...>\n",
+        program);
+    return 1;
+}
+
+static int version(const char *arg)
+{
+    fprintf(stdout, "lacc version 0.0.1\n");
+    return 1;
+}
+
+static int flag(const char *arg)
+{
+    (( arg[0] == '-')             ? (void) (0)           : __assert_fail ("arg[0] == '-'", "src/lacc.c", 139, __func__));
+    (( strlen(arg) == 2)             ? (void) (0)           : __assert_fail ("strlen(arg) == 2", "src/lacc.c", 140, __func__));
+    switch (arg[1]) {
+    case 'c':
+        context.target = TARGET_x86_64_OBJ;
+        break;
+    case 'S':
+        context.target = TARGET_x86_64_ASM;
+        break;
+    case 'E':
+        context.target = TARGET_PREPROCESS;
+        break;
+    case 'P':
+        context.no_linemarkers = 1;
+        break;
+    case 'v':
+        context.verbose += 1;
+        break;
+    case 'g':
+        context.debug = 1;
+        break;
+    case 'w':
+        context.suppress_warning = 1;
+        break;
+    default:
+        (( 0)             ? (void) (0)           : __assert_fail ("0", "src/lacc.c", 164, __func__));
+        break;
+    }
+
+    return 0;
+}
+
+static int option(const char *arg)
+{
+    int disable;
+
+    (( *arg == '-')             ? (void) (0)           : __assert_fail ("*arg == '-'", "src/lacc.c", 175, __func__));
+    if (arg[1] == 'f') {
+        arg = arg + 2;
+        disable = strncmp("no-", arg, 3) == 0;
+        if (disable) {
+            arg = arg + 3;
+        }
+        if (!strcmp("PIC", arg)) {
+            context.pic = !disable;
+        } else if (!strcmp("common", arg)) {
+            context.no_common = disable;
+        } else if (!strcmp("fused-lexer", arg)) {
+            context.fused_lexer = !disable;
+        } else if (!strcmp("snapshot-include", arg)) {
+            context.snapshot_include = !disable;
+        } else if (!strcmp("preprocess-thread", arg)) {
+            context.preprocess_thread = !disable;
+        } else if (!strcmp("fast-math", arg)) {
+
+        } else if (!strcmp("strict-aliasing", arg)) {
+
+        } else (( 0)             ? (void) (0)           : __assert_fail ("0", "src/lacc.c", 196, __func__));
+    } else if (arg[1] == 'm') {
+        arg = arg + 2;
+        disable = strncmp("no-", arg, 3) == 0;
+        if (disable) {
+            arg = arg + 3;
+        }
+        if (!strcmp("sse", arg) || !strcmp("sse2", arg)
+            || !strcmp("mmx", arg)
+            || !strcmp("3dnow", arg))
+        {
+            context.no_sse = 1;
+        } else (( 0)             ? (void) (0)           : __assert_fail ("0", "src/lacc.c", 208, __func__));
+    } else if (!strcmp("-dot", arg)) {
+        context.target = TARGET_IR_DOT;
+    } else if (!strcmp("-nostdinc", arg)) {
+        nostdinc = 1;
+    }
+
+    return 0;
+}
+
+static int language(const char *arg)
+{
+    enum lang lang;
+
+    (( arg)             ? (void) (0)           : __assert_fail ("arg", "src/lacc.c", 222, __func__));
+    if (!strcmp("c", arg) || !strcmp("c-cpp-output", arg)) {
+        lang = LANG_C;
+    } else if (!strcmp("c-header", arg)) {
+        lang = LANG_C_HEADER;
+    } else if (!strcmp("assembler", arg)) {
+        lang = LANG_ASM;
+    } else if (!strcmp("none", arg)) {
+        lang = LANG_UNKNOWN;
+    } else {
+        fprintf(stderr, "Unrecognized input language %s.\n", arg);
+        return 1;
+    }
+
+    source_language = lang;
+    return 0;
+}
+
+
+static int set_visibility(const char *arg)
+{
+    return 0;
+}
+
+
+static int set_cpu(const char *arg)
+{
+    return 0;
+}
+
+
+static int warn(const char *arg)
+{
+    return 0;
+}
+
+static int set_output_name(const char *file)
+{
+    output_name = file;
+    add_linker_arg("-o");
+    add_linker_arg(file);
+    return 0;
+}
+
+static int set_pch_name(const char *path)
+{
+    pch_name = path;
+    return 0;
+}
+
+static int set_dependency_option(const char *arg)
+{
+    (( arg[0] == '-' && arg[1] == 'M')             ? (void) (0)           : __assert_fail ("arg[0] == '-' && arg[1] == 'M'", "src/lacc.c", 274, __func__));
+    if (!strcmp("-MP", arg)) {
+        dependency_phony_targets = 1;
+    } else {
+        if (!strcmp("-M", arg) || !strcmp("-MM", arg)) {
+            dependency_mode = DEPS_ONLY;
+        } else if (dependency_mode == DEPS_NONE) {
+            dependency_mode = DEPS_WITH_OUTPUT;
+        }
+        dependency_exclude_system = arg[2] == 'M';
+    }
+
+    return 0;
+}
+
+static int set_dependency_file(const char *path)
+{
+    dependency_file = path;
+    return 0;
+}
+
+static int set_dependency_target(const char *target)
+{
+    dependency_target = target;
+    return 0;
+}
+
+static int add_system_include_path(const char *path)
+{
+    do {                                                                               do {                                                                               if (( &system_include_paths)->length == ( &system_include_paths)->capacity) {                                            if (!( &system_include_paths)->capacity) {                                                            ( &system_include_paths)->capacity = 16;                                      ( &system_include_paths)->data = calloc(( &system_include_paths)->capacity, sizeof(*( &system_include_paths)->data));               } else {                                                                           ( &system_include_paths)->capacity = ( ( &system_include_paths)->capacity * 2);                      ( &system_include_paths)->data =                                                                      realloc(                                                                           ( &system_include_paths)->data,                                                                   ( &system_include_paths)->capacity * sizeof(*( &system_include_paths)->data));                               memset(                                                                            ( &system_include_paths)->data + ( &system_include_paths)->length,                                                   0,                                                                             sizeof(*( &system_include_paths)->data) * (( &system_include_paths)->capacity - ( &system_include_paths)->length));             }                                                                          }                                                                          } while (0);                                                       ( &system_include_paths)->data[( &system_include_paths)->length++] = path;                                       } while (0);
+    return 0;
+}
+
+
+static char *replace_file_suffix(const char *file, const char *suffix)
+{
+    char *name;
+    const char *slash, *dot;
+    size_t len;
+
+    slash = strrchr(file, '/');
+    dot = strrchr(slash ? slash : file, '.');
+    if (!dot) {
+        dot = file + strlen(file);
+    }
+
+    len = (dot - file);
+    name = calloc(len + strlen(suffix) + 1, sizeof(*name));
+    strncpy(name, file, len);
+    strcpy(name + len, suffix);
+    return name;
+}
+# 335 "src/lacc.c"
+static char *change_file_suffix(const char *file, enum target target)
+{
+    const char *suffix, *slash;
+
+    switch (target) {
+    default: (( 0)             ? (void) (0)           : __assert_fail ("0", "src/lacc.c", 340, __func__));
+    case TARGET_PREPROCESS:
+        return ((void *) 0);
+    case TARGET_IR_DOT:
+        suffix = ".dot";
+        break;
+    case TARGET_x86_64_ASM:
+        suffix = ".s";
+        break;
+    case TARGET_x86_64_OBJ:
+    case TARGET_x86_64_EXE:
+        suffix = ".o";
+        break;
+    }
+
+    slash = strrchr(file, '/');
+    if (slash) {
+        file = slash + 1;
+    }
+
+    return replace_file_suffix(file, suffix);
+}
+
+
+
+
+
+static char *add_pch_suffix(const char *file)
+{
+    char *name;
+
+    name = calloc(strlen(file) + 5, sizeof(*name));
+    strcpy(name, file);
+    strcat(name, ".pch");
+    return name;
+}
+
+static int add_input_file(const char *name)
+{
+    char *ptr;
+    struct input_file file = {0};
+
+    if ((file.language = source_language) == LANG_UNKNOWN) {
+        ptr = strrchr(name, '.');
+        if (ptr && (ptr[1] == 'c' || ptr[1] == 'i') && ptr[2] == '\0') {
+            file.language = LANG_C;
+        } else if (ptr && ptr[1] == 'h' && ptr[2] == '\0') {
+            file.language = LANG_C_HEADER;
+        }
+    }
+
+    file.name = name;
+    do {                                                                               do {                                                                               if (( &input_files)->length == ( &input_files)->capacity) {                                            if (!( &input_files)->capacity) {                                                            ( &input_files)->capacity = 16;                                      ( &input_files)->data = calloc(( &input_files)->capacity, sizeof(*( &input_files)->data));               } else {                                                                           ( &input_files)->capacity = ( ( &input_files)->capacity * 2);                      ( &input_files)->data =                                                                      realloc(                                                                           ( &input_files)->data,                                                                   ( &input_files)->capacity * sizeof(*( &input_files)->data));                               memset(                                                                            ( &input_files)->data + ( &input_files)->length,                                                   0,                                                                             sizeof(*( &input_files)->data) * (( &input_files)->capacity - ( &input_files)->length));             }                                                                          }                                                                          } while (0);                                                       ( &input_files)->data[( &input_files)->length++] = file;                                       } while (0);
+
+
+
+
+
+    if (file.language == LANG_C_HEADER) {
+        return 0;
+    } else if (file.language != LANG_UNKNOWN) {
+        ptr = change_file_suffix(name, TARGET_x86_64_OBJ);
+        add_linker_arg(ptr);
+        free(ptr);
+    } else {
+        add_linker_arg(name);
+    }
+
+    return 0;
+}
+
+static void clear_input_files(void)
+{
+    int i;
+    struct input_file *file;
+
+    for (i = 0; i < ( &input_files)->length; ++i) {
+        file = &( &input_files)->data[ i];
+        if (file->is_default_name) {
+            free((void *) file->output_name);
+        }
+    }
+
+    do {                                                                               if (( &input_files)->capacity)                                                               free(( &input_files)->data);                                                         ( &input_files)->length = 0;                                                             ( &input_files)->capacity = 0;                                                           ( &input_files)->data = ((void *) 0);                                                        } while (0);
+}
+
+static int set_c_std(const char *std)
+{
+    if (!strcmp("c89", std) || !strcmp("gnu89", std)) {
+        context.standard = STD_C89;
+    } else if (!strcmp("c99", std) || !strcmp("gnu99", std)) {
+        context.standard = STD_C99;
+    } else if (!strcmp("c11", std) || !strcmp("gnu11", std)) {
+        context.standard = STD_C11;
+    } else {
+        fprintf(stderr, "Unrecognized c standard %s.\n", std);
+        return 1;
+    }
+
+    return 0;
+}
+
+static int set_optimization_level(const char *level)
+{
+    (( ((*__ctype_b_loc ())[(int) ( ( level[2]))] & (unsigned short int) _ISdigit))             ? (void) (0)           : __assert_fail ("isdigit(level[2])", "src/lacc.c", 444, __func__));
+    optimization_level = level[2] - '0';
+    return 0;
+}
+
+static int long_option(const char *arg)
+{
+    if (!strcmp("--dump-symbols", arg)) {
+        dump_symbols = 1;
+    } else if (!strcmp("--dump-types", arg)) {
+        dump_types = 1;
+    } else if (!strcmp("--emit-pch", arg)) {
+        emit_pch = 1;
+    } else if (!strcmp("--trace-includes", arg)) {
+        set_include_trace_file(((void *) 0));
+    } else if (!strcmp("--profile-macros", arg)) {
+        set_macro_profile_file(((void *) 0));
+    } else if (!strcmp("--stats", arg)) {
+        print_stats = 1;
+    }
+
+    return 0;
+}
+
+static int define_macro(const char *arg)
+{
+    char *buf, *ptr;
+    size_t len;
+
+    len = strlen(arg) + 11;
+    buf = calloc(len, sizeof(*buf));
+    ptr = strchr(arg, '=');
+    if (ptr) {
+        sprintf(buf, "#define %s", arg);
+        *(buf + 8 + (ptr - arg)) = ' ';
+    } else {
+        sprintf(buf, "#define %s 1", arg);
+    }
+
+    do {                                                                               do {                                                                               if (( &predefined_macros)->length == ( &predefined_macros)->capacity) {                                            if (!( &predefined_macros)->capacity) {                                                            ( &predefined_macros)->capacity = 16;                                      ( &predefined_macros)->data = calloc(( &predefined_macros)->capacity, sizeof(*( &predefined_macros)->data));               } else {                                                                           ( &predefined_macros)->capacity = ( ( &predefined_macros)->capacity * 2);                      ( &predefined_macros)->data =                                                                      realloc(                                                                           ( &predefined_macros)->data,                                                                   ( &predefined_macros)->capacity * sizeof(*( &predefined_macros)->data));                               memset(                                                                            ( &predefined_macros)->data + ( &predefined_macros)->length,                                                   0,                                                                             sizeof(*( &predefined_macros)->data) * (( &predefined_macros)->capacity - ( &predefined_macros)->length));             }                                                                          }                                                                          } while (0);                                                       ( &predefined_macros)->data[( &predefined_macros)->length++] = buf;                                       } while (0);
+    return 0;
+}
+
+
+
+
+
+
+
+
+static void init_pch_config(void)
+{
+    int i, is_system;
+    size_t len;
+    const char *line;
+
+    len = 1;
+    for (i = 0; i < ( &predefined_macros)->length; ++i) {
+        line = ( &predefined_macros)->data[ i];
+        len += strlen(line) + 1;
+    }
+
+    for (i = 0; (line = get_include_search_path(i, &is_system)); ++i) {
+        len += strlen(line) + strlen("-isystem \n");
+    }
+
+    pch_config = calloc(len, sizeof(*pch_config));
+    for (i = 0; i < ( &predefined_macros)->length; ++i) {
+        line = ( &predefined_macros)->data[ i];
+        strcat(pch_config, line);
+        strcat(pch_config, "\n");
+    }
+
+    for (i = 0; (line = get_include_search_path(i, &is_system)); ++i) {
+        strcat(pch_config, is_system ? "-isystem " : "-I ");
+        strcat(pch_config, line);
+        strcat(pch_config, "\n");
+    }
+}
+
+static void clear_predefined_macros(void)
+{
+    int i;
+    char *buf;
+
+    for (i = 0; i < ( &predefined_macros)->length; ++i) {
+        buf = ( &predefined_macros)->data[ i];
+        free(buf);
+    }
+
+    do {                                                                               if (( &predefined_macros)->capacity)                                                               free(( &predefined_macros)->data);                                                         ( &predefined_macros)->length = 0;                                                             ( &predefined_macros)->capacity = 0;                                                           ( &predefined_macros)->data = ((void *) 0);                                                        } while (0);
+    free(pch_config);
+}
+
+static int add_linker_flag(const char *arg)
+{
+    char *end;
+
+    if (!strcmp("-rdynamic", arg)) {
+        add_linker_arg("-export-dynamic");
+    } else {
+        (( !strncmp("-Wl,", arg, 4))             ? (void) (0)           : __assert_fail ("!strncmp(\"-Wl,\", arg, 4)", "src/lacc.c", 545, __func__));
+        end = strchr(arg, ',');
+        do {
+            arg = end + 1;
+            end = strchr(arg, ',');
+            if (end) {
+                *end = '\0';
+            }
+
+            add_linker_arg(arg);
+        } while (end);
+    }
+
+    return 0;
+}
+
+static int add_linker_library(const char *lib)
+{
+    if (lib[-2] == '-') {
+        add_linker_arg(lib - 2);
+    } else {
+        add_linker_arg("-l");
+        add_linker_arg(lib);
+    }
+
+    return 0;
+}
+
+static int add_linker_path(const char *path)
+{
+    if (path[-2] == '-') {
+        add_linker_arg(path - 2);
+    } else {
+        add_linker_arg("-L");
+        add_linker_arg(path);
+    }
+
+    return 0;
+}
+
+static int print_file_name(const char *name)
+{
+    FILE *f;
+    char *path;
+
+    (( name)             ? (void) (0)           : __assert_fail ("name", "src/lacc.c", 590, __func__));
+    path = calloc(1, strlen("/usr/local/lib/lacc") + strlen(name) + 2);
+    strcpy(path, "/usr/local/lib/lacc");
+    strcat(path, "/");
+    strcat(path, name);
+    if ((f = fopen(path, "r")) != 0) {
+        printf("%s\n", path);
+        fclose(f);
+    } else {
+        printf("%s\n", name);
+    }
+
+    free(path);
+    return -1;
+}
+
+static int parse_program_arguments(int argc, char *argv[])
+{
+    int i, n, k, h;
+    struct input_file *file;
+    struct option optv[] = {
+        {"-S", &flag},
+        {"-E", &flag},
+        {"-P", &flag},
+        {"-c", &flag},
+        {"-v", &flag},
+        {"-w", &flag},
+        {"-g", &flag},
+        {"-W", &warn},
+        {"-W<", &warn},
+        {"-x:", &language},
+        {"-f[no-]PIC", &option},
+        {"-f[no-]fast-math", &option},
+        {"-f[no-]strict-aliasing", &option},
+        {"-f[no-]common", &option},
+        {"-f[no-]fused-lexer", &option},
+        {"-f[no-]snapshot-include", &option},
+        {"-f[no-]preprocess-thread", &option},
+        {"-fvisibility=", &set_visibility},
+        {"-ftoken-cache=", &set_token_cache_directory},
+        {"-m[no-]sse", &option},
+        {"-m[no-]sse2", &option},
+        {"-m[no-]3dnow", &option},
+        {"-m[no-]mmx", &option},
+        {"-dot", &option},
+        {"--help", &help},
+        {"--version", &version},
+        {"-march=", &set_cpu},
+        {"-o:", &set_output_name},
+        {"-I:", &add_include_search_path},
+        {"-O{0|1|2|3}", &set_optimization_level},
+        {"-std=", &set_c_std},
+        {"-D:", &define_macro},
+        {"--dump-symbols", &long_option},
+        {"--dump-types", &long_option},
+        {"--emit-pch", &long_option},
+        {"--trace-includes", &long_option},
+        {"--trace-includes=", &set_include_trace_file},
+        {"--profile-macros", &long_option},
+        {"--profile-macros=", &set_macro_profile_file},
+        {"--stats", &long_option},
+        {"-nostdinc", &option},
+        {"-isystem:", &add_system_include_path},
+        {"-include-pch:", &set_pch_name},
+        {"-include:", &add_include_file},
+        {"-print-file-name=", &print_file_name},
+        {"-pipe", &option},
+        {"-M", &set_dependency_option},
+        {"-MM", &set_dependency_option},
+        {"-MD", &set_dependency_option},
+        {"-MMD", &set_dependency_option},
+        {"-MP", &set_dependency_option},
+        {"-MF:", &set_dependency_file},
+        {"-MT:", &set_dependency_target},
+        {"-Wl,", &add_linker_flag},
+        {"-rdynamic", &add_linker_flag},
+        {"-shared", &add_linker_arg},
+        {"-static", &add_linker_arg},
+        {"-[no]pie", &add_linker_arg},
+        {"-f[no-]PIE", &add_linker_arg},
+        {"-l:", &add_linker_library},
+        {"-L:", &add_linker_path},
+        {((void *) 0), &add_input_file}
+    };
+
+    program = argv[0];
+    context.standard = STD_C99;
+    context.target = TARGET_x86_64_EXE;
+    context.pic = 1;
+
+    if ((i = parse_args(optv, argc, argv)) != 0) {
+        return i;
+    }
+
+    if (dependency_mode == DEPS_ONLY) {
+        context.target = TARGET_PREPROCESS;
+    }
+
+    for (i = 0, k = 0, h = 0; i < ( &input_files)->length; ++i) {
+        file = &( &input_files)->data[ i];
+        if (emit_pch && file->language == LANG_C) {
+            file->language = LANG_C_HEADER;
+        }
+        if (file->language == LANG_C_HEADER) {
+            h++;
+        } else if (file->language == LANG_UNKNOWN) {
+            switch (context.target) {
+            case TARGET_PREPROCESS:
+                file->language = LANG_C;
+                break;
+            case TARGET_x86_64_EXE:
+                do {                                                                               (( ( &input_files)->length)             ? (void) (0)           : __assert_fail ("array_len( &input_files)", "src/lacc.c", 701, __func__));                                                        memmove(                                                                           ( &input_files)->data + i,                                                               ( &input_files)->data + i + 1,                                                           (( &input_files)->length - i - 1) * sizeof(*( &input_files)->data));                          ( &input_files)->length--;                                                           } while (0);
+                i--;
+                k++;
+                break;
+            default:
+                fprintf(stderr, "Unrecognized input file %s.\n", file->name);
+                return 1;
+            }
+        }
+    }
+
+    n = ( &input_files)->length;
+    if (n == 0 && (k == 0 || context.target != TARGET_x86_64_EXE)) {
+        fprintf(stderr, "%s\n", "No input files.");
+        return 1;
+    }
+
+
+
+
+
+    if (n == h && k == 0 && context.target == TARGET_x86_64_EXE) {
+        context.target = TARGET_x86_64_OBJ;
+    }
+
+    if (output_name && context.target != TARGET_x86_64_EXE) {
+        if (n > 1) {
+            fprintf(stderr, "%s\n", "Cannot set -o with multiple inputs.");
+            return 1;
+        }
+
+        (( n == 1)             ? (void) (0)           : __assert_fail ("n == 1", "src/lacc.c", 732, __func__));
+        file = &( &input_files)->data[ 0];
+        file->output_name = output_name;
+    } else for (i = 0; i < n; ++i) {
+        file = &( &input_files)->data[ i];
+        if (file->language == LANG_C_HEADER
+            && context.target != TARGET_PREPROCESS)
+        {
+            file->output_name = add_pch_suffix(file->name);
+        } else {
+            file->output_name =
+                change_file_suffix(file->name, context.target);
+        }
+        file->is_default_name = 1;
+    }
+
+    return 0;
+}
+
+static void register_argument_definitions(void)
+{
+    int i;
+    char *line;
+
+    for (i = 0; i < ( &predefined_macros)->length; ++i) {
+        line = ( &predefined_macros)->data[ i];
+        inject_line(line);
+    }
+}
+
+
+
+
+
+static void register_builtin_declarations(void)
+{
+    inject_line("void *memcpy(void *dest, const void *src, unsigned long n);");
+    inject_line("void __builtin_alloca(unsigned long);");
+    inject_line("void __builtin_va_start(void);");
+    inject_line("void __builtin_va_arg(void);");
+    inject_line(
+        "typedef struct {"
+        "   unsigned int gp_offset;"
+        "   unsigned int fp_offset;"
+        "   void *overflow_arg_area;"
+        "   void *reg_save_area;"
+        "} __builtin_va_list[1];");
+}
+
+
+
+
+
+static void add_include_search_paths(void)
+{
+    int i;
+    const char *path;
+
+    if (!nostdinc) {
+        add_system_include_search_path("/usr/local/include");
+    }
+
+    add_system_include_search_path("/usr/local/lib/lacc" "/include");
+    if (!nostdinc) {
+
+        add_system_include_search_path("/usr/include/x86_64-linux-gnu");
+
+        add_system_include_search_path("/usr/include");
+    }
+
+    for (i = 0; i < ( &system_include_paths)->length; ++i) {
+        path = ( &system_include_paths)->data[ i];
+        add_system_include_search_path(path);
+    }
+
+    do {                                                                               if (( &system_include_paths)->capacity)                                                               free(( &system_include_paths)->data);                                                         ( &system_include_paths)->length = 0;                                                             ( &system_include_paths)->capacity = 0;                                                           ( &system_include_paths)->data = ((void *) 0);                                                        } while (0);
+}
+
+
+
+
+
+
+
+static int write_dependency_file(struct input_file file)
+{
+    FILE *stream;
+    char *name, *target;
+    const char *path;
+
+    name = ((void *) 0);
+    if (dependency_file) {
+        path = dependency_file;
+    } else if (dependency_mode == DEPS_ONLY) {
+        path = file.output_name;
+    } else if (file.output_name && !file.is_default_name) {
+        path = name = replace_file_suffix(file.output_name, ".d");
+    } else {
+        path = name = change_file_suffix(file.name, TARGET_x86_64_OBJ);
+        strcpy(name + strlen(name) - 2, ".d");
+    }
+
+    if (path) {
+        stream = fopen(path, is_dependency_file_opened ? "a" : "w");
+        if (!stream) {
+            fprintf(stderr, "Could not open dependency file '%s'.\n", path);
+            free(name);
+            return 1;
+        }
+        is_dependency_file_opened = name == ((void *) 0);
+    } else {
+        stream = stdout;
+    }
+
+    target = ((void *) 0);
+    if (!dependency_target) {
+        if (file.output_name && context.target == TARGET_x86_64_OBJ) {
+            target = (char *) file.output_name;
+        } else {
+            target = change_file_suffix(file.name, TARGET_x86_64_OBJ);
+        }
+    }
+
+    write_dependencies(
+        stream,
+        dependency_target ? dependency_target : target,
+        dependency_exclude_system,
+        dependency_phony_targets);
+
+    if (stream != stdout) {
+        fclose(stream);
+    }
+
+    if (target != file.output_name) {
+        free(target);
+    }
+
+    free(name);
+    return 0;
+}
+
+
+
+
+
+
+
+static void write_header(FILE *output, const char *path)
+{
+    int is_parsed;
+
+    push_scope(&ns_ident);
+    push_scope(&ns_tag);
+    register_builtin_declarations();
+    begin_pch();
+    while (parse() != ((void *) 0))
+        ;
+
+    if (!context.errors) {
+        is_parsed = can_write_declarations();
+        write_pch(output, path, pch_config, is_parsed);
+        if (is_parsed) {
+            write_declarations(output);
+        }
+    }
+
+    clear_types(((void *) 0));
+    pop_scope(&ns_tag);
+    pop_scope(&ns_ident);
+}
+
+
+
+
+
+static void register_declarations(void)
+{
+    FILE *stream;
+
+    push_scope(&ns_ident);
+    push_scope(&ns_tag);
+    stream = open_pch_declarations();
+    if (stream) {
+        read_declarations(stream);
+        fclose(stream);
+    } else {
+        register_builtin_declarations();
+    }
+}
+
+static int process_file(struct input_file file)
+{
+    FILE *output;
+    struct definition *def;
+    const struct symbol *sym;
+
+    preprocess_reset();
+    set_input_file(file.name);
+    register_builtin_definitions(context.standard);
+    register_argument_definitions();
+    if (dependency_mode == DEPS_ONLY) {
+        output = ((void *) 0);
+    } else if (file.output_name) {
+        output = fopen(file.output_name, "w");
+        if (!output) {
+            fprintf(stderr, "Could not open output file '%s'.\n",
+                file.output_name);
+            return 1;
+        }
+    } else {
+        output = stdout;
+    }
+
+    if (context.target == TARGET_PREPROCESS) {
+        preprocess(output);
+    } else if (file.language == LANG_C_HEADER) {
+        write_header(output, file.name);
+    } else {
+        set_compile_target(output, file.name);
+        register_declarations();
+        push_optimization(optimization_level);
+        if (context.preprocess_thread) {
+            preprocess_start_thread();
+        }
+
+        while ((def = parse()) != ((void *) 0)) {
+            if (context.errors) {
+                error("Aborting because of previous %s.",
+                    (context.errors > 1) ? "errors" : "error");
+                break;
+            }
+
+            optimize(def);
+            compile(def);
+        }
+
+        while ((sym = yield_declaration(&ns_ident)) != ((void *) 0)) {
+            declare(sym);
+        }
+
+        if (dump_symbols) {
+            output_symbols(stdout, &ns_ident);
+            output_symbols(stdout, &ns_tag);
+        }
+
+        flush();
+        pop_optimization();
+        clear_types(dump_types ? stdout : ((void *) 0));
+        pop_scope(&ns_tag);
+        pop_scope(&ns_ident);
+    }
+
+    if (output && output != stdout) {
+        fclose(output);
+    }
+
+    if (dependency_mode != DEPS_NONE && !context.errors) {
+        return write_dependency_file(file);
+    }
+
+    return context.errors;
+}
+
+int main(int argc, char *argv[])
+{
+    int i, ret;
+    struct input_file file;
+
+    if ((ret = parse_program_arguments(argc, argv)) != 0) {
+        goto end;
+    }
+
+    add_include_search_paths();
+    init_pch_config();
+    if (pch_name) {
+        include_pch(pch_name, pch_config);
+    }
+
+    for (i = 0, ret = 0; i < ( &input_files)->length; ++i) {
+        file = ( &input_files)->data[ i];
+        if ((ret = process_file(file)) != 0) {
+            goto end;
+        }
+    }
+
+    if (context.target == TARGET_x86_64_EXE) {
+        ret = invoke_linker();
+    }
+
+end:
+    if (context.trace_includes || context.profile_macros) {
+        trace_report();
+    }
+
+    if (print_stats) {
+        output_symbol_stats(stderr);
+    }
+
+    finalize();
+    parse_finalize();
+    preprocess_finalize();
+    clear_predefined_macros();
+    clear_input_files();
+    clear_linker_args();
+    return ret < 0 ? 0 : ret;
+}
@@ -0,0 +1,61 @@
+	.file	"test/input/stats.c"
+	.text
+	.globl	f
+	.type	f, @function
+f:
+	push	%rbp
+	movq	%rsp, %rbp
+	push	%rbx
+	push	%r12
+	subq	$16, %rsp
+	movl	%edi, -24(%rbp)
+.L5:
+	movl	-24(%rbp), %eax
+	cmpl	$0, %eax
+	je	.L7
+.L6:
+	movl	-24(%rbp), %eax
+	addl	$1, %eax
+	movl	%eax, %ebx
+	movl	%ebx, %r12d
+.L8:
+	movl	%r12d, %eax
+	lea	-16(%rbp), %rsp
+	pop	%r12
+	pop	%rbx
+	leave
+	ret
+.L7:
+	movl	$2, %r12d
+	jmp	.L8
+	.size	f, .-f
+	.text
+	.globl	g
+	.type	g, @function
+g:
+	push	%rbp
+	movq	%rsp, %rbp
+	push	%rbx
+	push	%r12
+	subq	$16, %rsp
+	movl	%edi, -24(%rbp)
+.L10:
+	movl	-24(%rbp), %eax
+	cmpl	$0, %eax
+	je	.L12
+.L11:
+	movl	-24(%rbp), %eax
+	addl	$1, %eax
+	movl	%eax, %ebx
+	movl	%ebx, %r12d
+.L13:
+	movl	%r12d, %eax
+	lea	-16(%rbp), %rsp
+	pop	%r12
+	pop	%rbx
+	leave
+	ret
+.L12:
+	movl	$2, %r12d
+	jmp	.L13
+	.size	g, .-g
@@ -0,0 +1,4 @@
+int cached(int a);
+int cached(int a) {
+    return ( a + 1);
+}
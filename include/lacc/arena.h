@@ -0,0 +1,49 @@
+#ifndef ARENA_H
+#define ARENA_H
+#if !defined(INTERNAL) || !defined(EXTERNAL)
+# error Missing amalgamation macros
+#endif
+
+#include "array.h"
+
+#include <stddef.h>
+
+/*
+ * Bump allocator for objects released all at once. Memory is taken from
+ * chunks starting small and doubling in size up to a limit, and larger
+ * requests are allocated separately. Chunks are kept when the arena is
+ * reset or rewound, and used again for later allocations.
+ */
+struct arena {
+    array_of(char *) chunks;
+    array_of(void *) large;
+    unsigned chunk;
+    char *ptr, *end;
+};
+
+/* Position in arena, saved in order to release what comes after. */
+struct arena_mark {
+    unsigned chunk;
+    unsigned large;
+    char *ptr, *end;
+};
+
+/*
+ * Allocate memory aligned for any type. The memory is not initialized,
+ * and stays valid until the arena is reset or rewound past it.
+ */
+INTERNAL void *arena_alloc(struct arena *arena, size_t size);
+
+/* Get current position in arena. */
+INTERNAL struct arena_mark arena_mark(const struct arena *arena);
+
+/* Release memory allocated after mark was taken. */
+INTERNAL void arena_rewind(struct arena *arena, struct arena_mark mark);
+
+/* Release all memory allocated, keeping the chunks. */
+INTERNAL void arena_reset(struct arena *arena);
+
+/* Free all memory owned by arena. */
+INTERNAL void arena_destroy(struct arena *arena);
+
+#endif
@@ -46,8 +46,11 @@
 #define array_concat(a, b) \
     do {                                                                       \
         if ((a)->capacity < array_len(a) + array_len(b)) {                     \
-            (a)->capacity =                                                    \
-                array_len(a) + array_len(b) + ARRAY_CAPACITY_INITIAL;          \
+            (a)->capacity = ARRAY_CAPACITY_GROWTH((a)->capacity);              \
+            if ((a)->capacity < array_len(a) + array_len(b)) {                 \
+                (a)->capacity =                                                \
+                    array_len(a) + array_len(b) + ARRAY_CAPACITY_INITIAL;      \
+            }                                                                  \
             (a)->data = realloc((a)->data, (a)->capacity * sizeof(*(a)->data));\
         }                                                                      \
         memcpy(                                                                \
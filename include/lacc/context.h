@@ -29,6 +29,12 @@ INTERNAL struct context {
     unsigned int debug : 1;          /* Generate debug information. */
     unsigned int no_common : 1;      /* Don't use COMMON symbols. */
     unsigned int no_sse : 1;         /* Don't use SSE instructions. */
+    unsigned int fused_lexer : 1;    /* Tokenize directly from input. */
+    unsigned int snapshot_include : 1; /* Reuse -include across files. */
+    unsigned int trace_includes : 1; /* Profile included files. */
+    unsigned int profile_macros : 1; /* Profile macro expansions. */
+    unsigned int preprocess_thread : 1; /* Preprocess on own thread. */
+    unsigned int no_linemarkers : 1; /* No line markers in -E output. */
     enum target target;
     enum cstd standard;
 } context;
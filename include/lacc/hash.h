@@ -7,9 +7,12 @@
 #include "string.h"
 
 struct hash_table {
-    /* Number of slots in the top level array. */
+    /* Number of slots in table, always a power of two. */
     unsigned capacity;
 
+    /* Number of elements stored. */
+    unsigned count;
+
     /*
      * Retrieve string representing the key we are hashing on. Keys are
      * unique identifiers of the elements, meaning they can be compared
@@ -31,19 +34,23 @@ struct hash_table {
     void (*del)(void *);
 
     /*
-     * First level array of entries, of length capacity. Resolve
-     * collisions by chaining elements.
+     * Array of entries, of length capacity. Resolve collisions by open
+     * addressing, probing linearly from the slot given by the hash. The
+     * table grows when it becomes more than 3/4 full.
      *
-     * [A] -> [B]
+     * [A]
+     * [B] <- hash(B) == hash(A)
      * [ ]
      * [C]
-     * [ ]
      *
      */
     struct hash_entry *table;
 };
 
-/* Initialize hash structure. Must be freed by hash_destroy. */
+/*
+ * Initialize hash structure with at least cap slots. Must be freed by
+ * hash_destroy.
+ */
 INTERNAL struct hash_table *hash_init(
     struct hash_table *tab,
     unsigned cap,
@@ -4,6 +4,7 @@
 # error Missing amalgamation macros
 #endif
 
+#include "arena.h"
 #include "array.h"
 #include "symbol.h"
 #include "token.h"
@@ -150,8 +151,13 @@ struct statement {
 struct block {
     const struct symbol *label;
 
-    /* Contiguous block of three-address code operations. */
+    /*
+     * Contiguous block of three-address code operations. Stored in the
+     * arena of the definition owning the block, if any, and grown only
+     * through cfg_push_statement or cfg_append_statements.
+     */
     array_of(struct statement) code;
+    struct arena *arena;
 
     /*
      * Value to evaluate in branch conditions, or return value. Also
@@ -270,10 +276,10 @@ struct definition {
         labels;
 
     /*
-     * Store all associated nodes in a list to be able to free
-     * everything at the end.
+     * Allocate all associated blocks and statements from an arena, to
+     * be able to free everything at the end.
      */
-    array_of(struct block *) nodes;
+    struct arena arena;
 
     /* Inline assembly stored more or less as-is from parsing. */
     array_of(struct asm_statement) asm_statements;
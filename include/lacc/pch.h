@@ -0,0 +1,52 @@
+#ifndef PCH_H
+#define PCH_H
+#if !defined(INTERNAL) || !defined(EXTERNAL)
+# error Missing amalgamation macros
+#endif
+
+#include "string.h"
+#include "token.h"
+#include "type.h"
+
+#include <stdio.h>
+
+/*
+ * Serialization of preprocessor and parser state to precompiled header
+ * files. The format is only meant to be read by the same build of the
+ * compiler, values are written in native byte order and layout.
+ *
+ * Reading fails with an error if the file ends prematurely.
+ */
+INTERNAL void pch_write_int(FILE *stream, long value);
+INTERNAL long pch_read_int(FILE *stream);
+
+/* Null terminated string, returned in buffer owned by caller. */
+INTERNAL void pch_write_chars(FILE *stream, const char *str);
+INTERNAL char *pch_read_chars(FILE *stream);
+
+/* String registered in string table on read. */
+INTERNAL void pch_write_string(FILE *stream, String str);
+INTERNAL String pch_read_string(FILE *stream);
+
+/* Type and constant value, written in native layout. */
+INTERNAL void pch_write_type(FILE *stream, Type type);
+INTERNAL Type pch_read_type(FILE *stream);
+INTERNAL void pch_write_value(FILE *stream, union value val);
+INTERNAL union value pch_read_value(FILE *stream);
+
+/*
+ * Token with string or numeric value. Identifiers are interned again
+ * on read, as index of the identifier object is not stable between
+ * invocations.
+ */
+INTERNAL void pch_write_token(FILE *stream, struct token t);
+INTERNAL struct token pch_read_token(FILE *stream);
+
+/*
+ * Write file magic and version, and check that file starts with the
+ * same. Return 0 if the file cannot be read by this compiler.
+ */
+INTERNAL void pch_write_header(FILE *stream);
+INTERNAL int pch_read_header(FILE *stream);
+
+#endif
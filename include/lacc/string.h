@@ -13,6 +13,11 @@
  * Compact representation of strings, such as identifiers and literals.
  * Optimize for short lengths, storing strings of length < 14 inline in
  * the object itself. This type fits in 2 eightbytes.
+ *
+ * Longer strings store the length in p.size, using the padding between
+ * the common len field and the pointer. For these, len is always equal
+ * to SHORT_STRING_LEN. Use str_len to get the actual length; len alone
+ * is only enough to distinguish empty, short and long strings.
  */
 typedef union {
     struct {
@@ -21,6 +26,7 @@ typedef union {
     } a;
     struct {
         unsigned short len;
+        unsigned int size;
         const char *str;
     } p;
     unsigned short len;
@@ -29,6 +35,10 @@ typedef union {
 /* Inline construct a String object which fits in the small variant. */
 #define SHORT_STRING_INIT(s) {{sizeof(s) - 1, s}}
 
+/* Get length of string. */
+#define str_len(s) \
+    ((s).len < SHORT_STRING_LEN ? (size_t) (s).len : (size_t) (s).p.size)
+
 /*
  * Get pointer to plain C string representation. This depends on the
  * type of string, whether it is short or long.
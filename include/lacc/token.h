@@ -7,6 +7,8 @@
 #include "string.h"
 #include "type.h"
 
+#include <stddef.h>
+
 /*
  * Map token type to corresponding numerical ascii value where possible,
  * and fit the remaining tokens in between.
@@ -164,6 +166,13 @@ struct token {
     unsigned int is_expandable : 1;
     unsigned int disable_expand : 1;
     Type type;
+
+    /*
+     * Index of interned identifier object, for identifiers and keywords.
+     * Zero if not assigned.
+     */
+    unsigned int id;
+
     union {
         String string;
         union value val;
@@ -182,4 +191,34 @@ INTERNAL struct token next(void);
 /* Consume and return next token, or fail of not of expected type. */
 INTERNAL struct token consume(enum token_type type);
 
+struct macro;
+struct symbol;
+
+/*
+ * Identifiers are interned to a unique object per translation unit,
+ * referenced from tokens by index. The object caches the current macro
+ * definition and innermost visible symbol in each of the identifier,
+ * tag and label namespaces, to avoid repeated hash lookups by name.
+ *
+ * Keywords are interned with index equal to their token type, and other
+ * identifiers are numbered from there.
+ */
+struct ident {
+    String name;
+    unsigned int id;
+    struct macro *macro;
+    struct symbol *sym;
+    struct symbol *tag;
+    struct symbol *label;
+};
+
+/* Intern identifier, returning index of unique object. */
+INTERNAL unsigned int ident_register(const char *str, size_t len);
+
+/* Get identifier object by index. */
+INTERNAL struct ident *ident_get(unsigned int id);
+
+/* Get identifier object by name, or NULL if not interned. */
+INTERNAL struct ident *ident_lookup(String name);
+
 #endif
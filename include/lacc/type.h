@@ -39,9 +39,12 @@ enum type {
  * For function, array, aggregate, and deeper pointer types, the type is
  * encoded in an opaque structure referenced by ref. All other types are
  * completely represented by this object, and have ref value 0.
+ *
+ * Only a few bits are needed for enum type, including -1 used as type
+ * placeholder, leaving the rest for references.
  */
 typedef struct {
-    int type : 8;
+    int type : 5;
     unsigned int is_unsigned : 1;
     unsigned int is_const : 1;
     unsigned int is_volatile : 1;
@@ -50,7 +53,7 @@ typedef struct {
     unsigned int is_pointer_const : 1;
     unsigned int is_pointer_volatile : 1;
     unsigned int is_pointer_restrict : 1;
-    int ref : 16;
+    unsigned int ref : 19;
 } Type;
 
 /* Type can be overridden to mean pointer. */
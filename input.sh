@@ -0,0 +1,33 @@
+#!/bin/sh
+
+if test -t 1
+then
+    colors=$(tput colors)
+    if test -n "$colors" && test $colors -ge 8
+    then
+        reset="$(tput sgr0)"
+        red="$(tput setaf 1)"
+        green="$(tput setaf 2)"
+    fi
+fi
+
+lacc="$1"
+file="$2"
+if [ -z "$file" ] || [ ! -f "$file" ]; then
+	echo "Usage: $0 <compiler> <test script>";
+	exit 1
+fi
+
+# Each script gets its own directory for output files.
+dir=bin/input/$(basename $file .sh)
+rm -rf $dir && mkdir -p $dir
+
+sh $file "$lacc" "$dir"
+retval=$?
+if [ $retval -eq 0 ]; then
+	echo "[${green}Ok!${reset}] :: ${file}"
+else
+	echo "[${red}Failed!${reset}] :: ${file}"
+fi
+
+exit $retval
@@ -3,7 +3,7 @@
 # define EXTERNAL extern
 #endif
 #include "parser/typetree.h"
-#include "preprocessor/input.h"
+#include "preprocessor/preprocess.h"
 #include <lacc/context.h>
 
 #include <assert.h>
@@ -85,31 +85,37 @@ INTERNAL void verbose(const char *format, ...)
 INTERNAL void warning(const char *format, ...)
 {
     va_list args;
+    String path;
+    int line, is_held;
+
     if (!context.suppress_warning) {
+        is_held = diagnostic_begin(&path, &line);
         va_start(args, format);
-        fprintf(
-            stderr,
-            "(%s, %d) warning: ",
-            str_raw(current_file_path),
-            current_file_line);
+        fprintf(stderr, "(%s, %d) warning: ", str_raw(path), line);
         vfprintf_cc(stderr, format, args);
         fputc('\n', stderr);
         va_end(args);
+        diagnostic_end(is_held);
     }
 }
 
 INTERNAL void error(const char *format, ...)
 {
     va_list args;
+    String path;
+    int line, is_held;
 
+    /*
+     * Errors from the preprocessor thread are counted while the parser
+     * is held waiting for tokens, such that there is no race on the
+     * error count.
+     */
+    is_held = diagnostic_begin(&path, &line);
     context.errors++;
     va_start(args, format);
-    fprintf(
-        stderr,
-        "(%s, %d) error: ",
-        str_raw(current_file_path),
-        current_file_line);
+    fprintf(stderr, "(%s, %d) error: ", str_raw(path), line);
     vfprintf_cc(stderr, format, args);
     fputc('\n', stderr);
     va_end(args);
+    diagnostic_end(is_held);
 }
@@ -2,6 +2,7 @@
 # define INTERNAL static
 # define EXTERNAL static
 # include "context.c"
+# include "util/arena.c"
 # include "util/argparse.c"
 # include "util/hash.c"
 # include "util/string.c"
@@ -23,6 +24,10 @@
 # include "preprocessor/directive.c"
 # include "preprocessor/preprocess.c"
 # include "preprocessor/macro.c"
+# include "preprocessor/pch.c"
+# include "preprocessor/tokencache.c"
+# include "preprocessor/trace.c"
+# include "preprocessor/pipeline.c"
 # include "parser/typetree.c"
 # include "parser/symtab.c"
 # include "parser/parse.c"
@@ -43,6 +48,8 @@
 # include "preprocessor/preprocess.h"
 # include "preprocessor/input.h"
 # include "preprocessor/macro.h"
+# include "preprocessor/tokencache.h"
+# include "preprocessor/trace.h"
 # include "util/argparse.h"
 # include <lacc/context.h>
 # include <lacc/ir.h>
@@ -76,6 +83,7 @@
 static enum lang {
     LANG_UNKNOWN,
     LANG_C,
+    LANG_C_HEADER,
     LANG_ASM
 } source_language;
 
@@ -86,10 +94,26 @@ struct input_file {
     enum lang language;
 };
 
-static const char *program, *output_name;
+static const char *program, *output_name, *pch_name;
 static int optimization_level;
-static int dump_symbols, dump_types;
-static int nostdinc;
+static int dump_symbols, dump_types, print_stats;
+static int nostdinc, emit_pch;
+static char *pch_config;
+
+/*
+ * Dependency output for make. With -M or -MM, input is only read by the
+ * preprocessor, and the rule is written instead of any other output.
+ * With -MD or -MMD, the rule is written to a file next to the output.
+ */
+static enum {
+    DEPS_NONE,
+    DEPS_ONLY,
+    DEPS_WITH_OUTPUT
+} dependency_mode;
+
+static int dependency_exclude_system, dependency_phony_targets;
+static int is_dependency_file_opened;
+static const char *dependency_file, *dependency_target;
 
 static array_of(struct input_file) input_files;
 static array_of(char *) predefined_macros;
@@ -124,6 +148,9 @@ static int flag(const char *arg)
     case 'E':
         context.target = TARGET_PREPROCESS;
         break;
+    case 'P':
+        context.no_linemarkers = 1;
+        break;
     case 'v':
         context.verbose += 1;
         break;
@@ -156,6 +183,12 @@ static int option(const char *arg)
             context.pic = !disable;
         } else if (!strcmp("common", arg)) {
             context.no_common = disable;
+        } else if (!strcmp("fused-lexer", arg)) {
+            context.fused_lexer = !disable;
+        } else if (!strcmp("snapshot-include", arg)) {
+            context.snapshot_include = !disable;
+        } else if (!strcmp("preprocess-thread", arg)) {
+            context.preprocess_thread = !disable;
         } else if (!strcmp("fast-math", arg)) {
             /* Always slow... */
         } else if (!strcmp("strict-aliasing", arg)) {
@@ -187,11 +220,10 @@ static int language(const char *arg)
     enum lang lang;
 
     assert(arg);
-    if (!strcmp("c", arg)
-        || !strcmp("c-header", arg)
-        || !strcmp("c-cpp-output", arg))
-    {
+    if (!strcmp("c", arg) || !strcmp("c-cpp-output", arg)) {
         lang = LANG_C;
+    } else if (!strcmp("c-header", arg)) {
+        lang = LANG_C_HEADER;
     } else if (!strcmp("assembler", arg)) {
         lang = LANG_ASM;
     } else if (!strcmp("none", arg)) {
@@ -231,12 +263,67 @@ static int set_output_name(const char *file)
     return 0;
 }
 
+static int set_pch_name(const char *path)
+{
+    pch_name = path;
+    return 0;
+}
+
+static int set_dependency_option(const char *arg)
+{
+    assert(arg[0] == '-' && arg[1] == 'M');
+    if (!strcmp("-MP", arg)) {
+        dependency_phony_targets = 1;
+    } else {
+        if (!strcmp("-M", arg) || !strcmp("-MM", arg)) {
+            dependency_mode = DEPS_ONLY;
+        } else if (dependency_mode == DEPS_NONE) {
+            dependency_mode = DEPS_WITH_OUTPUT;
+        }
+        dependency_exclude_system = arg[2] == 'M';
+    }
+
+    return 0;
+}
+
+static int set_dependency_file(const char *path)
+{
+    dependency_file = path;
+    return 0;
+}
+
+static int set_dependency_target(const char *target)
+{
+    dependency_target = target;
+    return 0;
+}
+
 static int add_system_include_path(const char *path)
 {
     array_push_back(&system_include_paths, path);
     return 0;
 }
 
+/* Replace suffix of file name, keeping any path information. */
+static char *replace_file_suffix(const char *file, const char *suffix)
+{
+    char *name;
+    const char *slash, *dot;
+    size_t len;
+
+    slash = strrchr(file, '/');
+    dot = strrchr(slash ? slash : file, '.');
+    if (!dot) {
+        dot = file + strlen(file);
+    }
+
+    len = (dot - file);
+    name = calloc(len + strlen(suffix) + 1, sizeof(*name));
+    strncpy(name, file, len);
+    strcpy(name + len, suffix);
+    return name;
+}
+
 /*
  * Write to default file if -o, -S or -dot is specified, using input
  * file name with suffix changed to '.o', '.s' or '.dot', respectively.
@@ -247,9 +334,7 @@ static int add_system_include_path(const char *path)
  */
 static char *change_file_suffix(const char *file, enum target target)
 {
-    char *name, *suffix;
-    const char *slash, *dot;
-    size_t len;
+    const char *suffix, *slash;
 
     switch (target) {
     default: assert(0);
@@ -272,17 +357,20 @@ static char *change_file_suffix(const char *file, enum target target)
         file = slash + 1;
     }
 
-    dot = strrchr(file, '.');
-    if (!dot) {
-        dot = file + strlen(file);
-    }
+    return replace_file_suffix(file, suffix);
+}
 
-    len = (dot - file);
-    name = calloc(len + strlen(suffix) + 1, sizeof(*name));
-    strncpy(name, file, len);
-    assert(!name[len] || name[len] == '.');
-    name[len] = '.';
-    strcpy(name + len, suffix);
+/*
+ * Precompiled headers are written next to the original header, with
+ * '.pch' appended to the file name.
+ */
+static char *add_pch_suffix(const char *file)
+{
+    char *name;
+
+    name = calloc(strlen(file) + 5, sizeof(*name));
+    strcpy(name, file);
+    strcat(name, ".pch");
     return name;
 }
 
@@ -295,6 +383,8 @@ static int add_input_file(const char *name)
         ptr = strrchr(name, '.');
         if (ptr && (ptr[1] == 'c' || ptr[1] == 'i') && ptr[2] == '\0') {
             file.language = LANG_C;
+        } else if (ptr && ptr[1] == 'h' && ptr[2] == '\0') {
+            file.language = LANG_C_HEADER;
         }
     }
 
@@ -305,7 +395,9 @@ static int add_input_file(const char *name)
      * Linker argument might not be needed, but make sure order is
      * preserved.
      */
-    if (file.language != LANG_UNKNOWN) {
+    if (file.language == LANG_C_HEADER) {
+        return 0;
+    } else if (file.language != LANG_UNKNOWN) {
         ptr = change_file_suffix(name, TARGET_x86_64_OBJ);
         add_linker_arg(ptr);
         free(ptr);
@@ -360,6 +452,14 @@ static int long_option(const char *arg)
         dump_symbols = 1;
     } else if (!strcmp("--dump-types", arg)) {
         dump_types = 1;
+    } else if (!strcmp("--emit-pch", arg)) {
+        emit_pch = 1;
+    } else if (!strcmp("--trace-includes", arg)) {
+        set_include_trace_file(NULL);
+    } else if (!strcmp("--profile-macros", arg)) {
+        set_macro_profile_file(NULL);
+    } else if (!strcmp("--stats", arg)) {
+        print_stats = 1;
     }
 
     return 0;
@@ -384,6 +484,43 @@ static int define_macro(const char *arg)
     return 0;
 }
 
+/*
+ * Options that must be the same when using a precompiled header as when
+ * it was written, in addition to the language standard. Represented as
+ * the list of macros defined on the command line, followed by the
+ * directories searched for includes. These can resolve the same name
+ * to a different header, without any dependency being modified.
+ */
+static void init_pch_config(void)
+{
+    int i, is_system;
+    size_t len;
+    const char *line;
+
+    len = 1;
+    for (i = 0; i < array_len(&predefined_macros); ++i) {
+        line = array_get(&predefined_macros, i);
+        len += strlen(line) + 1;
+    }
+
+    for (i = 0; (line = get_include_search_path(i, &is_system)); ++i) {
+        len += strlen(line) + strlen("-isystem \n");
+    }
+
+    pch_config = calloc(len, sizeof(*pch_config));
+    for (i = 0; i < array_len(&predefined_macros); ++i) {
+        line = array_get(&predefined_macros, i);
+        strcat(pch_config, line);
+        strcat(pch_config, "\n");
+    }
+
+    for (i = 0; (line = get_include_search_path(i, &is_system)); ++i) {
+        strcat(pch_config, is_system ? "-isystem " : "-I ");
+        strcat(pch_config, line);
+        strcat(pch_config, "\n");
+    }
+}
+
 static void clear_predefined_macros(void)
 {
     int i;
@@ -395,6 +532,7 @@ static void clear_predefined_macros(void)
     }
 
     array_clear(&predefined_macros);
+    free(pch_config);
 }
 
 static int add_linker_flag(const char *arg)
@@ -467,11 +605,12 @@ static int print_file_name(const char *name)
 
 static int parse_program_arguments(int argc, char *argv[])
 {
-    int i, n, k;
+    int i, n, k, h;
     struct input_file *file;
     struct option optv[] = {
         {"-S", &flag},
         {"-E", &flag},
+        {"-P", &flag},
         {"-c", &flag},
         {"-v", &flag},
         {"-w", &flag},
@@ -483,7 +622,11 @@ static int parse_program_arguments(int argc, char *argv[])
         {"-f[no-]fast-math", &option},
         {"-f[no-]strict-aliasing", &option},
         {"-f[no-]common", &option},
+        {"-f[no-]fused-lexer", &option},
+        {"-f[no-]snapshot-include", &option},
+        {"-f[no-]preprocess-thread", &option},
         {"-fvisibility=", &set_visibility},
+        {"-ftoken-cache=", &set_token_cache_directory},
         {"-m[no-]sse", &option},
         {"-m[no-]sse2", &option},
         {"-m[no-]3dnow", &option},
@@ -499,13 +642,25 @@ static int parse_program_arguments(int argc, char *argv[])
         {"-D:", &define_macro},
         {"--dump-symbols", &long_option},
         {"--dump-types", &long_option},
+        {"--emit-pch", &long_option},
+        {"--trace-includes", &long_option},
+        {"--trace-includes=", &set_include_trace_file},
+        {"--profile-macros", &long_option},
+        {"--profile-macros=", &set_macro_profile_file},
+        {"--stats", &long_option},
         {"-nostdinc", &option},
         {"-isystem:", &add_system_include_path},
+        {"-include-pch:", &set_pch_name},
         {"-include:", &add_include_file},
         {"-print-file-name=", &print_file_name},
         {"-pipe", &option},
-        {"-MD", &option},
-        {"-MP", &option},
+        {"-M", &set_dependency_option},
+        {"-MM", &set_dependency_option},
+        {"-MD", &set_dependency_option},
+        {"-MMD", &set_dependency_option},
+        {"-MP", &set_dependency_option},
+        {"-MF:", &set_dependency_file},
+        {"-MT:", &set_dependency_target},
         {"-Wl,", &add_linker_flag},
         {"-rdynamic", &add_linker_flag},
         {"-shared", &add_linker_arg},
@@ -526,9 +681,18 @@ static int parse_program_arguments(int argc, char *argv[])
         return i;
     }
 
-    for (i = 0, k = 0; i < array_len(&input_files); ++i) {
+    if (dependency_mode == DEPS_ONLY) {
+        context.target = TARGET_PREPROCESS;
+    }
+
+    for (i = 0, k = 0, h = 0; i < array_len(&input_files); ++i) {
         file = &array_get(&input_files, i);
-        if (file->language == LANG_UNKNOWN) {
+        if (emit_pch && file->language == LANG_C) {
+            file->language = LANG_C_HEADER;
+        }
+        if (file->language == LANG_C_HEADER) {
+            h++;
+        } else if (file->language == LANG_UNKNOWN) {
             switch (context.target) {
             case TARGET_PREPROCESS:
                 file->language = LANG_C;
@@ -551,6 +715,14 @@ static int parse_program_arguments(int argc, char *argv[])
         return 1;
     }
 
+    /*
+     * Precompiling headers does not involve the linker, and -o names the
+     * precompiled header file.
+     */
+    if (n == h && k == 0 && context.target == TARGET_x86_64_EXE) {
+        context.target = TARGET_x86_64_OBJ;
+    }
+
     if (output_name && context.target != TARGET_x86_64_EXE) {
         if (n > 1) {
             fprintf(stderr, "%s\n", "Cannot set -o with multiple inputs.");
@@ -562,7 +734,14 @@ static int parse_program_arguments(int argc, char *argv[])
         file->output_name = output_name;
     } else for (i = 0; i < n; ++i) {
         file = &array_get(&input_files, i);
-        file->output_name = change_file_suffix(file->name, context.target);
+        if (file->language == LANG_C_HEADER
+            && context.target != TARGET_PREPROCESS)
+        {
+            file->output_name = add_pch_suffix(file->name);
+        } else {
+            file->output_name =
+                change_file_suffix(file->name, context.target);
+        }
         file->is_default_name = 1;
     }
 
@@ -609,25 +788,137 @@ static void add_include_search_paths(void)
     const char *path;
 
     if (!nostdinc) {
-        add_include_search_path("/usr/local/include");
+        add_system_include_search_path("/usr/local/include");
     }
 
-    add_include_search_path(LACC_LIB_PATH "/include");
+    add_system_include_search_path(LACC_LIB_PATH "/include");
     if (!nostdinc) {
 #ifdef SYSTEM_LIB_PATH
-        add_include_search_path(SYSTEM_LIB_PATH);
+        add_system_include_search_path(SYSTEM_LIB_PATH);
 #endif
-        add_include_search_path("/usr/include");
+        add_system_include_search_path("/usr/include");
     }
 
     for (i = 0; i < array_len(&system_include_paths); ++i) {
         path = array_get(&system_include_paths, i);
-        add_include_search_path(path);
+        add_system_include_search_path(path);
     }
 
     array_clear(&system_include_paths);
 }
 
+/*
+ * Write dependencies of the input file just processed. The rule is
+ * written to file given by -MF, or by -o with -M. Otherwise -M writes
+ * to stdout, and -MD to a file with suffix '.d' next to the output.
+ * Target is the object file, unless specified with -MT.
+ */
+static int write_dependency_file(struct input_file file)
+{
+    FILE *stream;
+    char *name, *target;
+    const char *path;
+
+    name = NULL;
+    if (dependency_file) {
+        path = dependency_file;
+    } else if (dependency_mode == DEPS_ONLY) {
+        path = file.output_name;
+    } else if (file.output_name && !file.is_default_name) {
+        path = name = replace_file_suffix(file.output_name, ".d");
+    } else {
+        path = name = change_file_suffix(file.name, TARGET_x86_64_OBJ);
+        strcpy(name + strlen(name) - 2, ".d");
+    }
+
+    if (path) {
+        stream = fopen(path, is_dependency_file_opened ? "a" : "w");
+        if (!stream) {
+            fprintf(stderr, "Could not open dependency file '%s'.\n", path);
+            free(name);
+            return 1;
+        }
+        is_dependency_file_opened = name == NULL;
+    } else {
+        stream = stdout;
+    }
+
+    target = NULL;
+    if (!dependency_target) {
+        if (file.output_name && context.target == TARGET_x86_64_OBJ) {
+            target = (char *) file.output_name;
+        } else {
+            target = change_file_suffix(file.name, TARGET_x86_64_OBJ);
+        }
+    }
+
+    write_dependencies(
+        stream,
+        dependency_target ? dependency_target : target,
+        dependency_exclude_system,
+        dependency_phony_targets);
+
+    if (stream != stdout) {
+        fclose(stream);
+    }
+
+    if (target != file.output_name) {
+        free(target);
+    }
+
+    free(name);
+    return 0;
+}
+
+/*
+ * Parse header to be precompiled, but generate no code. Symbols and
+ * types are written in place of tokens if there are only declarations,
+ * and none of the definitions which must be compiled in each including
+ * file.
+ */
+static void write_header(FILE *output, const char *path)
+{
+    int is_parsed;
+
+    push_scope(&ns_ident);
+    push_scope(&ns_tag);
+    register_builtin_declarations();
+    begin_pch();
+    while (parse() != NULL)
+        ;
+
+    if (!context.errors) {
+        is_parsed = can_write_declarations();
+        write_pch(output, path, pch_config, is_parsed);
+        if (is_parsed) {
+            write_declarations(output);
+        }
+    }
+
+    clear_types(NULL);
+    pop_scope(&ns_tag);
+    pop_scope(&ns_ident);
+}
+
+/*
+ * Start translation unit with builtin declarations, or declarations
+ * from precompiled header which already include them.
+ */
+static void register_declarations(void)
+{
+    FILE *stream;
+
+    push_scope(&ns_ident);
+    push_scope(&ns_tag);
+    stream = open_pch_declarations();
+    if (stream) {
+        read_declarations(stream);
+        fclose(stream);
+    } else {
+        register_builtin_declarations();
+    }
+}
+
 static int process_file(struct input_file file)
 {
     FILE *output;
@@ -638,7 +929,9 @@ static int process_file(struct input_file file)
     set_input_file(file.name);
     register_builtin_definitions(context.standard);
     register_argument_definitions();
-    if (file.output_name) {
+    if (dependency_mode == DEPS_ONLY) {
+        output = NULL;
+    } else if (file.output_name) {
         output = fopen(file.output_name, "w");
         if (!output) {
             fprintf(stderr, "Could not open output file '%s'.\n",
@@ -651,12 +944,15 @@ static int process_file(struct input_file file)
 
     if (context.target == TARGET_PREPROCESS) {
         preprocess(output);
+    } else if (file.language == LANG_C_HEADER) {
+        write_header(output, file.name);
     } else {
         set_compile_target(output, file.name);
-        push_scope(&ns_ident);
-        push_scope(&ns_tag);
-        register_builtin_declarations();
+        register_declarations();
         push_optimization(optimization_level);
+        if (context.preprocess_thread) {
+            preprocess_start_thread();
+        }
 
         while ((def = parse()) != NULL) {
             if (context.errors) {
@@ -685,10 +981,14 @@ static int process_file(struct input_file file)
         pop_scope(&ns_ident);
     }
 
-    if (output != stdout) {
+    if (output && output != stdout) {
         fclose(output);
     }
 
+    if (dependency_mode != DEPS_NONE && !context.errors) {
+        return write_dependency_file(file);
+    }
+
     return context.errors;
 }
 
@@ -702,6 +1002,11 @@ int main(int argc, char *argv[])
     }
 
     add_include_search_paths();
+    init_pch_config();
+    if (pch_name) {
+        include_pch(pch_name, pch_config);
+    }
+
     for (i = 0, ret = 0; i < array_len(&input_files); ++i) {
         file = array_get(&input_files, i);
         if ((ret = process_file(file)) != 0) {
@@ -714,6 +1019,14 @@ int main(int argc, char *argv[])
     }
 
 end:
+    if (context.trace_includes || context.profile_macros) {
+        trace_report();
+    }
+
+    if (print_stats) {
+        output_symbol_stats(stderr);
+    }
+
     finalize();
     parse_finalize();
     preprocess_finalize();
@@ -15,11 +15,11 @@
 
 #include <assert.h>
 
-static const Type *get_typedef(String str)
+static const Type *get_typedef(struct token t)
 {
     struct symbol *tag;
 
-    tag = sym_lookup(&ns_ident, str);
+    tag = sym_lookup_ident(t);
     if (tag && tag->symtype == SYM_TYPEDEF) {
         return &tag->type;
     }
@@ -129,7 +129,7 @@ static Type identifier_list(Type base)
     if (peek().token != ')') {
         while (1) {
             t = consume(IDENTIFIER);
-            if (get_typedef(t.d.string)) {
+            if (get_typedef(t)) {
                 error("Unexpected type '%t' in identifier list.");
                 exit(1);
             }
@@ -324,7 +324,7 @@ static struct block *direct_declarator(
         break;
     case '(':
         t = peekn(2);
-        if ((t.token == IDENTIFIER && !get_typedef(t.d.string))
+        if ((t.token == IDENTIFIER && !get_typedef(t))
             || t.token == '('
             || t.token == '*')
         {
@@ -349,7 +349,7 @@ static struct block *direct_declarator(
         t = peek();
         push_scope(&ns_tag);
         push_scope(&ns_ident);
-        if (t.token == IDENTIFIER && !get_typedef(t.d.string)) {
+        if (t.token == IDENTIFIER && !get_typedef(t)) {
             *type = identifier_list(base);
         } else {
             block = parameter_list(def, block, base, type);
@@ -732,7 +732,7 @@ INTERNAL Type declaration_specifiers(struct declaration_specifier_info *info)
             qual |= Q_VOLATILE;
             break;
         case IDENTIFIER:
-            tagged = get_typedef(tok.d.string);
+            tagged = get_typedef(tok);
             if (!tagged || base || modifier || sign) goto done;
             next();
             type = *tagged;
@@ -855,7 +855,7 @@ static void define_builtin__func__(String name)
 
     assert(current_scope_depth(&ns_ident) == 1);
     if (context.standard >= STD_C99) {
-        type = type_create_array(basic_type__char, (size_t) name.len + 1);
+        type = type_create_array(basic_type__char, (size_t) str_len(name) + 1);
         sym = sym_add(&ns_ident, func, type, SYM_LITERAL, LINK_INTERN);
         sym->value.string = name;
     }
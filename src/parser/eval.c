@@ -40,7 +40,7 @@ static int extract_literal_char(struct var v)
 
     str = v.symbol->value.string;
     raw = str_raw(str);
-    if (v.offset >= str.len) {
+    if (v.offset >= str_len(str)) {
         error("Access outside bounds of string literal.");
         exit(1);
     }
@@ -307,7 +307,7 @@ INTERNAL void emit_ir(struct block *block, enum sttype st, ...)
             break;
         }
 
-        array_push_back(&block->code, stmt);
+        cfg_push_statement(block, stmt);
         va_end(args);
     }
 }
@@ -18,11 +18,11 @@ static struct block *cast_expression(
     struct definition *def,
     struct block *block);
 
-static const struct symbol *find_symbol(String name)
+static const struct symbol *find_symbol(struct token t)
 {
-    const struct symbol *sym = sym_lookup(&ns_ident, name);
+    const struct symbol *sym = sym_lookup_ident(t);
     if (!sym) {
-        error("Undefined symbol '%s'.", str_raw(name));
+        error("Undefined symbol '%s'.", str_raw(t.d.string));
         exit(1);
     }
 
@@ -48,7 +48,7 @@ static struct block *parse__builtin_va_start(
     consume(',');
     param = consume(IDENTIFIER);
 
-    sym = find_symbol(param.d.string);
+    sym = find_symbol(param);
     type = def->symbol->type;
     if (!is_vararg(type)) {
         error("Function must be vararg to use va_start.");
@@ -145,7 +145,7 @@ static struct block *primary_expression(
 
     switch ((tok = next()).token) {
     case IDENTIFIER:
-        sym = find_symbol(tok.d.string);
+        sym = find_symbol(tok);
         if (!strcmp("__builtin_va_start", str_raw(sym->name))) {
             block = parse__builtin_va_start(def, block);
         } else if (!strcmp("__builtin_va_arg", str_raw(sym->name))) {
@@ -401,7 +401,7 @@ static struct block *postfix_expression(
     if (context.standard == STD_C89) {
         tok = peek();
         if (tok.token == IDENTIFIER && peekn(2).token == '(') {
-            sym = sym_lookup(&ns_ident, tok.d.string);
+            sym = sym_lookup_ident(tok);
             if (!sym) {
                 type = type_create_function(basic_type__int);
                 sym_add(&ns_ident, tok.d.string, type,
@@ -487,7 +487,7 @@ static struct block *unary_expression(
         if (peek().token == '(') {
             switch (peekn(2).token) {
             case IDENTIFIER:
-                sym = sym_lookup(&ns_ident, peekn(2).d.string);
+                sym = sym_lookup_ident(peekn(2));
                 if (!sym || sym->symtype != SYM_TYPEDEF)
                     goto exprsize;;
             case FIRST(type_name):
@@ -599,7 +599,7 @@ static struct block *cast_expression(
         tok = peekn(2);
         switch (tok.token) {
         case IDENTIFIER:
-            sym = sym_lookup(&ns_ident, tok.d.string);
+            sym = sym_lookup_ident(tok);
             if (!sym || sym->symtype != SYM_TYPEDEF)
                 break;
         case FIRST(type_name):
@@ -231,7 +231,7 @@ static struct block *initialize_union(
         done = 1;
     } while (next_element(state));
 
-    array_concat(&values->code, &init->code);
+    cfg_append_statements(values, init);
     release_initializer_block(init);
     return block;
 }
@@ -497,7 +497,7 @@ static void assign_initializer_element(
     eval_assign(def, block, target, block->expr);
     st = array_pop_back(&block->code);
     assert(st.st == IR_ASSIGN);
-    array_push_back(&values->code, st);
+    cfg_push_statement(values, st);
     block->has_init_value = 0;
 }
 
@@ -929,7 +929,7 @@ static struct block *postprocess_object_initialization(
         assert(st.expr.op != IR_OP_CALL);
         assert(next.symbol == target.symbol);
         initialize_padding(def, block, prev, next);
-        array_push_back(&block->code, st);
+        cfg_push_statement(block, st);
         prev.offset = next.offset;
         prev.field_offset = next.field_offset + next.field_width;
         if (!next.field_width) {
@@ -963,7 +963,7 @@ INTERNAL struct block *initializer(
         values = get_initializer_block();
         block = initialize_object(def, block, values, target);
         values = postprocess_object_initialization(def, values, target);
-        array_concat(&block->code, &values->code);
+        cfg_append_statements(block, values);
         release_initializer_block(values);
     } else {
         block = read_initializer_element(def, block, target.symbol);
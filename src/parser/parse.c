@@ -10,6 +10,8 @@
 #include <lacc/deque.h>
 
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
 
 /*
  * Parser consumes whole declaration statements, which can include
@@ -73,6 +75,7 @@ static void recycle_block(struct block *block)
 {
     struct expression expr = {0};
 
+    assert(!block->arena);
     array_empty(&block->code);
     block->label = NULL;
     block->expr = expr;
@@ -100,10 +103,6 @@ static void cfg_empty(struct definition *def)
         sym_discard(sym);
     }
 
-    for (i = 0; i < array_len(&def->nodes); ++i) {
-        recycle_block(array_get(&def->nodes, i));
-    }
-
     for (i = 0; i < array_len(&def->asm_statements); ++i) {
         st = &array_get(&def->asm_statements, i);
         array_clear(&st->operands);
@@ -114,30 +113,81 @@ static void cfg_empty(struct definition *def)
     array_empty(&def->params);
     array_empty(&def->locals);
     array_empty(&def->labels);
-    array_empty(&def->nodes);
     array_empty(&def->asm_statements);
+    arena_reset(&def->arena);
 }
 
 INTERNAL struct block *cfg_block_init(struct definition *def)
 {
     struct block *block;
 
-    if (array_len(&blocks)) {
-        block = array_pop_back(&blocks);
-    } else {
-        block = calloc(1, sizeof(*block));
-    }
-
     if (def) {
+        block = arena_alloc(&def->arena, sizeof(*block));
+        memset(block, 0, sizeof(*block));
+        block->arena = &def->arena;
         block->label = create_label(def);
-        array_push_back(&def->nodes, block);
     } else {
+        if (array_len(&blocks)) {
+            block = array_pop_back(&blocks);
+        } else {
+            block = calloc(1, sizeof(*block));
+        }
+
         array_push_back(&expressions, block);
     }
 
     return block;
 }
 
+/*
+ * Make room for at least len statements in block. Code belonging to a
+ * definition is moved to a larger area in the arena, leaving the old
+ * one unused until the arena is reset.
+ */
+static void cfg_reserve(struct block *block, unsigned len)
+{
+    unsigned cap;
+    struct statement *code;
+
+    if (len > block->code.capacity) {
+        cap = block->code.capacity * 2;
+        if (cap < len) {
+            cap = len < 4 ? 4 : len;
+        }
+
+        if (block->arena) {
+            code = arena_alloc(block->arena, cap * sizeof(*code));
+            if (array_len(&block->code)) {
+                memcpy(code, block->code.data,
+                    array_len(&block->code) * sizeof(*code));
+            }
+        } else {
+            code = realloc(block->code.data, cap * sizeof(*code));
+        }
+
+        block->code.data = code;
+        block->code.capacity = cap;
+    }
+}
+
+INTERNAL void cfg_push_statement(struct block *block, struct statement st)
+{
+    cfg_reserve(block, array_len(&block->code) + 1);
+    block->code.data[block->code.length++] = st;
+}
+
+INTERNAL void cfg_append_statements(
+    struct block *block,
+    const struct block *from)
+{
+    if (array_len(&from->code)) {
+        cfg_reserve(block, array_len(&block->code) + array_len(&from->code));
+        memcpy(block->code.data + array_len(&block->code), from->code.data,
+            array_len(&from->code) * sizeof(*from->code.data));
+        block->code.length += array_len(&from->code);
+    }
+}
+
 INTERNAL struct symbol *create_label(struct definition *def)
 {
     struct symbol *label = sym_create_label();
@@ -273,8 +323,8 @@ INTERNAL void parse_finalize(void)
         array_clear(&def->params);
         array_clear(&def->locals);
         array_clear(&def->labels);
-        array_clear(&def->nodes);
         array_clear(&def->asm_statements);
+        arena_destroy(&def->arena);
         free(def);
     }
 
@@ -30,6 +30,18 @@ INTERNAL void cfg_discard(struct definition *def);
 /* Create a basic block associated with control flow graph. */
 INTERNAL struct block *cfg_block_init(struct definition *def);
 
+/*
+ * Append statements to a basic block. Blocks associated with a control
+ * flow graph store their code in memory owned by the definition, which
+ * must not be grown with the generic array functions.
+ */
+INTERNAL void cfg_push_statement(struct block *block, struct statement st);
+
+/* Append copy of all statements in another block. */
+INTERNAL void cfg_append_statements(
+    struct block *block,
+    const struct block *from);
+
 /* Free memory after all input files are processed. */
 INTERNAL void parse_finalize(void);
 
@@ -238,7 +238,7 @@ static struct block *for_statement(
     consume('(');
     switch ((tok = peek()).token) {
     case IDENTIFIER:
-        sym = sym_lookup(&ns_ident, tok.d.string);
+        sym = sym_lookup_ident(tok);
         if (!sym || sym->symtype != SYM_TYPEDEF) {
             parent = expression_statement(def, parent);
             consume(';');
@@ -659,7 +659,7 @@ INTERNAL struct block *statement(
             consume(':');
             return statement(def, parent);
         }
-        sym = sym_lookup(&ns_ident, tok.d.string);
+        sym = sym_lookup_ident(tok);
         if (sym && sym->symtype == SYM_TYPEDEF) {
             parent = declaration(def, parent);
             break;
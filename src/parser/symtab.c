@@ -5,6 +5,7 @@
 #include "symtab.h"
 #include "typetree.h"
 #include <lacc/context.h>
+#include <lacc/pch.h>
 
 #include <assert.h>
 #include <stdio.h>
@@ -24,25 +25,80 @@ INTERNAL struct namespace
 #define PREFIX_LABEL ".L"
 
 /*
- * Maintain list of symbols allocated for temporaries and labels, which
- * can be reused between function definitions.
+ * Symbols are allocated from fixed size slabs, which are reused for
+ * the next translation unit after all symbols are released at once by
+ * popping the last identifier scope.
  *
- * Calling sym_discard will push symbols back into this list.
+ * Temporaries and labels can be reused between function definitions.
+ * Calling sym_discard will push symbols onto a free list, linked
+ * through the released slot.
  */
-static array_of(struct symbol *) temporaries;
+#define SYMBOL_SLAB_SIZE 1024
+
+union symbol_slot {
+    struct symbol sym;
+    union symbol_slot *next;
+};
+
+static array_of(union symbol_slot *) slabs;
+static unsigned slab_count, slab_used;
+static union symbol_slot *free_slots;
+
+/*
+ * Numbers assigned to disambiguate scoped static variables and compiler
+ * generated symbols, increasing over all translation units. Values at
+ * the start of the current translation unit are kept in order to write
+ * the numbers used by a precompiled header.
+ */
+enum sym_counter {
+    COUNT_STATIC,
+    COUNT_TEMPORARY,
+    COUNT_UNNAMED,
+    COUNT_LABEL,
+    COUNT_CONSTANT,
+    COUNT_STRING,
+    COUNT_MAX
+};
+
+static int counters[COUNT_MAX], counters_start[COUNT_MAX];
+
+/* Counters printed with --stats. */
+static unsigned long symbols_allocated, symbols_recycled;
 
 static struct symbol *alloc_sym(void)
 {
-    struct symbol *sym;
+    union symbol_slot *slot;
 
-    if (array_len(&temporaries)) {
-        sym = array_pop_back(&temporaries);
-        memset(sym, 0, sizeof(*sym));
+    if (free_slots) {
+        slot = free_slots;
+        free_slots = slot->next;
+        symbols_recycled++;
     } else {
-        sym = calloc(1, sizeof(*sym));
+        if (!slab_count || slab_used == SYMBOL_SLAB_SIZE) {
+            if (slab_count == array_len(&slabs)) {
+                slot = malloc(SYMBOL_SLAB_SIZE * sizeof(*slot));
+                array_push_back(&slabs, slot);
+            }
+            slab_count++;
+            slab_used = 0;
+        }
+        slot = &array_get(&slabs, slab_count - 1)[slab_used++];
+        symbols_allocated++;
     }
 
-    return sym;
+    memset(&slot->sym, 0, sizeof(slot->sym));
+    return &slot->sym;
+}
+
+/*
+ * Release all symbols at end of translation unit, keeping the slabs
+ * for later use.
+ */
+static void release_symbols(void)
+{
+    slab_count = 0;
+    slab_used = 0;
+    free_slots = NULL;
 }
 
 /*
@@ -102,13 +158,17 @@ static String sym_hash_key(void *ref)
     return ((const struct symbol *) ref)->name;
 }
 
-static struct symbol *sym_lookup_function(String name)
+static void init_functions(void)
 {
     if (!functions_init) {
         hash_init(&functions, 1024, &sym_hash_key, NULL, NULL);
         functions_init = 1;
     }
+}
 
+static struct symbol *sym_lookup_function(String name)
+{
+    init_functions();
     return hash_lookup(&functions, name);
 }
 
@@ -125,57 +185,39 @@ static void symtab_reset_buffers(void)
 INTERNAL void symtab_finalize(void)
 {
     int i;
-    struct symbol *sym;
 
-    for (i = 0; i < array_len(&temporaries); ++i) {
-        sym = array_get(&temporaries, i);
-        free(sym);
+    for (i = 0; i < array_len(&slabs); ++i) {
+        free(array_get(&slabs, i));
     }
 
-    array_clear(&temporaries);
+    array_clear(&slabs);
+    release_symbols();
     array_clear(&string_types);
     if (functions_init) {
         hash_destroy(&functions);
     }
 }
 
-/*
- * Initialize hash table with initial size heuristic based on scope
- * depth. As a special case, depth 1 containing function arguments is
- * assumed to contain fewer symbols.
- */
-static unsigned current_scope_hash_cap(struct namespace *ns)
+INTERNAL void push_scope(struct namespace *ns)
 {
-    static const unsigned hash_cap[] = {256, 16, 128, 64, 32, 16};
-    static const unsigned hash_cap_default = 8;
-
-    unsigned cap;
-    assert(array_len(&ns->scope));
-    cap = hash_cap_default;
-    if (array_len(&ns->scope) < sizeof(hash_cap) / sizeof(hash_cap[0])) {
-        cap = hash_cap[array_len(&ns->scope) - 1];
+    if (ns == &ns_ident && !array_len(&ns->scope)) {
+        memcpy(counters_start, counters, sizeof(counters));
     }
 
-    return cap;
+    array_push_back(&ns->scope, array_len(&ns->bindings));
 }
 
-INTERNAL void push_scope(struct namespace *ns)
+/*
+ * Restore symbols shadowed by bindings made since the given mark, in
+ * reverse order of being made visible.
+ */
+static void unwind_bindings(struct namespace *ns, unsigned mark)
 {
-    static struct scope empty;
-    struct scope *scope;
+    struct binding b;
 
-    if (array_len(&ns->scope) < ns->max_scope_depth) {
-        assert(array_len(&ns->scope) < ns->scope.capacity);
-        array_len(&ns->scope) += 1;
-        scope = &array_get(&ns->scope, array_len(&ns->scope) - 1);
-        if (scope->state == SCOPE_INITIALIZED) {
-            scope->state = SCOPE_DIRTY;
-        }
-    } else {
-        ns->max_scope_depth += 1;
-        array_push_back(&ns->scope, empty);
-        scope = &array_get(&ns->scope, array_len(&ns->scope) - 1);
-        scope->state = SCOPE_CREATED;
+    while (array_len(&ns->bindings) > mark) {
+        b = array_pop_back(&ns->bindings);
+        *b.slot = b.shadowed;
     }
 }
 
@@ -183,38 +225,35 @@ INTERNAL void pop_scope(struct namespace *ns)
 {
     int i;
     struct symbol *sym;
-    struct scope *scope;
 
     /*
-     * Popping last scope frees the whole symbol table, including the
-     * symbols themselves. For label scope, which is per function, make
-     * sure there are no tentative definitions.
+     * Popping last scope frees the whole symbol table. Label scope is
+     * per function, so make sure there are no tentative definitions,
+     * and recycle the symbols. Tags are released together with the
+     * identifiers, which are popped last at the end of translation
+     * unit.
      */
     assert(array_len(&ns->scope) > 0);
-    if (array_len(&ns->scope) == 1) {
-        for (i = 0; i < ns->max_scope_depth; ++i) {
-            scope = &array_get(&ns->scope, i);
-            if (scope->state != SCOPE_CREATED) {
-                hash_destroy(&scope->table);
-            }
-        }
-
-        ns->max_scope_depth = 0;
+    unwind_bindings(ns, array_pop_back(&ns->scope));
+    if (!array_len(&ns->scope)) {
         array_clear(&ns->scope);
-        for (i = 0; i < array_len(&ns->symbol); ++i) {
-            sym = array_get(&ns->symbol, i);
-            if (ns == &ns_label && sym->symtype == SYM_TENTATIVE) {
-                error("Undefined label '%s'.", sym_name(sym));
+        array_clear(&ns->bindings);
+        if (ns == &ns_label) {
+            for (i = 0; i < array_len(&ns->symbol); ++i) {
+                sym = array_get(&ns->symbol, i);
+                if (sym->symtype == SYM_TENTATIVE) {
+                    error("Undefined label '%s'.", sym_name(sym));
+                }
+                sym_discard(sym);
             }
-            free(sym);
         }
 
         array_clear(&ns->symbol);
         if (ns == &ns_ident) {
+            assert(!array_len(&ns_tag.scope));
+            release_symbols();
             symtab_reset_buffers();
         }
-    } else {
-        array_len(&ns->scope) -= 1;
     }
 }
 
@@ -225,23 +264,37 @@ INTERNAL unsigned current_scope_depth(struct namespace *ns)
     return depth - 1;
 }
 
+/*
+ * Each namespace resolves names through its own slot on the interned
+ * identifier, holding the innermost visible symbol.
+ */
+static struct symbol **sym_slot(struct namespace *ns, struct ident *ident)
+{
+    if (ns == &ns_ident) {
+        return &ident->sym;
+    } else if (ns == &ns_tag) {
+        return &ident->tag;
+    }
+
+    assert(ns == &ns_label);
+    return &ident->label;
+}
+
 INTERNAL struct symbol *sym_lookup(struct namespace *ns, String name)
 {
-    int i;
-    struct scope *scope;
-    struct symbol *sym;
+    struct ident *ident;
 
-    for (i = array_len(&ns->scope) - 1; i >= 0; --i) {
-        scope = &array_get(&ns->scope, i);
-        if (scope->state == SCOPE_INITIALIZED) {
-            sym = hash_lookup(&scope->table, name);
-            if (sym) {
-                return sym;
-            }
-        }
+    ident = ident_lookup(name);
+    return ident ? *sym_slot(ns, ident) : NULL;
+}
+
+INTERNAL struct symbol *sym_lookup_ident(struct token t)
+{
+    if (t.id) {
+        return ident_get(t.id)->sym;
     }
 
-    return NULL;
+    return sym_lookup(&ns_ident, t.d.string);
 }
 
 INTERNAL const char *sym_name(const struct symbol *sym)
@@ -381,25 +434,22 @@ static struct symbol *sym_redeclare(
     return sym;
 }
 
+/*
+ * Bind symbol in current scope, unless the name is already bound to a
+ * symbol declared at this depth.
+ */
 INTERNAL void sym_make_visible(struct namespace *ns, struct symbol *sym)
 {
-    unsigned cap;
-    struct scope *scope;
+    struct ident *ident;
+    struct binding b;
 
-    scope = &array_get(&ns->scope, array_len(&ns->scope) - 1);
-    switch (scope->state) {
-    case SCOPE_CREATED:
-        cap = current_scope_hash_cap(ns);
-        hash_init(&scope->table, cap, &sym_hash_key, NULL, NULL);
-        break;
-    case SCOPE_DIRTY:
-        hash_clear(&scope->table);
-        break;
-    default: break;
+    ident = ident_get(ident_register(str_raw(sym->name), str_len(sym->name)));
+    b.slot = sym_slot(ns, ident);
+    b.shadowed = *b.slot;
+    if (!b.shadowed || b.shadowed->depth != current_scope_depth(ns)) {
+        *b.slot = sym;
+        array_push_back(&ns->bindings, b);
     }
-
-    hash_insert(&scope->table, (void *) sym);
-    scope->state = SCOPE_INITIALIZED;
 }
 
 /*
@@ -417,8 +467,6 @@ INTERNAL struct symbol *sym_add(
     enum symtype symtype,
     enum linkage linkage)
 {
-    static int n;
-
     unsigned depth;
     struct symbol *sym;
     assert(symtype != SYM_LABEL);
@@ -455,7 +503,7 @@ INTERNAL struct symbol *sym_add(
     }
 
     if (linkage == LINK_INTERN && sym->depth) {
-        sym->n = ++n;
+        sym->n = ++counters[COUNT_STATIC];
     }
 
     if (sym->symtype == SYM_TAG || sym->symtype == SYM_TYPEDEF) {
@@ -489,7 +537,6 @@ INTERNAL struct symbol *sym_add(
 
 INTERNAL struct symbol *sym_create_temporary(Type type)
 {
-    static int n;
     struct symbol *sym;
 
     sym = alloc_sym();
@@ -497,13 +544,12 @@ INTERNAL struct symbol *sym_create_temporary(Type type)
     sym->linkage = LINK_NONE;
     sym->name = str_init(PREFIX_TEMPORARY);
     sym->type = type;
-    sym->n = ++n;
+    sym->n = ++counters[COUNT_TEMPORARY];
     return sym;
 }
 
 INTERNAL struct symbol *sym_create_unnamed(Type type)
 {
-    static int n;
     struct symbol *sym;
 
     sym = alloc_sym();
@@ -516,13 +562,12 @@ INTERNAL struct symbol *sym_create_unnamed(Type type)
     sym->symtype = SYM_DEFINITION;
     sym->name = str_init(PREFIX_UNNAMED);
     sym->type = type;
-    sym->n = ++n;
+    sym->n = ++counters[COUNT_UNNAMED];
     return sym;
 }
 
 INTERNAL struct symbol *sym_create_label(void)
 {
-    static int n;
     struct symbol *sym;
 
     sym = alloc_sym();
@@ -530,13 +575,12 @@ INTERNAL struct symbol *sym_create_label(void)
     sym->symtype = SYM_LABEL;
     sym->linkage = LINK_INTERN;
     sym->name = str_init(PREFIX_LABEL);
-    sym->n = ++n;
+    sym->n = ++counters[COUNT_LABEL];
     return sym;
 }
 
 INTERNAL struct symbol *sym_create_constant(Type type, union value val)
 {
-    static int n;
     struct symbol *sym;
 
     sym = alloc_sym();
@@ -545,7 +589,7 @@ INTERNAL struct symbol *sym_create_constant(Type type, union value val)
     sym->symtype = SYM_CONSTANT;
     sym->linkage = LINK_INTERN;
     sym->name = str_init(PREFIX_CONSTANT);
-    sym->n = ++n;
+    sym->n = ++counters[COUNT_CONSTANT];
     array_push_back(&ns_ident.symbol, sym);
     return sym;
 }
@@ -557,23 +601,26 @@ INTERNAL struct symbol *sym_create_constant(Type type, union value val)
  */
 INTERNAL struct symbol *sym_create_string(String str)
 {
-    static int n;
     struct symbol *sym;
 
     sym = alloc_sym();
-    sym->type = get_string_type(str.len + 1);
+    sym->type = get_string_type(str_len(str) + 1);
     sym->value.string = str;
     sym->symtype = SYM_LITERAL;
     sym->linkage = LINK_INTERN;
     sym->name = str_init(PREFIX_STRING);
-    sym->n = ++n;
+    sym->n = ++counters[COUNT_STRING];
     array_push_back(&ns_ident.symbol, sym);
     return sym;
 }
 
 INTERNAL void sym_discard(struct symbol *sym)
 {
-    array_push_back(&temporaries, sym);
+    union symbol_slot *slot;
+
+    slot = (union symbol_slot *) sym;
+    slot->next = free_slots;
+    free_slots = slot;
 }
 
 INTERNAL int is_temporary(const struct symbol *sym)
@@ -606,6 +653,240 @@ INTERNAL const struct symbol *yield_declaration(struct namespace *ns)
     return NULL;
 }
 
+/*
+ * Symbols are written to precompiled header with references replaced by
+ * index, numbering identifiers before tags. The index is looked up from
+ * the position of each symbol in the slabs.
+ */
+static long *pch_index;
+
+static long sym_ordinal(const struct symbol *sym)
+{
+    int i;
+    const union symbol_slot *slab, *slot;
+
+    slot = (const union symbol_slot *) sym;
+    for (i = 0; i < slab_count; ++i) {
+        slab = array_get(&slabs, i);
+        if (slot >= slab && slot < slab + SYMBOL_SLAB_SIZE) {
+            return (long) i * SYMBOL_SLAB_SIZE + (slot - slab);
+        }
+    }
+
+    return -1;
+}
+
+static long sym_pch_index(const struct symbol *sym)
+{
+    long i;
+
+    i = sym_ordinal(sym);
+    return (i < 0) ? -1 : pch_index[i];
+}
+
+static void index_symbols(void)
+{
+    int i, n;
+    long len;
+
+    len = (long) slab_count * SYMBOL_SLAB_SIZE;
+    pch_index = malloc(len * sizeof(*pch_index));
+    for (i = 0; i < len; ++i) {
+        pch_index[i] = -1;
+    }
+
+    n = array_len(&ns_ident.symbol);
+    for (i = 0; i < n; ++i) {
+        pch_index[sym_ordinal(array_get(&ns_ident.symbol, i))] = i;
+    }
+
+    for (i = 0; i < array_len(&ns_tag.symbol); ++i) {
+        pch_index[sym_ordinal(array_get(&ns_tag.symbol, i))] = n + i;
+    }
+}
+
+static struct symbol *pch_symbol(long i)
+{
+    long n;
+
+    n = array_len(&ns_ident.symbol);
+    if (i < 0 || i >= n + array_len(&ns_tag.symbol)) {
+        error("Invalid symbol in precompiled header.");
+        exit(1);
+    }
+
+    return (i < n)
+        ? array_get(&ns_ident.symbol, i)
+        : array_get(&ns_tag.symbol, i - n);
+}
+
+INTERNAL int can_write_declarations(void)
+{
+    int i, is_valid;
+    const struct symbol *sym;
+
+    for (i = 0; i < array_len(&ns_ident.symbol); ++i) {
+        sym = array_get(&ns_ident.symbol, i);
+        switch (sym->symtype) {
+        case SYM_DEFINITION:
+            if (sym->depth) {
+                break;
+            }
+        case SYM_TENTATIVE:
+        case SYM_LITERAL:
+            return 0;
+        default:
+            break;
+        }
+    }
+
+    index_symbols();
+    is_valid = write_types(NULL, &sym_pch_index);
+    free(pch_index);
+    pch_index = NULL;
+    return is_valid;
+}
+
+/*
+ * Fields assigned by optimizer and back-end are not written, as there
+ * is no code generated for declarations.
+ */
+static void write_symbol(FILE *stream, const struct symbol *sym)
+{
+    pch_write_string(stream, sym->name);
+    pch_write_type(stream, sym->type);
+    pch_write_int(stream, sym->symtype);
+    pch_write_int(stream, sym->linkage);
+    pch_write_int(stream,
+        sym->referenced | (sym->memory << 1) | (sym->inlined << 2));
+    pch_write_int(stream, sym->n);
+    pch_write_int(stream, sym->depth);
+    if (sym->symtype == SYM_CONSTANT) {
+        pch_write_value(stream, sym->value.constant);
+    }
+}
+
+static struct symbol *read_symbol(FILE *stream)
+{
+    long flags;
+    struct symbol *sym;
+
+    sym = alloc_sym();
+    sym->name = pch_read_string(stream);
+    sym->type = pch_read_type(stream);
+    sym->symtype = pch_read_int(stream);
+    sym->linkage = pch_read_int(stream);
+    flags = pch_read_int(stream);
+    sym->referenced = flags & 1;
+    sym->memory = (flags >> 1) & 1;
+    sym->inlined = (flags >> 2) & 1;
+    sym->n = pch_read_int(stream);
+    sym->depth = pch_read_int(stream);
+    if (sym->symtype == SYM_CONSTANT) {
+        sym->value.constant = pch_read_value(stream);
+    }
+
+    return sym;
+}
+
+/*
+ * Only the file scope is open when writing, and bindings are restored
+ * by setting the slot of each name to the symbol currently visible.
+ */
+static void write_bindings(FILE *stream, struct namespace *ns)
+{
+    int i;
+    struct binding b;
+
+    assert(array_len(&ns->scope) == 1);
+    pch_write_int(stream, array_len(&ns->bindings));
+    for (i = 0; i < array_len(&ns->bindings); ++i) {
+        b = array_get(&ns->bindings, i);
+        pch_write_int(stream, sym_pch_index(*b.slot));
+        pch_write_int(stream, b.shadowed ? sym_pch_index(b.shadowed) : -1);
+    }
+}
+
+static void read_bindings(FILE *stream, struct namespace *ns)
+{
+    long i, n, index;
+    struct ident *ident;
+    struct symbol *sym;
+    struct binding b;
+
+    n = pch_read_int(stream);
+    for (i = 0; i < n; ++i) {
+        sym = pch_symbol(pch_read_int(stream));
+        index = pch_read_int(stream);
+        ident = ident_get(
+            ident_register(str_raw(sym->name), str_len(sym->name)));
+        b.slot = sym_slot(ns, ident);
+        b.shadowed = (index < 0) ? NULL : pch_symbol(index);
+        *b.slot = sym;
+        array_push_back(&ns->bindings, b);
+    }
+}
+
+INTERNAL void write_declarations(FILE *stream)
+{
+    int i;
+
+    index_symbols();
+    pch_write_int(stream, array_len(&ns_ident.symbol));
+    pch_write_int(stream, array_len(&ns_tag.symbol));
+    for (i = 0; i < array_len(&ns_ident.symbol); ++i) {
+        write_symbol(stream, array_get(&ns_ident.symbol, i));
+    }
+
+    for (i = 0; i < array_len(&ns_tag.symbol); ++i) {
+        write_symbol(stream, array_get(&ns_tag.symbol, i));
+    }
+
+    write_types(stream, &sym_pch_index);
+    write_bindings(stream, &ns_ident);
+    write_bindings(stream, &ns_tag);
+    for (i = 0; i < COUNT_MAX; ++i) {
+        pch_write_int(stream, counters[i] - counters_start[i]);
+    }
+
+    free(pch_index);
+    pch_index = NULL;
+}
+
+INTERNAL void read_declarations(FILE *stream)
+{
+    long i, n, m;
+    struct symbol *sym;
+
+    assert(!array_len(&ns_ident.symbol));
+    assert(!array_len(&ns_tag.symbol));
+    init_functions();
+    n = pch_read_int(stream);
+    m = pch_read_int(stream);
+    for (i = 0; i < n; ++i) {
+        sym = read_symbol(stream);
+        array_push_back(&ns_ident.symbol, sym);
+        if (sym->symtype != SYM_TYPEDEF && is_function(sym->type)) {
+            hash_insert(&functions, sym);
+        }
+        if (!decl_memcpy && !str_cmp(str_init("memcpy"), sym->name)) {
+            decl_memcpy = sym;
+        }
+    }
+
+    for (i = 0; i < m; ++i) {
+        sym = read_symbol(stream);
+        array_push_back(&ns_tag.symbol, sym);
+    }
+
+    read_types(stream, &pch_symbol);
+    read_bindings(stream, &ns_ident);
+    read_bindings(stream, &ns_tag);
+    for (i = 0; i < COUNT_MAX; ++i) {
+        counters[i] += pch_read_int(stream);
+    }
+}
+
 static void print_symbol(FILE *stream, const struct symbol *sym)
 {
     fprintf(stream, "%*s", sym->depth * 2, "");
@@ -693,3 +974,9 @@ INTERNAL void output_symbols(FILE *stream, struct namespace *ns)
         fprintf(stream, "\n");
     }
 }
+
+INTERNAL void output_symbol_stats(FILE *stream)
+{
+    fprintf(stream, "Symbols: %lu allocated, %lu recycled, %u slabs.\n",
+        symbols_allocated, symbols_recycled, array_len(&slabs));
+}
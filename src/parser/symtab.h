@@ -6,15 +6,13 @@
 #include <lacc/symbol.h>
 
 /*
- * Delay initializing a new scope until new symbols are added.
+ * Symbol made visible in a namespace, replacing the previous innermost
+ * symbol cached on the interned identifier. Restored when the scope is
+ * popped.
  */
-struct scope {
-    struct hash_table table;
-    enum {
-        SCOPE_CREATED,      /* Pending hash_init. */
-        SCOPE_DIRTY,        /* Pending hash_clear. */
-        SCOPE_INITIALIZED   /* In use, containing symbols. */
-    } state;
+struct binding {
+    struct symbol **slot;
+    struct symbol *shadowed;
 };
 
 /*
@@ -35,13 +33,14 @@ struct namespace {
     array_of(struct symbol *) symbol;
 
     /*
-     * Use hash table per scope, storing pointers to symbols in the
-     * namespace symbol list.
+     * Bindings made in all scopes currently pushed, innermost last.
+     * Each name resolves through a single slot on its interned
+     * identifier, and the bindings form a stack of shadowed symbols.
      */
-    array_of(struct scope) scope;
+    array_of(struct binding) bindings;
 
-    /* Maximum number of scopes pushed. */
-    int max_scope_depth;
+    /* Number of bindings preceding each scope pushed. */
+    array_of(unsigned) scope;
 
     /* Iterator for successive calls to yield. */
     int cursor;
@@ -71,6 +70,12 @@ INTERNAL unsigned current_scope_depth(struct namespace *ns);
  */
 INTERNAL struct symbol *sym_lookup(struct namespace *ns, String name);
 
+/*
+ * Retrieve symbol in identifier namespace visible from current scope,
+ * using interned identifier of the token if available.
+ */
+INTERNAL struct symbol *sym_lookup_ident(struct token t);
+
 /*
  * Add symbol to current scope, or resolve to or complete existing
  * symbols when they occur repeatedly.
@@ -112,9 +117,29 @@ INTERNAL void sym_discard(struct symbol *sym);
  */
 INTERNAL const struct symbol *yield_declaration(struct namespace *ns);
 
+/*
+ * Determine whether the identifier and tag namespaces hold only
+ * declarations, which can be written to a precompiled header in place
+ * of tokens. Definitions and string literals must be parsed again for
+ * each translation unit.
+ */
+INTERNAL int can_write_declarations(void);
+
+/* Write symbols and types declared at file scope. */
+INTERNAL void write_declarations(FILE *stream);
+
+/*
+ * Read declarations from precompiled header, replacing the symbols and
+ * types otherwise registered when starting a translation unit.
+ */
+INTERNAL void read_declarations(FILE *stream);
+
 /* Verbose output all symbols from symbol table. */
 INTERNAL void output_symbols(FILE *stream, struct namespace *ns);
 
+/* Print number of symbols allocated and recycled, for --stats. */
+INTERNAL void output_symbol_stats(FILE *stream);
+
 /* Free memory after all input files are processed. */
 INTERNAL void symtab_finalize(void);
 
@@ -5,6 +5,8 @@
 #include "typetree.h"
 #include <lacc/array.h>
 #include <lacc/context.h>
+#include <lacc/hash.h>
+#include <lacc/pch.h>
 #include <lacc/symbol.h>
 
 #include <assert.h>
@@ -44,6 +46,17 @@ struct typetree {
     unsigned int is_vla : 1;
     unsigned int is_incomplete : 1;
 
+    /* Set for struct and union types when all members are added. */
+    unsigned int is_sealed : 1;
+
+    /*
+     * Set for interned pointer and array types without qualifiers, where
+     * the next type is also canonical, meaning built only from basic
+     * types and other canonical types. Two canonical types are equal
+     * only if they have the same reference.
+     */
+    unsigned int is_canonical : 1;
+
     /*
      * Total storage size in bytes for struct, union and basic types,
      * equal to what is returned for sizeof. Number of elements in case
@@ -66,6 +79,13 @@ struct typetree {
     /* Function parameters, or struct/union members. */
     array_of(struct member) members;
 
+    /*
+     * Index of members by name, built on first lookup in sealed struct
+     * and union types with many members. Anonymous members are already
+     * flattened into the list, and included the same way.
+     */
+    struct hash_table *member_index;
+
     /*
      * Function return value, pointer target, array base, or pointer to
      * tagged struct or union type. Tag indirections are used to avoid
@@ -82,10 +102,20 @@ struct typetree {
 
 /*
  * All types have a number, indexing into a global list. This list only
- * grows.
+ * grows, up to the largest reference that fits in Type.
  */
 static array_of(struct typetree) types;
 
+#define TYPE_REF_MAX ((1u << 19) - 1)
+
+/*
+ * Pointer and array types are interned, such that identical types share
+ * a single entry. Open addressing table of references to types, hashed
+ * on kind, qualifiers, size and next type. Empty slots are zero.
+ */
+static unsigned *interned_types;
+static unsigned interned_capacity, interned_count;
+
 static struct typetree *get_typetree_handle(int ref)
 {
     assert(ref > 0);
@@ -134,18 +164,120 @@ static Type get_type_handle(int ref)
     return type;
 }
 
-INTERNAL Type type_create(enum type tt)
+static Type push_typetree(struct typetree t)
 {
     Type type = {0};
-    struct typetree t = {0};
 
-    t.type = tt;
+    if (array_len(&types) == TYPE_REF_MAX) {
+        error("Too many types, limit is %u.", TYPE_REF_MAX);
+        exit(1);
+    }
+
     array_push_back(&types, t);
-    type.type = tt;
+    type.type = t.type;
     type.ref = array_len(&types);
     return type;
 }
 
+INTERNAL Type type_create(enum type tt)
+{
+    struct typetree t = {0};
+
+    t.type = tt;
+    return push_typetree(t);
+}
+
+static int is_canonical(Type type)
+{
+    return type.ref == 0 || get_typetree_handle(type.ref)->is_canonical;
+}
+
+static int is_qualified(Type type)
+{
+    return type.is_const || type.is_volatile || type.is_restrict
+        || type.is_pointer_const
+        || type.is_pointer_volatile
+        || type.is_pointer_restrict;
+}
+
+static unsigned long typetree_hash(const struct typetree *t)
+{
+    unsigned long h, next;
+
+    next = 0;
+    memcpy(&next, &t->next, sizeof(t->next));
+    h = t->type | (t->is_const << 4) | (t->is_volatile << 5);
+    h = (h ^ next) * 0x100000001b3ul;
+    h = (h ^ t->size) * 0x9e3779b97f4a7c15ul;
+    return h ^ (h >> 29);
+}
+
+static int is_same_derived(const struct typetree *a, const struct typetree *b)
+{
+    return a->type == b->type
+        && a->size == b->size
+        && a->is_const == b->is_const
+        && a->is_volatile == b->is_volatile
+        && !memcmp(&a->next, &b->next, sizeof(a->next));
+}
+
+static void grow_interned_types(void)
+{
+    unsigned i, j, ref, mask, *prev, capacity;
+
+    prev = interned_types;
+    capacity = interned_capacity;
+    interned_capacity = capacity ? capacity * 2 : 256;
+    interned_types = calloc(interned_capacity, sizeof(*interned_types));
+    mask = interned_capacity - 1;
+    for (i = 0; i < capacity; ++i) {
+        ref = prev[i];
+        if (ref) {
+            j = typetree_hash(get_typetree_handle(ref)) & mask;
+            while (interned_types[j]) {
+                j = (j + 1) & mask;
+            }
+            interned_types[j] = ref;
+        }
+    }
+
+    free(prev);
+}
+
+/*
+ * Return existing pointer or array type matching the given structure,
+ * or add a new one. These are never modified after creation.
+ */
+static Type intern_typetree(struct typetree t)
+{
+    unsigned i, ref, mask;
+    Type type = {0};
+
+    if (interned_count + 1 > interned_capacity / 4 * 3) {
+        grow_interned_types();
+    }
+
+    mask = interned_capacity - 1;
+    i = typetree_hash(&t) & mask;
+    while ((ref = interned_types[i]) != 0) {
+        if (is_same_derived(get_typetree_handle(ref), &t)) {
+            type.type = t.type;
+            type.ref = ref;
+            return type;
+        }
+        i = (i + 1) & mask;
+    }
+
+    t.is_canonical = !t.is_const
+        && !t.is_volatile
+        && !is_qualified(t.next)
+        && is_canonical(t.next);
+    type = push_typetree(t);
+    interned_types[i] = type.ref;
+    interned_count++;
+    return type;
+}
+
 INTERNAL void clear_types(FILE *stream)
 {
     int i;
@@ -163,9 +295,17 @@ INTERNAL void clear_types(FILE *stream)
     for (i = 0; i < array_len(&types); ++i) {
         t = &array_get(&types, i);
         array_clear(&t->members);
+        if (t->member_index) {
+            hash_destroy(t->member_index);
+            free(t->member_index);
+        }
     }
 
     array_clear(&types);
+    free(interned_types);
+    interned_types = NULL;
+    interned_capacity = 0;
+    interned_count = 0;
 }
 
 INTERNAL int is_type_placeholder(Type type)
@@ -373,16 +513,16 @@ static size_t adjust_member_alignment(Type parent, Type type)
 INTERNAL Type type_create_pointer(Type next)
 {
     Type type;
-    struct typetree *t;
+    struct typetree t = {0};
 
     if (next.is_pointer) {
-        type = type_create(T_POINTER);
-        t = get_typetree_handle(type.ref);
-        t->is_const = is_const(next);
-        t->is_volatile = is_volatile(next);
+        t.type = T_POINTER;
+        t.is_const = is_const(next);
+        t.is_volatile = is_volatile(next);
         next = remove_qualifiers(next);
         next.is_pointer = 0;
-        t->next = next;
+        t.next = next;
+        type = intern_typetree(t);
     } else {
         type = next;
         type.is_pointer = 1;
@@ -403,21 +543,23 @@ INTERNAL Type type_create_function(Type next)
     return type;
 }
 
-INTERNAL Type type_create_array(Type next, size_t count)
+static void check_array_size(Type next, size_t count)
 {
-    Type type;
-    struct typetree *t;
-
     if (count * size_of(next) > LONG_MAX) {
         error("Array is too large (%lu elements).", count);
         exit(1);
     }
+}
 
-    type = type_create(T_ARRAY);
-    t = get_typetree_handle(type.ref);
-    t->size = count;
-    t->next = next;
-    return type;
+INTERNAL Type type_create_array(Type next, size_t count)
+{
+    struct typetree t = {0};
+
+    check_array_size(next, count);
+    t.type = T_ARRAY;
+    t.size = count;
+    t.next = next;
+    return intern_typetree(t);
 }
 
 INTERNAL Type type_create_incomplete(Type next)
@@ -438,8 +580,9 @@ INTERNAL Type type_create_vla(Type next, const struct symbol *count)
     struct typetree *t;
 
     assert(count);
-    type = type_create_array(next, 0);
+    type = type_create(T_ARRAY);
     t = get_typetree_handle(type.ref);
+    t->next = next;
     t->vlen = count;
     t->is_vla = 1;
     return type;
@@ -510,8 +653,14 @@ INTERNAL Type type_patch_declarator(Type head, Type target)
         } else {
             assert(is_function(head) || is_array(head));
             t = get_typetree_handle(head.ref);
-            t->next = type_patch_declarator(t->next, target);
-            next = head;
+            next = type_patch_declarator(t->next, target);
+            t = get_typetree_handle(head.ref);
+            if (t->type == T_ARRAY && !t->is_vla && !t->is_incomplete) {
+                next = type_create_array(next, t->size);
+            } else {
+                t->next = next;
+                next = head;
+            }
         }
     }
 
@@ -791,9 +940,35 @@ static size_t remove_anonymous_fields(struct typetree *t)
     return maxalign;
 }
 
+/*
+ * Lookup by name scans the member list, until there are enough members
+ * to make an index worthwhile. Can be overridden to compare against a
+ * build without the index, as done by make bench-members.
+ */
+#ifndef MEMBER_INDEX_MIN
+# define MEMBER_INDEX_MIN 16
+#endif
+
+static String member_hash_key(void *ref)
+{
+    return ((struct member *) ref)->name;
+}
+
+static void build_member_index(struct typetree *t)
+{
+    int i, len;
+
+    len = array_len(&t->members);
+    t->member_index = calloc(1, sizeof(*t->member_index));
+    hash_init(t->member_index, len * 2, &member_hash_key, NULL, NULL);
+    for (i = 0; i < len; ++i) {
+        hash_insert(t->member_index, &array_get(&t->members, i));
+    }
+}
+
 /*
  * Adjust aggregate type size to be a multiple of strongest member
- * alignment.
+ * alignment, and mark the member list as final.
  *
  * This function should only be called only once all members have been
  * added.
@@ -818,6 +993,8 @@ INTERNAL void type_seal(Type type)
         if (t->size % align) {
             t->size += align - (t->size % align);
         }
+
+        t->is_sealed = 1;
     }
 }
 
@@ -933,6 +1110,12 @@ INTERNAL int type_equal(Type a, Type b)
     if ((a.ref == 0) != (b.ref == 0))
         return 0;
 
+    if (a.ref == b.ref)
+        return 1;
+
+    if (is_canonical(a) && is_canonical(b))
+        return 0;
+
     if (a.ref != 0 && b.ref != 0) {
         ta = get_typetree_handle(a.ref);
         tb = get_typetree_handle(b.ref);
@@ -1128,6 +1311,20 @@ INTERNAL const struct member *find_type_member(
 
     assert(is_struct_or_union(type) || is_function(type));
     t = get_typetree_handle(type.ref);
+    if (!t->member_index && t->is_sealed
+        && array_len(&t->members) >= MEMBER_INDEX_MIN)
+    {
+        build_member_index(t);
+    }
+
+    if (t->member_index) {
+        member = hash_lookup(t->member_index, name);
+        if (index) {
+            *index = member ? member - t->members.data : -1;
+        }
+        return member;
+    }
+
     for (i = 0; i < array_len(&t->members); ++i) {
         member = &array_get(&t->members, i);
         if (!str_cmp(name, member->name)) {
@@ -1270,3 +1467,149 @@ INTERNAL int fprinttype(FILE *stream, Type type, const struct symbol *expand)
 
     return n;
 }
+
+/*
+ * Qualifiers and other flags are packed in a single value. The index of
+ * members is not stored, and is built again on first lookup.
+ */
+
+static long pack_typetree_flags(const struct typetree *t)
+{
+    return t->is_unsigned
+        | (t->is_const << 1)
+        | (t->is_volatile << 2)
+        | (t->is_restrict << 3)
+        | (t->is_vararg << 4)
+        | (t->is_flexible << 5)
+        | (t->is_vla << 6)
+        | (t->is_incomplete << 7)
+        | (t->is_canonical << 8)
+        | (t->is_sealed << 9);
+}
+
+static void unpack_typetree_flags(struct typetree *t, long flags)
+{
+    t->is_unsigned = flags & 1;
+    t->is_const = (flags >> 1) & 1;
+    t->is_volatile = (flags >> 2) & 1;
+    t->is_restrict = (flags >> 3) & 1;
+    t->is_vararg = (flags >> 4) & 1;
+    t->is_flexible = (flags >> 5) & 1;
+    t->is_vla = (flags >> 6) & 1;
+    t->is_incomplete = (flags >> 7) & 1;
+    t->is_canonical = (flags >> 8) & 1;
+    t->is_sealed = (flags >> 9) & 1;
+}
+
+/*
+ * Types are written in order of reference, such that Type values stored
+ * in symbols and other types stay valid. Interned types are written as
+ * occupied slots of the table, which is restored without hashing.
+ */
+INTERNAL int write_types(
+    FILE *stream,
+    long (*sym_index)(const struct symbol *))
+{
+    int i, j;
+    const struct typetree *t;
+    const struct member *m;
+
+    for (i = 0; i < array_len(&types); ++i) {
+        t = &array_get(&types, i);
+        if (t->vlen || (t->tag && sym_index(t->tag) < 0)) {
+            return 0;
+        }
+        for (j = 0; j < array_len(&t->members); ++j) {
+            m = &array_get(&t->members, j);
+            if (m->sym && sym_index(m->sym) < 0) {
+                return 0;
+            }
+        }
+    }
+
+    if (!stream) {
+        return 1;
+    }
+
+    pch_write_int(stream, array_len(&types));
+    for (i = 0; i < array_len(&types); ++i) {
+        t = &array_get(&types, i);
+        pch_write_int(stream, t->type);
+        pch_write_int(stream, pack_typetree_flags(t));
+        pch_write_int(stream, t->size);
+        pch_write_type(stream, t->next);
+        pch_write_int(stream, t->tag ? sym_index(t->tag) : -1);
+        pch_write_int(stream, array_len(&t->members));
+        for (j = 0; j < array_len(&t->members); ++j) {
+            m = &array_get(&t->members, j);
+            pch_write_string(stream, m->name);
+            pch_write_type(stream, m->type);
+            pch_write_int(stream, m->offset);
+            pch_write_int(stream, m->field_width);
+            pch_write_int(stream, m->field_offset);
+            pch_write_int(stream, m->field_backing);
+            pch_write_int(stream, m->sym ? sym_index(m->sym) : -1);
+        }
+    }
+
+    pch_write_int(stream, interned_capacity);
+    pch_write_int(stream, interned_count);
+    for (i = 0; i < interned_capacity; ++i) {
+        if (interned_types[i]) {
+            pch_write_int(stream, i);
+            pch_write_int(stream, interned_types[i]);
+        }
+    }
+
+    return 1;
+}
+
+INTERNAL void read_types(FILE *stream, struct symbol *(*sym_get)(long))
+{
+    long i, j, n, len, flags, index;
+    struct typetree t;
+    struct member m;
+
+    assert(!array_len(&types));
+    assert(!interned_types);
+    n = pch_read_int(stream);
+    array_realloc(&types, n);
+    for (i = 0; i < n; ++i) {
+        memset(&t, 0, sizeof(t));
+        t.type = pch_read_int(stream);
+        flags = pch_read_int(stream);
+        unpack_typetree_flags(&t, flags);
+        t.size = pch_read_int(stream);
+        t.next = pch_read_type(stream);
+        index = pch_read_int(stream);
+        t.tag = (index < 0) ? NULL : sym_get(index);
+        len = pch_read_int(stream);
+        for (j = 0; j < len; ++j) {
+            m.name = pch_read_string(stream);
+            m.type = pch_read_type(stream);
+            m.offset = pch_read_int(stream);
+            m.field_width = pch_read_int(stream);
+            m.field_offset = pch_read_int(stream);
+            m.field_backing = pch_read_int(stream);
+            index = pch_read_int(stream);
+            m.sym = (index < 0) ? NULL : sym_get(index);
+            array_push_back(&t.members, m);
+        }
+
+        array_push_back(&types, t);
+    }
+
+    interned_capacity = pch_read_int(stream);
+    interned_count = pch_read_int(stream);
+    if (interned_capacity) {
+        interned_types = calloc(interned_capacity, sizeof(*interned_types));
+        for (i = 0; i < interned_count; ++i) {
+            j = pch_read_int(stream);
+            if (j < 0 || j >= interned_capacity) {
+                error("Invalid type in precompiled header.");
+                exit(1);
+            }
+            interned_types[j] = pch_read_int(stream);
+        }
+    }
+}
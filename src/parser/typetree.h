@@ -19,6 +19,22 @@
  */
 INTERNAL void clear_types(FILE *stream);
 
+/*
+ * Write all types to precompiled header, referring to tag and parameter
+ * symbols by index. With stream NULL, only check that every symbol
+ * referenced has an index, and that no array length is bound to a
+ * symbol. Return 0 if the types cannot be written.
+ */
+INTERNAL int write_types(
+    FILE *stream,
+    long (*sym_index)(const struct symbol *));
+
+/*
+ * Read types from precompiled header, at start of translation unit
+ * before any other type is created.
+ */
+INTERNAL void read_types(FILE *stream, struct symbol *(*sym_get)(long));
+
 /* Initialize array, pointer, function, struct or union type. */
 INTERNAL Type type_create(enum type);
 INTERNAL Type type_create_pointer(Type next);
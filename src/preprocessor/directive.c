@@ -12,7 +12,7 @@
 
 #include <assert.h>
 
-#define IDENT(s) {IDENTIFIER, 0, 1, 0, {0}, {SHORT_STRING_INIT(s)}}
+#define IDENT(s) {IDENTIFIER, 0, 1, 0, {0}, 0, {SHORT_STRING_INIT(s)}}
 
 INTERNAL struct token
     ident__include = IDENT("include"),
@@ -27,6 +27,7 @@ INTERNAL struct token
     ident__line = IDENT("line"),
     ident__pragma = IDENT("pragma"),
     ident__Pragma = IDENT("_" "Pragma"),
+    ident__once = IDENT("once"),
     ident__VA_ARGS__ = IDENT("__VA_ARGS__");
 
 enum state {
@@ -92,6 +93,114 @@ INTERNAL int in_active_block(void)
     return s == BRANCH_LIVE;
 }
 
+/*
+ * Multiple-include optimization. Detect files where all content is
+ * wrapped in a single #ifndef directive, like the following:
+ *
+ *     #ifndef FOO_H
+ *     #define FOO_H
+ *     ...
+ *     #endif
+ *
+ * Including such a file again has no effect as long as FOO_H is still
+ * defined, and the input module can skip opening it.
+ */
+struct include_guard {
+    enum {
+        GUARD_START,    /* Nothing read yet. */
+        GUARD_OPEN,     /* Inside top level #ifndef. */
+        GUARD_CLOSED,   /* After matching #endif. */
+        GUARD_NONE      /* Content found outside of guard. */
+    } state;
+
+    /* Branch stack depth at start of file. */
+    unsigned depth;
+
+    /* Macro name from #ifndef. */
+    String name;
+};
+
+/* Guard state of each file in the include stack. */
+static array_of(struct include_guard) guard_stack;
+
+INTERNAL void include_guard_push(void)
+{
+    struct include_guard guard = {0};
+
+    guard.state = GUARD_START;
+    guard.depth = array_len(&branch_stack);
+    array_push_back(&guard_stack, guard);
+}
+
+INTERNAL String include_guard_pop(void)
+{
+    String name = {0};
+    struct include_guard guard;
+
+    assert(array_len(&guard_stack));
+    guard = array_pop_back(&guard_stack);
+    if (!array_len(&guard_stack)) {
+        array_clear(&guard_stack);
+    }
+
+    if (guard.state == GUARD_CLOSED) {
+        name = guard.name;
+    }
+
+    return name;
+}
+
+INTERNAL void include_guard_invalidate(void)
+{
+    struct include_guard *guard;
+
+    if (array_len(&guard_stack)) {
+        guard = &array_back(&guard_stack);
+        if (array_len(&branch_stack) <= guard->depth) {
+            guard->state = GUARD_NONE;
+        }
+    }
+}
+
+/*
+ * Update include guard state of current file, before evaluating the
+ * directive. Only directives at the top level of the file, or closing
+ * the top level #ifndef, are relevant.
+ */
+static void update_include_guard(const struct token *line)
+{
+    unsigned depth;
+    struct include_guard *guard;
+
+    if (!array_len(&guard_stack)) {
+        return;
+    }
+
+    guard = &array_back(&guard_stack);
+    depth = array_len(&branch_stack);
+    if (guard->state == GUARD_NONE || depth > guard->depth + 1) {
+        return;
+    }
+
+    if (depth <= guard->depth) {
+        if (depth == guard->depth
+            && guard->state == GUARD_START
+            && !tok_cmp(*line, ident__ifndef)
+            && line[1].is_expandable)
+        {
+            guard->state = GUARD_OPEN;
+            guard->name = line[1].d.string;
+        } else {
+            guard->state = GUARD_NONE;
+        }
+    } else if (line->token == ELSE || !tok_cmp(*line, ident__elif)) {
+        guard->state = GUARD_NONE;
+    } else if (!tok_cmp(*line, ident__endif)) {
+        assert(guard->state == GUARD_OPEN);
+        guard->state = GUARD_CLOSED;
+    }
+}
+
 static void expect(const struct token *list, int token)
 {
     String a, b;
@@ -146,7 +255,7 @@ static struct number preprocess_primary(
             exit(1);
         }
     case IDENTIFIER:
-        assert(!macro_definition(list->d.string));
+        assert(!macro_definition_of(*list));
         num.type = basic_type__long;
         num.val.i = 0;
         break;
@@ -681,8 +790,10 @@ static struct macro preprocess_define(
  *     #line 42 "foo.c"
  *
  * Update line number, and optionally name, of file being processed.
+ * Line markers in preprocessed output, like # 42 "foo.c" 1, are handled
+ * the same way, ignoring any flags following the file name.
  */
-static void preprocess_line_directive(const struct token *line)
+static void preprocess_line_directive(const struct token *line, int marker)
 {
     struct token t;
 
@@ -691,7 +802,7 @@ static void preprocess_line_directive(const struct token *line)
         t = convert_preprocessing_number(t);
     }
 
-    if (t.token != NUMBER || !is_int(t.type) || t.d.val.i <= 0) {
+    if (t.token != NUMBER || !is_int(t.type) || t.d.val.i < !marker) {
         error("Expected positive integer in #line directive.");
         exit(1);
     }
@@ -700,6 +811,9 @@ static void preprocess_line_directive(const struct token *line)
     if (line->token == PREP_STRING) {
         current_file_path = line->d.string;
         line++;
+        while (marker && line->token == PREP_NUMBER) {
+            line++;
+        }
     }
 
     if (line->token != NEWLINE) {
@@ -716,6 +830,8 @@ INTERNAL void preprocess_directive(TokenArray *array)
     String s;
     const struct token *line = array->data;
 
+    update_include_guard(line);
+
     /*
      * Perform macro expansion only for if, elif and line directives,
      * before doing any expression parsing.
@@ -769,7 +885,7 @@ INTERNAL void preprocess_directive(TokenArray *array)
                 error("Expected identifier in 'ifndef' clause.");
                 exit(1);
             }
-            def = macro_definition(line->d.string) == NULL;
+            def = macro_definition_of(*line) == NULL;
             push_state(def ? BRANCH_LIVE : BRANCH_DEAD);
         } else {
             push_state(BRANCH_DISABLED);
@@ -781,7 +897,7 @@ INTERNAL void preprocess_directive(TokenArray *array)
                 error("Expected identifier in 'ifdef' clause.");
                 exit(1);
             }
-            def = macro_definition(line->d.string) != NULL;
+            def = macro_definition_of(*line) != NULL;
             push_state(def ? BRANCH_LIVE : BRANCH_DEAD);
         } else {
             push_state(BRANCH_DISABLED);
@@ -799,7 +915,9 @@ INTERNAL void preprocess_directive(TokenArray *array)
         } else if (!tok_cmp(*line, ident__include)) {
             preprocess_include(array);
         } else if (!tok_cmp(*line, ident__line)) {
-            preprocess_line_directive(line + 1);
+            preprocess_line_directive(line + 1, 0);
+        } else if (line->token == PREP_NUMBER) {
+            preprocess_line_directive(line, 1);
         } else if (!tok_cmp(*line, ident__error)) {
             array->data++;
             array->length--;
@@ -15,7 +15,8 @@ EXTERNAL struct token
     ident__endif,
     ident__error,
     ident__pragma,
-    ident__Pragma;
+    ident__Pragma,
+    ident__once;
 
 /*
  * Preprocess a line starting with a '#' directive. Borrows ownership of
@@ -26,4 +27,18 @@ INTERNAL void preprocess_directive(TokenArray *line);
 /* Non-zero iff currently not inside a false #if directive. */
 INTERNAL int in_active_block(void);
 
+/*
+ * Track include guard of file being read, called by input module when
+ * a new file is pushed or popped. Return name of macro guarding all
+ * content of the file, or an empty string if there is no such guard.
+ */
+INTERNAL void include_guard_push(void);
+INTERNAL String include_guard_pop(void);
+
+/*
+ * Notify that a line outside of any conditional directive has been
+ * read, meaning the current file cannot have an include guard.
+ */
+INTERNAL void include_guard_invalidate(void);
+
 #endif
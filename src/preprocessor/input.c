@@ -4,18 +4,83 @@
 #endif
 #include "directive.h"
 #include "input.h"
+#include "macro.h"
 #include "strtab.h"
+#include "tokencache.h"
+#include "trace.h"
 #include <lacc/array.h>
 #include <lacc/context.h>
+#include <lacc/hash.h>
+#include <lacc/pch.h>
 
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <assert.h>
 #include <ctype.h>
+#include <fcntl.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
 
 #define FILE_BUFFER_SIZE 4096
+#define HEADER_TABLE_SIZE 256
+#define PATH_TABLE_SIZE 1024
+
+/*
+ * Result of looking up a path in the file system. Entries are kept for
+ * the lifetime of the process, also remembering paths that do not
+ * exist, so that each candidate location for an include is checked at
+ * most once.
+ */
+struct path_entry {
+    String path;
+    int exists;
+    dev_t dev;
+    ino_t ino;
+};
+
+/*
+ * Resolved location of an include name found by searching the list of
+ * include directories, or NULL if not found in any of them.
+ */
+struct resolved_include {
+    String name;
+    struct path_entry *file;
+    int is_system;
+};
+
+/*
+ * Directory searched when resolving includes. Headers found in system
+ * directories are left out of dependencies written for -MM.
+ */
+struct search_path {
+    const char *path;
+    int is_system;
+};
+
+/*
+ * Files opened in the current translation unit, used for multiple-
+ * include optimization. There is one object per distinct path, and
+ * paths resolving to the same device and inode number refer to a
+ * single canonical object holding the state of the file.
+ */
+struct header {
+    String path;
+    struct header *file;
+    dev_t dev;
+    ino_t ino;
+
+    /* Set by #pragma once. */
+    unsigned int is_once : 1;
+
+    /* Found in system include directory. */
+    unsigned int is_system : 1;
+
+    /* Macro guarding all content of the file, if detected. */
+    String guard;
+};
 
 struct source {
     FILE *file;
@@ -28,9 +93,13 @@ struct source {
      * number. When all read characters are processed, or the remaining
      * interval between (processed, read) does not contain a full line,
      * rewind the buffer, or increase if necessary.
+     *
+     * Regular files are instead mapped to memory in whole, and the
+     * buffer is never rewound or resized. File is NULL in that case.
      */
     char *buffer;
     size_t size, processed, read;
+    int is_mapped;
 
     /* Full path, or relative to invocation directory. */
     String path;
@@ -43,6 +112,24 @@ struct source {
 
     /* Current line. */
     int line;
+
+    /* Number of bytes skipped in inactive conditional blocks. */
+    size_t skipped;
+
+    /* Canonical header object, or NULL if reading from stdin. */
+    struct header *header;
+
+    /* Distinct for each time a file is opened. */
+    unsigned id;
+
+    /*
+     * Lines loaded from token cache, read from index cached_line instead
+     * of the file buffer. When recording, lines read from the buffer are
+     * added to be stored in the cache at end of file.
+     */
+    struct token_cache *cache;
+    unsigned cached_line;
+    int is_recording;
 };
 
 /* Temporary buffer used to construct search paths. */
@@ -53,7 +140,7 @@ static char *rline;
 static size_t rlen;
 
 /* List of directories to search on resolving include directives. */
-static array_of(const char *) search_path_list;
+static array_of(struct search_path) search_path_list;
 
 /*
  * List of files to include before first source file, specified with
@@ -61,40 +148,533 @@ static array_of(const char *) search_path_list;
  */
 static array_of(const char *) include_files;
 
+/* Set while reading files specified with -include. */
+static int is_include_prefix;
+
+/*
+ * Tokens of line last returned by getprepline, if read from the token
+ * cache. Otherwise, cache entry recording the line, if any.
+ */
+static const struct token *cached_tokens;
+static struct token_cache *recording_cache;
+
 /*
  * Keep stack of file descriptors as resolved by includes. Push and pop
  * from the end of the list.
  */
 static array_of(struct source) source_stack;
+static unsigned source_count;
+
+/*
+ * Map from path to header object, and list of distinct files opened in
+ * the current translation unit.
+ */
+static struct hash_table header_table;
+static array_of(struct header *) header_files;
+static int header_table_initialized;
+
+/* Header object of the main source file. */
+static struct header *input_header;
+
+/* Headers with multiple-include state saved by save_header_state. */
+static array_of(struct header) saved_headers;
+
+/*
+ * Map from path to file system lookup result, and from include name to
+ * location found in search path. Unlike headers, these are not reset
+ * between translation units.
+ */
+static struct hash_table path_table;
+static struct hash_table resolved_table;
+static int path_table_initialized;
 
 /* Expose for diagnostics. */
 INTERNAL String current_file_path;
 INTERNAL int current_file_line;
 
+static String header_hash_key(void *ref)
+{
+    return ((struct header *) ref)->path;
+}
+
+static void *header_hash_add(void *ref)
+{
+    struct header *h;
+
+    h = calloc(1, sizeof(*h));
+    *h = *((struct header *) ref);
+    return h;
+}
+
+static String path_hash_key(void *ref)
+{
+    return ((struct path_entry *) ref)->path;
+}
+
+/*
+ * Keys are constructed in temporary buffers, and must be copied to
+ * outlive the lookup.
+ */
+static String str_copy(String str)
+{
+    char *buf;
+
+    if (str.len >= SHORT_STRING_LEN) {
+        buf = malloc(str_len(str) + 1);
+        memcpy(buf, str.p.str, str_len(str) + 1);
+        str.p.str = buf;
+    }
+
+    return str;
+}
+
+static void str_free(String str)
+{
+    if (str.len >= SHORT_STRING_LEN) {
+        free((char *) str.p.str);
+    }
+}
+
+static void *path_hash_add(void *ref)
+{
+    struct path_entry *p;
+
+    p = calloc(1, sizeof(*p));
+    *p = *((struct path_entry *) ref);
+    p->path = str_copy(p->path);
+    return p;
+}
+
+static void path_hash_del(void *ref)
+{
+    struct path_entry *p;
+
+    p = (struct path_entry *) ref;
+    str_free(p->path);
+    free(p);
+}
+
+static String resolved_hash_key(void *ref)
+{
+    return ((struct resolved_include *) ref)->name;
+}
+
+static void *resolved_hash_add(void *ref)
+{
+    struct resolved_include *r;
+
+    r = calloc(1, sizeof(*r));
+    *r = *((struct resolved_include *) ref);
+    r->name = str_copy(r->name);
+    return r;
+}
+
+static void resolved_hash_del(void *ref)
+{
+    struct resolved_include *r;
+
+    r = (struct resolved_include *) ref;
+    str_free(r->name);
+    free(r);
+}
+
+static void path_table_init(void)
+{
+    if (!path_table_initialized) {
+        hash_init(
+            &path_table,
+            PATH_TABLE_SIZE,
+            path_hash_key,
+            path_hash_add,
+            path_hash_del);
+        hash_init(
+            &resolved_table,
+            HEADER_TABLE_SIZE,
+            resolved_hash_key,
+            resolved_hash_add,
+            resolved_hash_del);
+        path_table_initialized = 1;
+    }
+}
+
+/*
+ * Look up path in file system, or return cached result from previous
+ * lookup of the same path.
+ */
+static struct path_entry *lookup_path(const char *path)
+{
+    struct stat st;
+    struct path_entry *ref, p = {0};
+
+    path_table_init();
+    ref = hash_lookup(&path_table, str_init(path));
+    if (ref) {
+        return ref;
+    }
+
+    p.path = str_init(path);
+    if (!stat(path, &st)) {
+        p.exists = 1;
+        p.dev = st.st_dev;
+        p.ino = st.st_ino;
+    }
+
+    return hash_insert(&path_table, &p);
+}
+
+static void header_table_reset(void)
+{
+    if (!header_table_initialized) {
+        hash_init(
+            &header_table,
+            HEADER_TABLE_SIZE,
+            header_hash_key,
+            header_hash_add,
+            free);
+        header_table_initialized = 1;
+    } else {
+        hash_clear(&header_table);
+    }
+
+    array_empty(&header_files);
+}
+
+/*
+ * Get header object for the given path, or NULL if the file does not
+ * exist. New paths are compared by device and inode number to files
+ * already seen, to find the canonical object.
+ */
+static struct header *lookup_header(const char *path)
+{
+    int i;
+    struct path_entry *p;
+    struct header *ref, *file, h = {0};
+
+    ref = hash_lookup(&header_table, str_init(path));
+    if (ref) {
+        return ref;
+    }
+
+    p = lookup_path(path);
+    if (!p->exists) {
+        return NULL;
+    }
+
+    file = NULL;
+    for (i = 0; i < array_len(&header_files); ++i) {
+        ref = array_get(&header_files, i);
+        if (ref->dev == p->dev && ref->ino == p->ino) {
+            file = ref;
+            break;
+        }
+    }
+
+    h.path = p->path;
+    h.dev = p->dev;
+    h.ino = p->ino;
+    ref = hash_insert(&header_table, &h);
+    if (file) {
+        ref->file = file;
+    } else {
+        ref->file = ref;
+        array_push_back(&header_files, ref);
+    }
+
+    return ref;
+}
+
+INTERNAL void save_header_state(void)
+{
+    int i;
+    struct header *h;
+
+    array_empty(&saved_headers);
+    for (i = 0; i < array_len(&header_files); ++i) {
+        h = array_get(&header_files, i);
+        if (h != input_header) {
+            array_push_back(&saved_headers, *h);
+        }
+    }
+}
+
+INTERNAL void add_saved_header(const char *path)
+{
+    struct header h = {0};
+
+    h.path = str_init(path);
+    array_push_back(&saved_headers, h);
+}
+
+INTERNAL void restore_header_state(void)
+{
+    int i;
+    struct header h, *ref;
+
+    for (i = 0; i < array_len(&saved_headers); ++i) {
+        h = array_get(&saved_headers, i);
+        ref = lookup_header(str_raw(h.path));
+        if (ref) {
+            ref->file->is_once = h.is_once;
+            ref->file->is_system = h.is_system;
+            ref->file->guard = h.guard;
+        }
+    }
+}
+
+INTERNAL void write_header_state(FILE *stream)
+{
+    int i;
+    struct header h;
+
+    pch_write_int(stream, array_len(&saved_headers));
+    for (i = 0; i < array_len(&saved_headers); ++i) {
+        h = array_get(&saved_headers, i);
+        pch_write_string(stream, h.path);
+        pch_write_int(stream, h.is_once);
+        pch_write_int(stream, h.is_system);
+        pch_write_string(stream, h.guard);
+    }
+}
+
+INTERNAL void read_header_state(FILE *stream)
+{
+    long i, n;
+    struct header h = {0};
+
+    array_empty(&saved_headers);
+    n = pch_read_int(stream);
+    for (i = 0; i < n; ++i) {
+        h.path = pch_read_string(stream);
+        h.is_once = pch_read_int(stream) != 0;
+        h.is_system = pch_read_int(stream) != 0;
+        h.guard = pch_read_string(stream);
+        array_push_back(&saved_headers, h);
+    }
+}
+
+/*
+ * Files are identified by path, size and modification time. Content is
+ * not hashed, to avoid reading all the files the precompiled header is
+ * meant to replace.
+ */
+INTERNAL void write_header_dependencies(FILE *stream)
+{
+    int i;
+    struct stat st;
+    struct header *h;
+
+    pch_write_int(stream, array_len(&header_files));
+    for (i = 0; i < array_len(&header_files); ++i) {
+        h = array_get(&header_files, i);
+        if (stat(str_raw(h->path), &st)) {
+            error("Unable to stat file %s.", str_raw(h->path));
+            exit(1);
+        }
+        pch_write_chars(stream, str_raw(h->path));
+        pch_write_int(stream, st.st_size);
+        pch_write_int(stream, st.st_mtime);
+    }
+}
+
+INTERNAL int read_header_dependencies(FILE *stream)
+{
+    long i, n, size, mtime;
+    int is_valid;
+    char *path;
+    struct stat st;
+
+    is_valid = 1;
+    n = pch_read_int(stream);
+    for (i = 0; i < n; ++i) {
+        path = pch_read_chars(stream);
+        size = pch_read_int(stream);
+        mtime = pch_read_int(stream);
+        if (stat(path, &st) || st.st_size != size || st.st_mtime != mtime) {
+            verbose("Precompiled header dependency %s has changed.", path);
+            is_valid = 0;
+        }
+        free(path);
+    }
+
+    return is_valid;
+}
+
+/*
+ * Write path escaped for use in a Make rule, and return the number of
+ * characters written.
+ */
+static int write_make_path(FILE *stream, const char *path)
+{
+    int n;
+
+    for (n = 0; *path; ++path, ++n) {
+        switch (*path) {
+        case ' ':
+        case '#':
+            putc('\\', stream);
+            n++;
+            break;
+        case '$':
+            putc('$', stream);
+            n++;
+            break;
+        }
+        putc(*path, stream);
+    }
+
+    return n;
+}
+
+/*
+ * Files are listed in the order they were first opened, starting with
+ * the main source file. Long rules are wrapped with line continuations.
+ */
+INTERNAL void write_dependencies(
+    FILE *stream,
+    const char *target,
+    int exclude_system,
+    int phony_targets)
+{
+    int i, col;
+    struct header *h;
+
+    col = fprintf(stream, "%s:", target);
+    for (i = 0; i < array_len(&header_files); ++i) {
+        h = array_get(&header_files, i);
+        if (exclude_system && h->is_system) {
+            continue;
+        }
+        if (col + str_len(h->path) > 75) {
+            fputs(" \\\n", stream);
+            col = 0;
+        }
+        putc(' ', stream);
+        col += write_make_path(stream, str_raw(h->path)) + 1;
+    }
+
+    putc('\n', stream);
+    if (phony_targets) {
+        for (i = 0; i < array_len(&header_files); ++i) {
+            h = array_get(&header_files, i);
+            if (h != input_header && !(exclude_system && h->is_system)) {
+                putc('\n', stream);
+                write_make_path(stream, str_raw(h->path));
+                fputs(":\n", stream);
+            }
+        }
+    }
+}
+
+/*
+ * Determine whether including the file again would have no effect,
+ * either because of #pragma once, or because the include guard macro
+ * is still defined.
+ */
+static int is_include_skippable(const struct header *file)
+{
+    return file->is_once
+        || (file->guard.len && macro_definition(file->guard));
+}
+
+/*
+ * Open file for reading. Regular files are mapped to memory, relying on
+ * the remainder of the last page being filled with zeros to get a null
+ * terminated buffer as required by read_line. Fall back to reading from
+ * a buffered stream if the file size is a multiple of the page size, or
+ * the file does not end with a newline.
+ */
+static int open_source(struct source *source, const char *path)
+{
+    int fd;
+    size_t size;
+    struct stat st;
+    char *data;
+
+    fd = open(path, O_RDONLY);
+    if (fd == -1) {
+        return 0;
+    }
+
+    if (!fstat(fd, &st) && S_ISREG(st.st_mode) && st.st_size > 0) {
+        size = st.st_size;
+        if (size % sysconf(_SC_PAGESIZE)) {
+            data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                if (data[size - 1] == '\n') {
+                    assert(data[size] == '\0');
+                    close(fd);
+                    source->buffer = data;
+                    source->read = size;
+                    source->size = size + 1;
+                    source->is_mapped = 1;
+                    return 1;
+                }
+                munmap(data, size);
+            }
+        }
+    }
+
+    close(fd);
+    source->file = fopen(path, "r");
+    return source->file != NULL;
+}
+
 static void push_file(struct source source)
 {
-    assert(source.file);
+    assert(source.file || source.is_mapped);
     assert(source.path.len);
 
     current_file_line = 0;
     current_file_path = source.path;
-    source.buffer = malloc(FILE_BUFFER_SIZE);
-    source.size = FILE_BUFFER_SIZE;
+    if (!source.is_mapped) {
+        source.buffer = malloc(FILE_BUFFER_SIZE);
+        source.size = FILE_BUFFER_SIZE;
+    }
+
+    source.id = ++source_count;
     array_push_back(&source_stack, source);
+    include_guard_push();
+    if (context.trace_includes) {
+        trace_include_push(source.path);
+    }
 }
 
 static int pop_file(void)
 {
     unsigned len;
+    long bytes;
+    String guard;
     struct source source;
 
     len = array_len(&source_stack);
     if (len) {
         source = array_pop_back(&source_stack);
-        if (source.file != stdin) {
-            fclose(source.file);
+        guard = include_guard_pop();
+        if (source.header && guard.len) {
+            source.header->guard = guard;
+        }
+        if (source.skipped) {
+            verbose("Skipped %lu bytes of inactive lines in %s.",
+                (unsigned long) source.skipped, str_raw(source.path));
+        }
+        if (source.cache) {
+            token_cache_free(source.cache);
+        }
+        if (context.trace_includes) {
+            bytes = source.is_mapped ? (long) source.read : ftell(source.file);
+            trace_include_pop(bytes < 0 ? 0 : bytes, source.line);
+        }
+        if (source.is_mapped) {
+            munmap(source.buffer, source.read);
+        } else {
+            if (source.file != stdin) {
+                fclose(source.file);
+            }
+            free(source.buffer);
+        }
+        if (len - 1 == 1) {
+            is_include_prefix = 0;
         }
-        free(source.buffer);
         if (len - 1) {
             return 1;
         }
@@ -112,6 +692,19 @@ INTERNAL void input_finalize(void)
     array_clear(&source_stack);
     array_clear(&search_path_list);
     array_clear(&include_files);
+    array_clear(&header_files);
+    array_clear(&saved_headers);
+    if (header_table_initialized) {
+        hash_destroy(&header_table);
+        header_table_initialized = 0;
+    }
+
+    if (path_table_initialized) {
+        hash_destroy(&path_table);
+        hash_destroy(&resolved_table);
+        path_table_initialized = 0;
+    }
+
     free(path_buffer);
     free(rline);
 }
@@ -140,11 +733,59 @@ static char *create_path(const char *path, size_t dirlen, const char *name)
     return path_buffer;
 }
 
+/*
+ * Push file at path to the include stack, unless it is known to have no
+ * effect. Return 0 if the file could not be opened.
+ */
+static int try_include_file(const char *path, int is_system)
+{
+    struct header *h;
+    struct source source = {0};
+
+    h = lookup_header(path);
+    if (!h) {
+        return 0;
+    }
+
+    if (is_system) {
+        h->file->is_system = 1;
+    }
+
+    if (is_include_skippable(h->file)) {
+        verbose("Skipping include of %s.", str_raw(h->path));
+        if (context.trace_includes) {
+            trace_include_skip(h->file->path);
+        }
+        return 1;
+    }
+
+    if (!open_source(&source, path)) {
+        return 0;
+    }
+
+    if (has_token_cache() && source.is_mapped) {
+        source.cache = token_cache_load(
+            str_raw(h->path),
+            source.buffer,
+            source.read);
+        if (!source.cache) {
+            source.cache = token_cache_create();
+            source.is_recording = 1;
+        }
+    }
+
+    source.path = h->path;
+    source.dirlen = path_dirlen(path);
+    source.header = h->file;
+    push_file(source);
+    return 1;
+}
+
 INTERNAL void include_file(const char *name)
 {
+    int is_system;
     const char *path;
     struct source *file;
-    struct source source = {0};
 
     /*
      * Construct path by combining current directory and include name,
@@ -159,59 +800,130 @@ INTERNAL void include_file(const char *name)
         path = name;
     }
 
-    source.file = fopen(path, "r");
-    if (source.file) {
-        source.path = str_register(path, strlen(path));
-        source.dirlen = path_dirlen(path);
-        push_file(source);
-    } else {
+    is_system = file->header && file->header->is_system;
+    if (!try_include_file(path, is_system)) {
         include_system_file(name);
     }
 }
 
-INTERNAL void include_system_file(const char *name)
+/*
+ * Find the first directory in search path containing a file with the
+ * given name. The search path does not change during compilation, so
+ * the result is remembered for subsequent includes of the same name.
+ */
+static struct resolved_include *resolve_system_include(const char *name)
 {
-    struct source source = {0};
     const char *path;
     size_t dirlen;
     int i;
+    struct path_entry *p;
+    struct search_path dir;
+    struct resolved_include *ref, r = {0};
+
+    path_table_init();
+    ref = hash_lookup(&resolved_table, str_init(name));
+    if (ref) {
+        return ref;
+    }
 
     for (i = 0; i < array_len(&search_path_list); ++i) {
-        path = array_get(&search_path_list, i);
+        dir = array_get(&search_path_list, i);
+        path = dir.path;
         dirlen = strlen(path);
         while (path[dirlen - 1] == '/') {
             dirlen--;
             assert(dirlen);
         }
         path = create_path(path, dirlen, name);
-        source.file = fopen(path, "r");
-        if (source.file) {
-            source.path = str_register(path, strlen(path));
-            source.dirlen = path_dirlen(path);
+        p = lookup_path(path);
+        if (p->exists) {
+            r.file = p;
+            r.is_system = dir.is_system;
             break;
         }
     }
 
-    if (source.file) {
-        push_file(source);
-    } else {
+    r.name = str_init(name);
+    return hash_insert(&resolved_table, &r);
+}
+
+INTERNAL void include_system_file(const char *name)
+{
+    struct resolved_include *ref;
+
+    ref = resolve_system_include(name);
+    if (!ref->file) {
         error("Unable to resolve include file '%s'.", name);
         exit(1);
     }
+
+    if (!try_include_file(str_raw(ref->file->path), ref->is_system)) {
+        error("Unable to open file %s.", str_raw(ref->file->path));
+        exit(1);
+    }
+}
+
+INTERNAL void set_pragma_once(void)
+{
+    struct source *source;
+
+    if (array_len(&source_stack)) {
+        source = &array_back(&source_stack);
+        if (source->header) {
+            source->header->is_once = 1;
+        }
+    }
 }
 
 INTERNAL int add_include_search_path(const char *path)
 {
-    array_push_back(&search_path_list, path);
+    struct search_path dir;
+
+    dir.path = path;
+    dir.is_system = 0;
+    array_push_back(&search_path_list, dir);
     return 0;
 }
 
+INTERNAL int add_system_include_search_path(const char *path)
+{
+    struct search_path dir;
+
+    dir.path = path;
+    dir.is_system = 1;
+    array_push_back(&search_path_list, dir);
+    return 0;
+}
+
+INTERNAL const char *get_include_search_path(int n, int *is_system)
+{
+    struct search_path dir;
+
+    if (n >= array_len(&search_path_list)) {
+        return NULL;
+    }
+
+    dir = array_get(&search_path_list, n);
+    *is_system = dir.is_system;
+    return dir.path;
+}
+
 INTERNAL int add_include_file(const char *path)
 {
     array_push_back(&include_files, path);
     return 0;
 }
 
+INTERNAL void clear_include_files(void)
+{
+    array_empty(&include_files);
+}
+
+INTERNAL int is_reading_include_files(void)
+{
+    return is_include_prefix;
+}
+
 /*
  * Files specified with -include foo are handled as if the first line
  * of the source file contained '#include "foo"', except that it does
@@ -220,20 +932,16 @@ INTERNAL int add_include_file(const char *path)
 static void inject_include_files(void)
 {
     int i;
-    struct source source = {0};
     const char *path;
 
     for (i = array_len(&include_files) - 1; i >= 0; --i) {
         path = array_get(&include_files, i);
-        source.file = fopen(path, "r");
-        if (source.file) {
-            source.path = str_register(path, strlen(path));
-            source.dirlen = path_dirlen(path);
-            push_file(source);
-        } else {
+        if (!try_include_file(path, 0)) {
             include_system_file(path);
         }
     }
+
+    is_include_prefix = array_len(&source_stack) > 1;
 }
 
 INTERNAL void set_input_file(const char *path)
@@ -244,6 +952,7 @@ INTERNAL void set_input_file(const char *path)
     while (pop_file() != EOF)
         ;
 
+    header_table_reset();
     if (!rline) {
         rlen = FILE_BUFFER_SIZE;
         rline = calloc(rlen, sizeof(*rline));
@@ -255,17 +964,22 @@ INTERNAL void set_input_file(const char *path)
     if (path) {
         sep = strrchr(path, '/');
         source.path = str_init(path);
-        source.file = fopen(path, "r");
         if (sep) {
             source.dirlen = sep - path;
         }
-        if (!source.file) {
+        if (!open_source(&source, path)) {
             error("Unable to open file %s.", path);
             exit(1);
         }
+        source.header = lookup_header(path);
+        if (source.header) {
+            source.header = source.header->file;
+        }
+        input_header = source.header;
     } else {
         source.file = stdin;
         source.path = str_init("<stdin>");
+        input_header = NULL;
     }
 
     push_file(source);
@@ -304,7 +1018,8 @@ static size_t read_comment(const char *line, int *linecount)
 
 /*
  * Read single line comment ending at the first newline. Return number
- * of characters read, or 0 if end of input reached.
+ * of characters read, or 0 if end of input reached. The comment goes on
+ * past newlines escaped by backslash, or by the trigraph for backslash.
  */
 static size_t read_line_comment(const char *line, int *linecount)
 {
@@ -317,6 +1032,11 @@ static size_t read_line_comment(const char *line, int *linecount)
         if (c == '\\' && *ptr == '\n') {
             *linecount += 1;
             ptr++;
+        } else if (c == '?' && ptr[0] == '?' && ptr[1] == '/'
+            && ptr[2] == '\n')
+        {
+            *linecount += 1;
+            ptr += 3;
         } else if (c == '\n') {
             return ptr - line;
         }
@@ -412,6 +1132,75 @@ static size_t read_literal(const char *line, char **buf, int *lines)
     return 0;
 }
 
+/*
+ * Word with each byte set to 0x01, and 0x80. Detect if any byte in a
+ * word is equal to some value by XOR with a repeated pattern, and check
+ * for zero bytes. Subtracting one only borrows into the high bit of a
+ * byte which was zero, or which is above a byte that was zero.
+ */
+#define WORD_ONES (~0UL / 255)
+#define WORD_HIGH (WORD_ONES * 128)
+#define has_zero(w) (((w) - WORD_ONES) & ~(w) & WORD_HIGH)
+#define has_byte(w, c) has_zero((w) ^ (WORD_ONES * (unsigned char) (c)))
+
+#ifndef READ_LINE_SCALAR
+
+/*
+ * Determine if character can be copied as is, without needing any
+ * processing in read_line.
+ */
+static int is_plain_char(char c)
+{
+    switch (c) {
+    case '\0':
+    case '\n':
+    case '\\':
+    case '?':
+    case '\'':
+    case '"':
+    case '/':
+    case '*':
+        return 0;
+    default:
+        return 1;
+    }
+}
+
+/*
+ * Copy prefix of characters not needing any processing, testing a whole
+ * word at a time, and then byte by byte up to the first interesting
+ * character. Always leave at least one character of the input for the
+ * caller to handle. Return number of characters copied.
+ */
+static size_t read_plain_chars(const char *line, size_t len, char *ptr)
+{
+    size_t i;
+    unsigned long w;
+
+    i = 0;
+    while (i + sizeof(w) < len) {
+        memcpy(&w, line + i, sizeof(w));
+        if (has_byte(w, '\n') | has_byte(w, '\\') | has_byte(w, '?')
+            | has_byte(w, '\'') | has_byte(w, '"') | has_byte(w, '/')
+            | has_byte(w, '*'))
+        {
+            break;
+        }
+
+        memcpy(ptr + i, &w, sizeof(w));
+        i += sizeof(w);
+    }
+
+    while (i + 1 < len && is_plain_char(line[i])) {
+        ptr[i] = line[i];
+        i++;
+    }
+
+    return i;
+}
+
+#endif
+
 /*
  * Read initial part of line, until forming a complete source line ready
  * for tokenization. Store the result with the following mutations done:
@@ -440,6 +1229,11 @@ INTERNAL size_t read_line(
     assert(ptr[-1] == '\0');
     end = line;
     do {
+#ifndef READ_LINE_SCALAR
+        count = read_plain_chars(end, len - (end - line), ptr);
+        end += count;
+        ptr += count;
+#endif
         switch (*end) {
         case '\n':
             *linecount += lines + 1;
@@ -499,6 +1293,43 @@ INTERNAL size_t read_line(
     return 0;
 }
 
+/*
+ * Read the next line from memory mapped file. The whole file is already
+ * available, so there is never any need to buffer more input.
+ *
+ * The line buffer must be large enough to hold the longest line in the
+ * file, which is bounded by the remaining input. Grow it to that size
+ * up front. Only the part actually written to is paged in.
+ */
+static char *initial_preprocess_mapped_line(struct source *fn)
+{
+    size_t added, remaining;
+
+    if (fn->processed == fn->read) {
+        return NULL;
+    }
+
+    remaining = fn->read - fn->processed;
+    if (rlen <= remaining + 1) {
+        rlen = remaining + 2;
+        rline = realloc(rline, rlen);
+    }
+
+    added = read_line(
+        fn->buffer + fn->processed,
+        remaining,
+        rline + 1,
+        &fn->line);
+
+    if (!added) {
+        error("Unable to process the whole input.");
+        exit(1);
+    }
+
+    fn->processed += added;
+    return rline + 1;
+}
+
 /*
  * Read the next line from file input, doing initial pre-preprocessing.
  */
@@ -509,6 +1340,10 @@ static char *initial_preprocess_line(struct source *fn)
     assert(fn->processed <= fn->read);
     assert(fn->read < fn->size);
 
+    if (fn->is_mapped) {
+        return initial_preprocess_mapped_line(fn);
+    }
+
     do {
         if (fn->processed == fn->read || !fn->processed) {
             if (feof(fn->file)) {
@@ -575,8 +1410,45 @@ static char *initial_preprocess_line(struct source *fn)
     return rline + 1;
 }
 
+/*
+ * Read the next line of file loaded from token cache. Lines stored as
+ * tokens are returned as an empty string, with the tokens available
+ * from getlinetokens.
+ */
+static char *read_cached_line(struct source *fn)
+{
+    size_t len;
+    const char *text;
+    struct cached_line l;
+
+    if (fn->cached_line == array_len(&fn->cache->lines)) {
+        return NULL;
+    }
+
+    l = array_get(&fn->cache->lines, fn->cached_line++);
+    fn->line = l.line;
+    if (l.tokens >= 0) {
+        cached_tokens = &array_get(&fn->cache->tokens, l.tokens);
+        rline[1] = '\0';
+    } else {
+        text = &array_get(&fn->cache->text, l.text);
+        len = strlen(text);
+        if (rlen < len + 2) {
+            rlen = len + 2;
+            rline = realloc(rline, rlen);
+        }
+        memcpy(rline + 1, text, len + 1);
+    }
+
+    return rline + 1;
+}
+
 static int is_directive(const char *line)
 {
+    if (cached_tokens) {
+        return cached_tokens->token == '#';
+    }
+
     while (*line == ' ' || *line == '\t') {
         line++;
     }
@@ -584,15 +1456,182 @@ static int is_directive(const char *line)
     return *line == '#';
 }
 
-INTERNAL char *getprepline(void)
+/*
+ * Consume a string or character literal, not spanning multiple lines.
+ * Return pointer to the character following the closing quote, or NULL
+ * if the literal needs any processing.
+ */
+static const char *skip_literal(const char *ptr)
+{
+    char q;
+
+    q = *ptr++;
+    while (*ptr != q) {
+        switch (*ptr) {
+        case '\0':
+        case '\n':
+            return NULL;
+        case '\\':
+            if (ptr[1] == '\n' || ptr[1] == '\0') {
+                return NULL;
+            }
+            ptr++;
+            break;
+        case '?':
+            if (ptr[1] == '?') {
+                return NULL;
+            }
+            break;
+        }
+        ptr++;
+    }
+
+    return ptr + 1;
+}
+
+/*
+ * Consume a line which cannot be a directive, including any comments
+ * continuing on following lines. Return pointer to the start of next
+ * line, or NULL if the line possibly is a directive, or is not simple
+ * enough to be handled without going through read_line.
+ */
+static const char *skip_line(
+    const char *ptr,
+    const char *end,
+    int *linecount)
+{
+    int lines;
+    size_t count;
+    unsigned long w;
+
+    lines = 0;
+    while (*ptr == ' ' || *ptr == '\t') {
+        ptr++;
+    }
+
+    switch (*ptr) {
+    case '#':
+    case '?':
+    case '\\':
+        return NULL;
+    case '/':
+        if (ptr[1] != '/') {
+            return NULL;
+        }
+    default:
+        break;
+    }
+
+    while (1) {
+        while (ptr + sizeof(w) < end) {
+            memcpy(&w, ptr, sizeof(w));
+            if (has_byte(w, '\n') | has_byte(w, '\\') | has_byte(w, '?')
+                | has_byte(w, '\'') | has_byte(w, '"') | has_byte(w, '/'))
+            {
+                break;
+            }
+            ptr += sizeof(w);
+        }
+
+        switch (*ptr) {
+        case '\0':
+            return NULL;
+        case '\n':
+            *linecount += lines + 1;
+            return ptr + 1;
+        case '\\':
+        case '?':
+            if (ptr[1] == '\n' || ptr[1] == '?') {
+                return NULL;
+            }
+            break;
+        case '\'':
+        case '"':
+            ptr = skip_literal(ptr);
+            if (!ptr) {
+                return NULL;
+            }
+            continue;
+        case '/':
+            if (ptr[1] == '/') {
+                count = read_line_comment(ptr + 2, &lines);
+                if (!count) {
+                    return NULL;
+                }
+                *linecount += lines + 1;
+                return ptr + count + 2;
+            } else if (ptr[1] == '*') {
+                count = read_comment(ptr + 2, &lines);
+                if (!count) {
+                    return NULL;
+                }
+                ptr += count + 2;
+                continue;
+            }
+            break;
+        }
+        ptr++;
+    }
+}
+
+/*
+ * Skip lines in inactive conditional block, looking only for lines that
+ * can be directives. Only whole lines already in the input buffer are
+ * consumed. Lines which are not trivial to classify are left to be read
+ * by the normal path.
+ */
+static void skip_inactive_lines(struct source *fn)
+{
+    const char *line, *next, *end;
+
+    assert(fn->buffer);
+    line = fn->buffer + fn->processed;
+    end = fn->buffer + fn->read;
+    while (fn->processed < fn->read) {
+        next = skip_line(line, end, &fn->line);
+        if (!next) {
+            break;
+        }
+
+        fn->processed += next - line;
+        fn->skipped += next - line;
+        line = next;
+    }
+}
+
+/*
+ * Set when the current file is popped, to update current file path and
+ * line number on reading the next line.
+ */
+static int stale;
+
+/*
+ * Add line to cache entry of file being recorded, or write the entry
+ * on reaching end of file.
+ */
+static void record_line(struct source *fn, const char *line)
 {
-    static int stale;
+    if (line) {
+        token_cache_add_line(fn->cache, line, fn->line);
+        recording_cache = fn->cache;
+    } else {
+        token_cache_store(
+            fn->cache,
+            str_raw(fn->path),
+            fn->buffer,
+            fn->read);
+    }
+}
 
+INTERNAL char *getprepline(void)
+{
     struct source *source;
     char *line;
     int loc;
 
     do {
+        cached_tokens = NULL;
+        recording_cache = NULL;
         if (!array_len(&source_stack)) {
             return NULL;
         }
@@ -603,7 +1642,17 @@ INTERNAL char *getprepline(void)
             current_file_line = source->line;
             stale = 0;
         }
-        line = initial_preprocess_line(source);
+        if (source->cache && !source->is_recording) {
+            line = read_cached_line(source);
+        } else {
+            if (!in_active_block() && !source->is_recording) {
+                skip_inactive_lines(source);
+            }
+            line = initial_preprocess_line(source);
+            if (source->is_recording) {
+                record_line(source, line);
+            }
+        }
         current_file_line += source->line - loc;
         if (!line) {
             stale = 1;
@@ -622,3 +1671,84 @@ INTERNAL char *getprepline(void)
 
     return line;
 }
+
+INTERNAL const char *getrawline(void)
+{
+    struct source *source;
+    const char *line, *end;
+
+    if (!array_len(&source_stack) || stale || !in_active_block()) {
+        return NULL;
+    }
+
+    source = &array_back(&source_stack);
+    if (!source->is_mapped
+        || source->cache
+        || source->processed == source->read)
+    {
+        return NULL;
+    }
+
+    line = source->buffer + source->processed;
+    end = memchr(line, '\n', source->read - source->processed);
+    assert(end);
+    source->processed = end + 1 - source->buffer;
+    source->line += 1;
+    current_file_line += 1;
+    return line;
+}
+
+INTERNAL char *getprepline_rest(const char *line)
+{
+    struct source *source;
+
+    assert(array_len(&source_stack));
+    source = &array_back(&source_stack);
+    assert(source->is_mapped);
+    assert(line >= source->buffer);
+    assert(line < source->buffer + source->processed);
+
+    source->processed = line - source->buffer;
+    source->line -= 1;
+    current_file_line -= 1;
+    return getprepline();
+}
+
+INTERNAL const struct token *getlinetokens(void)
+{
+    return cached_tokens;
+}
+
+INTERNAL int is_line_recorded(void)
+{
+    return recording_cache != NULL;
+}
+
+INTERNAL int include_depth(void)
+{
+    return array_len(&source_stack);
+}
+
+INTERNAL unsigned include_stack_entry(
+    int depth,
+    String *path,
+    int *line,
+    int *is_system)
+{
+    struct source *source;
+
+    assert(depth > 0);
+    assert(depth <= array_len(&source_stack));
+    source = &array_get(&source_stack, depth - 1);
+    *path = source->path;
+    *line = source->line;
+    *is_system = source->header && source->header->is_system;
+    return source->id;
+}
+
+INTERNAL void set_line_tokens(const struct token *tokens, unsigned n)
+{
+    assert(recording_cache);
+    token_cache_set_tokens(recording_cache, tokens, n);
+    recording_cache = NULL;
+}
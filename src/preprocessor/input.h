@@ -2,6 +2,9 @@
 #define INPUT_H
 
 #include <lacc/string.h>
+#include <lacc/token.h>
+
+#include <stdio.h>
 
 /*
  * Initialize with root file name, and store relative path to resolve
@@ -18,13 +21,77 @@ INTERNAL void input_finalize(void);
  */
 INTERNAL int add_include_search_path(const char *);
 
-/* Push new include file. */
+/*
+ * Default search paths, and paths specified with -isystem. Headers found
+ * in these directories are considered system headers.
+ */
+INTERNAL int add_system_include_search_path(const char *);
+
+/*
+ * Get the n-th directory searched when resolving includes, in order of
+ * priority, or NULL if there are not that many.
+ */
+INTERNAL const char *get_include_search_path(int n, int *is_system);
+
+/*
+ * Push new include file. Files marked with #pragma once, or guarded by
+ * a macro that is still defined, are not read again.
+ */
 INTERNAL void include_file(const char *);
 INTERNAL void include_system_file(const char *);
 
+/* Mark file currently being read to not be included again. */
+INTERNAL void set_pragma_once(void);
+
 /* Add file to be included before the main source file. */
 INTERNAL int add_include_file(const char *path);
 
+/* Do not include files given by -include in subsequent input files. */
+INTERNAL void clear_include_files(void);
+
+/*
+ * Return non-zero while reading files given by -include, before input
+ * continues with the main source file.
+ */
+INTERNAL int is_reading_include_files(void);
+
+/*
+ * Remember which headers opened so far are guarded or marked with
+ * #pragma once, to skip them also in later input files. All headers
+ * are kept, to be listed as dependencies of later input files.
+ */
+INTERNAL void save_header_state(void);
+INTERNAL void restore_header_state(void);
+
+/*
+ * Add file to saved header state, for it to be listed as a dependency
+ * of later input files without being read.
+ */
+INTERNAL void add_saved_header(const char *path);
+
+/* Write saved header state to precompiled header, or read it back. */
+INTERNAL void write_header_state(FILE *stream);
+INTERNAL void read_header_state(FILE *stream);
+
+/*
+ * Write list of files opened in the current translation unit, or read
+ * the list and return non-zero if none of the files have changed.
+ */
+INTERNAL void write_header_dependencies(FILE *stream);
+INTERNAL int read_header_dependencies(FILE *stream);
+
+/*
+ * Write Make rule with target depending on every file opened in the
+ * current translation unit, optionally leaving out system headers. With
+ * phony_targets, also add an empty rule for each header, to avoid
+ * errors from make when a header is removed.
+ */
+INTERNAL void write_dependencies(
+    FILE *stream,
+    const char *target,
+    int exclude_system,
+    int phony_targets);
+
 /*
  * Yield next line ready for further preprocessing. Joins continuations,
  * and replaces comments with a single space. Line implicitly ends with
@@ -32,6 +99,49 @@ INTERNAL int add_include_file(const char *path);
  */
 INTERNAL char *getprepline(void);
 
+/*
+ * Yield next line directly from the input buffer, without any initial
+ * preprocessing, or NULL if not possible. The line ends with a newline
+ * character, and is consumed in whole. Only lines from memory mapped
+ * files in active blocks can be read this way.
+ */
+INTERNAL const char *getrawline(void);
+
+/*
+ * Continue reading line previously returned by getrawline, starting at
+ * the given position, with initial preprocessing.
+ */
+INTERNAL char *getprepline_rest(const char *line);
+
+/*
+ * Headers are read from the token cache if enabled with -ftoken-cache.
+ * Return END terminated list of tokens for the line last returned by
+ * getprepline if it was loaded from the cache, or NULL otherwise. The
+ * line itself is empty in that case.
+ */
+INTERNAL const struct token *getlinetokens(void);
+
+/*
+ * Return non-zero if the line last returned by getprepline is recorded
+ * to be stored in the token cache. Tokens produced from the whole line
+ * should then be passed to set_line_tokens.
+ */
+INTERNAL int is_line_recorded(void);
+INTERNAL void set_line_tokens(const struct token *tokens, unsigned n);
+
+/*
+ * Number of files on the include stack, where the main source file has
+ * depth 1. Entries are identified by a number that is distinct for each
+ * time a file is opened, returned together with path and current line
+ * of the file at the given depth.
+ */
+INTERNAL int include_depth(void);
+INTERNAL unsigned include_stack_entry(
+    int depth,
+    String *path,
+    int *line,
+    int *is_system);
+
 /* Path of file and line number that was last read. */
 EXTERNAL String current_file_path;
 EXTERNAL int current_file_line;
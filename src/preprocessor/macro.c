@@ -6,8 +6,10 @@
 #include "macro.h"
 #include "strtab.h"
 #include "tokenize.h"
+#include "trace.h"
 #include <lacc/context.h>
 #include <lacc/hash.h>
+#include <lacc/pch.h>
 
 #include <assert.h>
 #include <ctype.h>
@@ -23,21 +25,69 @@
 static struct hash_table macro_hash_table;
 static int new_macro_added;
 
-typedef array_of(String) ExpandStack;
+/*
+ * Macro being expanded, and scope it was expanded in before, restored
+ * when the expansion is done.
+ */
+struct expansion {
+    struct macro *def;
+    unsigned long outer;
+};
+
+/*
+ * Macros being expanded in a call to expand, forming the set of names
+ * that are not expanded again. Each scope has a unique serial number,
+ * and each definition refers to the innermost scope it is expanded in,
+ * making the test for recursion constant time.
+ *
+ * The expansion ends with a function-like macro name not followed by
+ * '(' if ends_with_name is set, in which case the name can still be
+ * expanded with arguments following the expansion.
+ */
+typedef struct {
+    unsigned long serial;
+    array_of(struct expansion) macros;
+    int ends_with_name;
+} ExpandStack;
 
 /* Keep track of arrays being recycled. */
 static array_of(TokenArray) arrays;
 static array_of(ExpandStack) stacks;
+static unsigned long expand_serial;
+
+/*
+ * Definitions and removals recorded between macro_snapshot_begin and
+ * macro_snapshot_end, in order of appearance.
+ */
+struct macro_op {
+    int is_undef;
+    struct macro macro;
+};
+
+static array_of(struct macro_op) snapshot;
+static int is_recording;
 
-static int is_expanded(const ExpandStack *scope, String name)
+static int is_expanded(const ExpandStack *scope, const struct macro *def)
 {
-    int i;
-    for (i = 0; i < array_len(scope); ++i) {
-        if (!str_cmp(array_get(scope, i), name)) {
-            return 1;
-        }
-    }
-    return 0;
+    return def->expand_scope == scope->serial;
+}
+
+static void push_expansion(ExpandStack *scope, struct macro *def)
+{
+    struct expansion e;
+
+    e.def = def;
+    e.outer = def->expand_scope;
+    def->expand_scope = scope->serial;
+    array_push_back(&scope->macros, e);
+}
+
+static void pop_expansion(ExpandStack *scope)
+{
+    struct expansion e;
+
+    e = array_pop_back(&scope->macros);
+    e.def->expand_scope = e.outer;
 }
 
 INTERNAL TokenArray get_token_array(void)
@@ -57,15 +107,23 @@ INTERNAL void release_token_array(TokenArray list)
     array_push_back(&arrays, list);
 }
 
+static TokenArray copy_token_array(const TokenArray *list)
+{
+    TokenArray copy = get_token_array();
+    array_concat(&copy, list);
+    return copy;
+}
+
 static ExpandStack get_expand_stack(void)
 {
     ExpandStack stack = {0};
     if (array_len(&stacks)) {
         stack = array_pop_back(&stacks);
-        array_zero(&stack);
-        array_empty(&stack);
+        array_empty(&stack.macros);
+        stack.ends_with_name = 0;
     }
 
+    stack.serial = ++expand_serial;
     return stack;
 }
 
@@ -148,6 +206,11 @@ INTERNAL void macro_finalize(void)
     ExpandStack stack;
 
     hash_destroy(&macro_hash_table);
+    for (i = 0; i < array_len(&snapshot); ++i) {
+        list = array_get(&snapshot, i).macro.replacement;
+        array_clear(&list);
+    }
+
     for (i = 0; i < array_len(&arrays); ++i) {
         list = array_get(&arrays, i);
         array_clear(&list);
@@ -155,9 +218,10 @@ INTERNAL void macro_finalize(void)
 
     for (i = 0; i < array_len(&stacks); ++i) {
         stack = array_get(&stacks, i);
-        array_clear(&stack);
+        array_clear(&stack.macros);
     }
 
+    array_clear(&snapshot);
     array_clear(&arrays);
     array_clear(&stacks);
 }
@@ -184,11 +248,8 @@ static struct token get__file__token(void)
  * Replace __FILE__ with file name, and __LINE__ with line number, by
  * mutating the replacement list on the fly.
  */
-const struct macro *macro_definition(String name)
+static struct macro *update_definition(struct macro *ref)
 {
-    struct macro *ref;
-
-    ref = hash_lookup(&macro_hash_table, name);
     if (ref) {
         if (ref->is__file__) {
             array_get(&ref->replacement, 0) = get__file__token();
@@ -200,13 +261,51 @@ const struct macro *macro_definition(String name)
     return ref;
 }
 
+INTERNAL const struct macro *macro_definition(String name)
+{
+    struct ident *id;
+
+    id = ident_lookup(name);
+    return id ? update_definition(id->macro) : NULL;
+}
+
+/*
+ * Look up definition of identifier or keyword token, without updating
+ * __FILE__ and __LINE__.
+ */
+static struct macro *find_definition(struct token t)
+{
+    struct ident *id;
+
+    if (t.id) {
+        return ident_get(t.id)->macro;
+    }
+
+    id = ident_lookup(t.d.string);
+    return id ? id->macro : NULL;
+}
+
+INTERNAL const struct macro *macro_definition_of(struct token t)
+{
+    return update_definition(find_definition(t));
+}
+
 INTERNAL void define(struct macro macro)
 {
+    unsigned int id;
     struct macro *ref;
+    struct macro_op op;
     static String
         builtin__file__ = SHORT_STRING_INIT("__FILE__"),
         builtin__line__ = SHORT_STRING_INIT("__LINE__");
 
+    if (is_recording) {
+        op.is_undef = 0;
+        op.macro = macro;
+        op.macro.replacement = copy_token_array(&macro.replacement);
+        array_push_back(&snapshot, op);
+    }
+
     new_macro_added = 0;
     ref = hash_insert(&macro_hash_table, &macro);
     if (macrocmp(ref, &macro)) {
@@ -220,13 +319,108 @@ INTERNAL void define(struct macro macro)
             release_token_array(macro.replacement);
         }
     }
+
+    id = ident_register(str_raw(ref->name), str_len(ref->name));
+    ident_get(id)->macro = ref;
 }
 
 INTERNAL void undef(String name)
 {
+    struct ident *id;
+    struct macro_op op = {0};
+
+    if (is_recording) {
+        op.is_undef = 1;
+        op.macro.name = name;
+        array_push_back(&snapshot, op);
+    }
+
+    id = ident_lookup(name);
+    if (id) {
+        id->macro = NULL;
+    }
+
     hash_remove(&macro_hash_table, name);
 }
 
+INTERNAL void macro_snapshot_begin(void)
+{
+    assert(!array_len(&snapshot));
+    is_recording = 1;
+}
+
+INTERNAL void macro_snapshot_end(void)
+{
+    is_recording = 0;
+}
+
+INTERNAL void macro_snapshot_restore(void)
+{
+    int i;
+    struct macro m;
+    struct macro_op op;
+
+    for (i = 0; i < array_len(&snapshot); ++i) {
+        op = array_get(&snapshot, i);
+        if (op.is_undef) {
+            undef(op.macro.name);
+        } else {
+            m = op.macro;
+            m.replacement = copy_token_array(&op.macro.replacement);
+            define(m);
+        }
+    }
+}
+
+INTERNAL void macro_snapshot_write(FILE *stream)
+{
+    int i, j;
+    struct macro_op op;
+
+    pch_write_int(stream, array_len(&snapshot));
+    for (i = 0; i < array_len(&snapshot); ++i) {
+        op = array_get(&snapshot, i);
+        pch_write_int(stream, op.is_undef);
+        pch_write_string(stream, op.macro.name);
+        if (!op.is_undef) {
+            pch_write_int(stream, op.macro.type);
+            pch_write_int(stream, op.macro.params);
+            pch_write_int(stream, op.macro.is_vararg);
+            pch_write_int(stream, array_len(&op.macro.replacement));
+            for (j = 0; j < array_len(&op.macro.replacement); ++j) {
+                pch_write_token(stream, array_get(&op.macro.replacement, j));
+            }
+        }
+    }
+}
+
+INTERNAL void macro_snapshot_read(FILE *stream)
+{
+    long i, j, n, len;
+    struct macro_op op;
+
+    assert(!array_len(&snapshot));
+    n = pch_read_int(stream);
+    for (i = 0; i < n; ++i) {
+        memset(&op, 0, sizeof(op));
+        op.is_undef = pch_read_int(stream);
+        op.macro.name = pch_read_string(stream);
+        if (!op.is_undef) {
+            op.macro.type = pch_read_int(stream);
+            op.macro.params = pch_read_int(stream);
+            op.macro.is_vararg = pch_read_int(stream);
+            op.macro.replacement = get_token_array();
+            len = pch_read_int(stream);
+            for (j = 0; j < len; ++j) {
+                array_push_back(
+                    &op.macro.replacement,
+                    pch_read_token(stream));
+            }
+        }
+        array_push_back(&snapshot, op);
+    }
+}
+
 #if !NDEBUG
 void print_token_array(const TokenArray *list)
 {
@@ -272,12 +466,12 @@ static struct token paste(struct token left, struct token right)
     s1 = left.d.string;
     s2 = right.d.string;
 
-    buf = calloc(s1.len + s2.len + 1, sizeof(*buf));
-    strncpy(buf, str_raw(s1), s1.len);
-    strncpy(buf + s1.len, str_raw(s2), s2.len);
+    buf = calloc(str_len(s1) + str_len(s2) + 1, sizeof(*buf));
+    strncpy(buf, str_raw(s1), str_len(s1));
+    strncpy(buf + str_len(s1), str_raw(s2), str_len(s2));
 
     right = tokenize(buf, &endptr);
-    if (endptr != buf + s1.len + s2.len) {
+    if (endptr != buf + str_len(s1) + str_len(s2)) {
         error("Invalid token resulting from pasting '%s' and '%s'.",
             str_raw(s1), str_raw(s2));
         exit(1);
@@ -297,46 +491,6 @@ static enum token_type peek_token(const TokenArray *list, int i)
     return END;
 }
 
-/*
- * Replace content of list in segment [start, start + gaplength] with
- * contents of slice. The gap is from reading arguments from list, and
- * the slice is result of expanding it. Slice might be smaller or larger
- * than the gap.
- */ 
-static void array_replace_slice(
-    TokenArray *list,
-    unsigned start,
-    unsigned gaplength,
-    TokenArray *slice)
-{
-    unsigned length;
-    assert(start + gaplength <= array_len(list));
-
-    length = array_len(list) - gaplength + array_len(slice);
-    array_realloc(list, length);
-
-    /*
-     * Move trailing data out of the way, or move closer to prefix, to
-     * align exactly where slice is inserted.
-     */
-    if (array_len(slice) != gaplength) {
-        memmove(
-            list->data + start + array_len(slice),
-            list->data + start + gaplength,
-            (array_len(list) - (start + gaplength)) * sizeof(*list->data));
-    }
-
-    /* Copy slice directly into now vacant space in list. */
-    if (array_len(slice)) {
-        memcpy(
-            list->data + start,
-            slice->data,
-            array_len(slice) * sizeof(*list->data));
-    }
-
-    list->length = length;
-}
-
 /*
  * Replacing # <param> and <a> ## <b> is done in an initial scan of
  * the replacement list. This pass requires the parameters to not be
@@ -446,9 +600,9 @@ static TokenArray expand_macro(
     const struct macro *def,
     TokenArray *args)
 {
-    int i, j;
+    int i;
     struct token t;
-    TokenArray list;
+    TokenArray list, out;
 
     list = expand_stringify_and_paste(def, args);
     if (def->params > 0) {
@@ -462,19 +616,19 @@ static TokenArray expand_macro(
             }
         }
 
+        out = get_token_array();
         for (i = 0; i < array_len(&list); ++i) {
             t = array_get(&list, i);
             if (t.token == PARAM) {
-                j = t.d.val.i;
-                if (!array_len(&args[j])) {
-                    array_erase(&list, i);
-                    i--;
-                } else {
-                    array_replace_slice(&list, i, 1, &args[j]);
-                }
+                array_concat(&out, &args[t.d.val.i]);
+            } else {
+                array_push_back(&out, t);
             }
         }
 
+        release_token_array(list);
+        list = out;
+
         for (i = 0; i < def->params; ++i)
             release_token_array(args[i]);
         free(args);
@@ -500,6 +654,7 @@ static TokenArray read_arg(
 {
     int nesting = 0;
     struct token t;
+    const struct macro *def;
     TokenArray arg = get_token_array();
 
     while (nesting
@@ -519,8 +674,11 @@ static TokenArray read_arg(
             }
         }
         t = *list++;
-        if (t.is_expandable && is_expanded(scope, t.d.string)) {
-            t.disable_expand = 1;
+        if (t.is_expandable && !t.disable_expand) {
+            def = find_definition(t);
+            if (def && is_expanded(scope, def)) {
+                t.disable_expand = 1;
+            }
         }
         array_push_back(&arg, t);
     }
@@ -581,25 +739,89 @@ static TokenArray *read_args(
     return args;
 }
 
+/*
+ * Count argument tokens substituted for parameters in the replacement
+ * list, before the arguments are themselves expanded.
+ */
+static unsigned count_argument_tokens(
+    const struct macro *def,
+    const TokenArray *args)
+{
+    int i;
+    unsigned n;
+    struct token t;
+
+    for (n = 0, i = 0; i < array_len(&def->replacement); ++i) {
+        t = array_get(&def->replacement, i);
+        if (t.token == PARAM) {
+            n += array_len(&args[t.d.val.i]);
+        }
+    }
+
+    return n;
+}
+
+/*
+ * Determine whether parenthesis at position i is closed later in the
+ * list. Lines being preprocessed can end in the middle of a macro
+ * invocation, in which case more input is read before expanding.
+ */
+static int is_closed_paren(const TokenArray *list, int i)
+{
+    int nest;
+    struct token t;
+
+    assert(array_get(list, i).token == '(');
+    for (nest = 1, i = i + 1; i < array_len(list); ++i) {
+        t = array_get(list, i);
+        if (t.token == '(') {
+            nest++;
+        } else if (t.token == ')' && !--nest) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/* Append tokens in range [from, to) of list to out. */
+static void append_tokens(
+    TokenArray *out,
+    const TokenArray *list,
+    int from,
+    int to)
+{
+    for (; from < to; ++from) {
+        array_push_back(out, array_get(list, from));
+    }
+}
+
+/*
+ * Expand all macros in list. Tokens are copied to a new array as
+ * expansions are found, instead of shifting the remainder of the list
+ * on each expansion, to keep expansion of long lines linear.
+ */
 static int expand_line(ExpandStack *scope, TokenArray *list)
 {
-    int size, i, n;
+    int i, j, n, end, start;
+    unsigned copied;
     struct token t;
-    const struct macro *def;
+    struct macro *def;
     const struct token *endptr;
-    TokenArray *args, expn;
+    TokenArray *args, expn, out = {0};
 
-    for (n = 0, i = 0; i < array_len(list); ++i) {
+    for (n = 0, i = 0, start = 0, end = 0; i < array_len(list); ++i) {
+        end = 0;
         t = array_get(list, i);
         if (!t.is_expandable || t.disable_expand) {
             continue;
         }
 
-        def = macro_definition(t.d.string);
+        def = find_definition(t);
         if (!def)
             continue;
 
-        if (is_expanded(scope, t.d.string)) {
+        if (is_expanded(scope, def)) {
             array_get(list, i).disable_expand = 1;
             continue;
         }
@@ -609,27 +831,73 @@ static int expand_line(ExpandStack *scope, TokenArray *list)
             && (i == array_len(list) - 1
                 || array_get(list, i + 1).token != '('))
         {
+            end = i == array_len(list) - 1;
             continue;
         }
 
+        if (context.profile_macros) {
+            trace_macro_begin();
+        }
+
+        update_definition(def);
         args = read_args(scope, def, list->data + i + 1, &endptr);
-        array_push_back(scope, def->name);
+        copied = context.profile_macros ? count_argument_tokens(def, args) : 0;
+        push_expansion(scope, def);
         expn = expand_macro(scope, def, args);
-        size = (endptr - list->data) - i;
-        (void) array_pop_back(scope);
+        if (context.profile_macros) {
+            trace_macro_end(
+                def->name,
+                array_len(&scope->macros),
+                array_len(&expn),
+                copied);
+        }
+
+        pop_expansion(scope);
 
         /* Fix leading whitespace after expansion. */
         if (array_len(&expn)) {
             expn.data[0].leading_whitespace = t.leading_whitespace;
         }
 
-        /* Squeeze in expansion in list. */
-        array_replace_slice(list, i, size, &expn);
-        i += array_len(&expn) - 1;
+        if (!n) {
+            out = get_token_array();
+        }
+
+        append_tokens(&out, list, start, i);
+        array_concat(&out, &expn);
         release_token_array(expn);
         n += 1;
+
+        /*
+         * Continue after the invocation. A function-like macro name at
+         * the end of the expansion is scanned again if arguments follow
+         * in the rest of the list, moving it back to the consumed slot
+         * just before.
+         */
+        j = endptr - list->data;
+        if (scope->ends_with_name) {
+            if (j < array_len(list)
+                && array_get(list, j).token == '('
+                && is_closed_paren(list, j))
+            {
+                j -= 1;
+                array_get(list, j) = array_pop_back(&out);
+            } else {
+                end = j == array_len(list);
+            }
+        }
+
+        start = j;
+        i = j - 1;
+    }
+
+    if (n) {
+        append_tokens(&out, list, start, array_len(list));
+        release_token_array(*list);
+        *list = out;
     }
 
+    scope->ends_with_name = end;
     return n;
 }
 
@@ -657,6 +925,8 @@ INTERNAL int tok_cmp(struct token a, struct token b)
             (is_unsigned(a.type)) ?
                 a.d.val.u != b.d.val.u :
                 a.d.val.i != b.d.val.i;
+    } else if (a.id && b.id) {
+        return a.id != b.id;
     } else {
         return str_cmp(a.d.string, b.d.string);
     }
@@ -690,9 +960,12 @@ static char *stringify_concat(
 
     assert(tok.token != NUMBER);
     str = tok.d.string;
-    len = (tok.leading_whitespace != 0) + str.len * 2;
+    len = (tok.leading_whitespace != 0) + str_len(str) * 2 + 4;
     if (*pos + len > *cap) {
-        *cap = *pos + len;
+        *cap = *cap * 2;
+        if (*pos + len > *cap) {
+            *cap = *pos + len;
+        }
         buf = realloc(buf, *cap);
     }
 
@@ -707,18 +980,18 @@ static char *stringify_concat(
     case STRING:
         *ptr++ = '\\';
         *ptr++ = '"';
-        ptr = str_write_escaped(ptr, raw, str.len);
+        ptr = str_write_escaped(ptr, raw, str_len(str));
         *ptr++ = '\\';
         *ptr++ = '"';
         break;
     case PREP_CHAR:
         *ptr++ = '\'';
-        ptr = str_write_escaped(ptr, raw, str.len);
+        ptr = str_write_escaped(ptr, raw, str_len(str));
         *ptr++ = '\'';
         break;
     default:
-        memcpy(ptr, raw, str.len);
-        ptr += str.len;
+        memcpy(ptr, raw, str_len(str));
+        ptr += str_len(str);
         break;
     }
 
@@ -5,6 +5,8 @@
 #include <lacc/context.h>
 #include <lacc/token.h>
 
+#include <stdio.h>
+
 typedef array_of(struct token) TokenArray;
 
 /* Get empty token array, possibly already allocated with capacity. */
@@ -28,6 +30,9 @@ struct macro {
     unsigned int is__file__ : 1;
     unsigned int is_vararg : 1;
 
+    /* Serial number of innermost scope expanding the macro, if any. */
+    unsigned long expand_scope;
+
     /*
      * A substitution is either a token or a parameter, and parameters
      * are represented by PARAM tokens with an integer index between
@@ -66,9 +71,31 @@ INTERNAL void define(struct macro macro);
  */
 INTERNAL void undef(String name);
 
+/*
+ * Record calls to define and undef until macro_snapshot_end, such that
+ * the same changes can be applied again by macro_snapshot_restore in a
+ * later translation unit.
+ */
+INTERNAL void macro_snapshot_begin(void);
+INTERNAL void macro_snapshot_end(void);
+INTERNAL void macro_snapshot_restore(void);
+
+/*
+ * Write recorded changes to precompiled header, or read them back to be
+ * applied by macro_snapshot_restore.
+ */
+INTERNAL void macro_snapshot_write(FILE *stream);
+INTERNAL void macro_snapshot_read(FILE *stream);
+
 /* Look up definition of identifier, or NULL if not defined. */
 INTERNAL const struct macro *macro_definition(String name);
 
+/*
+ * Look up definition of identifier or keyword token, through interned
+ * identifier object if the token has one.
+ */
+INTERNAL const struct macro *macro_definition_of(struct token t);
+
 /*
  * Expand a list of tokens, replacing any macro definitions. Mutates
  * input list as necessary. Return non-zero if any macro was expanded.
@@ -0,0 +1,192 @@
+#if !AMALGAMATION
+# define INTERNAL
+# define EXTERNAL extern
+#endif
+#include "strtab.h"
+#include <lacc/context.h>
+#include <lacc/pch.h>
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PCH_MAGIC "lacc-pch"
+#define PCH_VERSION 4
+
+/* Flags stored with each token. */
+#define PCH_EXPANDABLE 1
+#define PCH_DISABLE_EXPAND 2
+#define PCH_IDENT 4
+
+static void pch_read(FILE *stream, void *ptr, size_t size)
+{
+    if (size && fread(ptr, size, 1, stream) != 1) {
+        error("Unexpected end of precompiled header.");
+        exit(1);
+    }
+}
+
+static size_t pch_read_length(FILE *stream)
+{
+    long len;
+
+    len = pch_read_int(stream);
+    if (len < 0) {
+        error("Invalid string length in precompiled header.");
+        exit(1);
+    }
+
+    return len;
+}
+
+INTERNAL void pch_write_int(FILE *stream, long value)
+{
+    fwrite(&value, sizeof(value), 1, stream);
+}
+
+INTERNAL long pch_read_int(FILE *stream)
+{
+    long value;
+
+    pch_read(stream, &value, sizeof(value));
+    return value;
+}
+
+INTERNAL void pch_write_chars(FILE *stream, const char *str)
+{
+    size_t len;
+
+    len = strlen(str);
+    pch_write_int(stream, len);
+    fwrite(str, 1, len, stream);
+}
+
+INTERNAL char *pch_read_chars(FILE *stream)
+{
+    size_t len;
+    char *str;
+
+    len = pch_read_length(stream);
+    str = calloc(len + 1, sizeof(*str));
+    pch_read(stream, str, len);
+    return str;
+}
+
+INTERNAL void pch_write_string(FILE *stream, String str)
+{
+    pch_write_int(stream, str_len(str));
+    fwrite(str_raw(str), 1, str_len(str), stream);
+}
+
+INTERNAL String pch_read_string(FILE *stream)
+{
+    size_t len;
+    String str;
+    char buf[SHORT_STRING_LEN], *ptr;
+
+    len = pch_read_length(stream);
+    ptr = (len < SHORT_STRING_LEN) ? buf : malloc(len);
+    pch_read(stream, ptr, len);
+    str = str_register(ptr, len);
+    if (ptr != buf) {
+        free(ptr);
+    }
+
+    return str;
+}
+
+INTERNAL void pch_write_type(FILE *stream, Type type)
+{
+    fwrite(&type, sizeof(type), 1, stream);
+}
+
+INTERNAL Type pch_read_type(FILE *stream)
+{
+    Type type;
+
+    pch_read(stream, &type, sizeof(type));
+    return type;
+}
+
+INTERNAL void pch_write_value(FILE *stream, union value val)
+{
+    fwrite(&val, sizeof(val), 1, stream);
+}
+
+INTERNAL union value pch_read_value(FILE *stream)
+{
+    union value val;
+
+    pch_read(stream, &val, sizeof(val));
+    return val;
+}
+
+INTERNAL void pch_write_token(FILE *stream, struct token t)
+{
+    int flags;
+
+    flags = 0;
+    if (t.is_expandable) flags |= PCH_EXPANDABLE;
+    if (t.disable_expand) flags |= PCH_DISABLE_EXPAND;
+    if (t.id) flags |= PCH_IDENT;
+
+    pch_write_int(stream, t.token);
+    pch_write_int(stream, t.leading_whitespace);
+    pch_write_int(stream, flags);
+    pch_write_type(stream, t.type);
+    if (t.token == NUMBER || t.token == PARAM) {
+        pch_write_value(stream, t.d.val);
+    } else {
+        pch_write_string(stream, t.d.string);
+    }
+}
+
+INTERNAL struct token pch_read_token(FILE *stream)
+{
+    int flags;
+    struct token t = {0};
+
+    t.token = pch_read_int(stream);
+    t.leading_whitespace = pch_read_int(stream);
+    flags = pch_read_int(stream);
+    t.is_expandable = (flags & PCH_EXPANDABLE) != 0;
+    t.disable_expand = (flags & PCH_DISABLE_EXPAND) != 0;
+    t.type = pch_read_type(stream);
+    if (t.token == NUMBER || t.token == PARAM) {
+        t.d.val = pch_read_value(stream);
+    } else {
+        t.d.string = pch_read_string(stream);
+        if (flags & PCH_IDENT) {
+            t.id = ident_register(str_raw(t.d.string), str_len(t.d.string));
+        }
+    }
+
+    return t;
+}
+
+/*
+ * Magic string is followed by version, and size of structures written
+ * in native layout.
+ */
+INTERNAL void pch_write_header(FILE *stream)
+{
+    fwrite(PCH_MAGIC, 1, sizeof(PCH_MAGIC), stream);
+    pch_write_int(stream, PCH_VERSION);
+    pch_write_int(stream, sizeof(Type));
+    pch_write_int(stream, sizeof(union value));
+}
+
+INTERNAL int pch_read_header(FILE *stream)
+{
+    char magic[sizeof(PCH_MAGIC)];
+
+    if (fread(magic, sizeof(magic), 1, stream) != 1
+        || memcmp(magic, PCH_MAGIC, sizeof(magic)))
+    {
+        return 0;
+    }
+
+    return pch_read_int(stream) == PCH_VERSION
+        && pch_read_int(stream) == sizeof(Type)
+        && pch_read_int(stream) == sizeof(union value);
+}
@@ -0,0 +1,223 @@
+#if !AMALGAMATION
+# define INTERNAL
+# define EXTERNAL extern
+#endif
+#include "pipeline.h"
+#include <lacc/context.h>
+
+#include <pthread.h>
+#include <assert.h>
+#include <stdlib.h>
+
+/* Number of tokens that can be buffered between the threads. */
+#define PIPELINE_SIZE 4096
+
+/*
+ * Minimum number of tokens available before waking up the reader, also
+ * used as free space needed before waking up the writer.
+ */
+#define PIPELINE_WAKE 512
+
+/*
+ * Token in the queue. Only the last token in a batch carries the input
+ * location.
+ */
+struct pipe_token {
+    struct token token;
+    String path;
+    int line;
+    int is_last;
+};
+
+static struct pipe_token pipeline_ring[PIPELINE_SIZE];
+
+/*
+ * Position of next token to read and write, and number of tokens in the
+ * queue. Guarded by lock, with waiting on empty and full queue signaled
+ * through condition variables. Only signal if the other thread is
+ * waiting, and enough tokens or space is available, to avoid switching
+ * between the threads for every line.
+ */
+static unsigned head, tail, count;
+static int is_reader_waiting, is_writer_waiting;
+static pthread_mutex_t pipeline_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t not_empty = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t not_full = PTHREAD_COND_INITIALIZER;
+
+static pthread_t pipeline_thread;
+static int is_running, is_stopped;
+
+/*
+ * Identity of the producer thread, recorded by the thread itself before
+ * producing anything. The handle written by pthread_create may not be
+ * set yet when the new thread starts running.
+ */
+static pthread_t producer_thread;
+static int is_producer_started;
+
+static void *run_producer(void *arg)
+{
+    void (*producer)(void);
+
+    pthread_mutex_lock(&pipeline_lock);
+    producer_thread = pthread_self();
+    is_producer_started = 1;
+    pthread_mutex_unlock(&pipeline_lock);
+    producer = *((void (**)(void)) arg);
+    producer();
+    return NULL;
+}
+
+INTERNAL void pipeline_start(void (*producer)(void))
+{
+    static void (*function)(void);
+
+    assert(!is_running);
+    head = tail = count = 0;
+    is_reader_waiting = is_writer_waiting = 0;
+    is_stopped = 0;
+    function = producer;
+    is_running = 1;
+    if (pthread_create(&pipeline_thread, NULL, run_producer, &function)) {
+        is_running = 0;
+        error("Unable to create preprocessor pipeline_thread.");
+        exit(1);
+    }
+}
+
+INTERNAL int pipeline_write(
+    const struct token *tokens,
+    unsigned n,
+    String path,
+    int line)
+{
+    unsigned i;
+    struct pipe_token *slot;
+
+    assert(n > 0);
+    pthread_mutex_lock(&pipeline_lock);
+    for (i = 0; i < n; ++i) {
+        while (count == PIPELINE_SIZE && !is_stopped) {
+            if (is_reader_waiting) {
+                pthread_cond_signal(&not_empty);
+            }
+            is_writer_waiting = 1;
+            pthread_cond_wait(&not_full, &pipeline_lock);
+            is_writer_waiting = 0;
+        }
+
+        if (is_stopped) {
+            break;
+        }
+
+        slot = &pipeline_ring[tail];
+        slot->token = tokens[i];
+        slot->is_last = (i == n - 1);
+        if (slot->is_last) {
+            slot->path = path;
+            slot->line = line;
+        }
+
+        tail = (tail + 1) % PIPELINE_SIZE;
+        count++;
+    }
+
+    if (is_reader_waiting
+        && (count >= PIPELINE_WAKE || tokens[n - 1].token == END))
+    {
+        pthread_cond_signal(&not_empty);
+    }
+
+    pthread_mutex_unlock(&pipeline_lock);
+    return i == n;
+}
+
+INTERNAL int pipeline_read(
+    struct token *buffer,
+    unsigned *n,
+    String *path,
+    int *line)
+{
+    unsigned i;
+    int is_last;
+    struct pipe_token *slot;
+
+    assert(is_running);
+    assert(*n > 0);
+    pthread_mutex_lock(&pipeline_lock);
+    while (!count) {
+        if (is_writer_waiting) {
+            pthread_cond_signal(&not_full);
+        }
+        is_reader_waiting = 1;
+        pthread_cond_wait(&not_empty, &pipeline_lock);
+        is_reader_waiting = 0;
+    }
+
+    for (i = 0, is_last = 0; i < *n && count && !is_last; ++i) {
+        slot = &pipeline_ring[head];
+        buffer[i] = slot->token;
+        head = (head + 1) % PIPELINE_SIZE;
+        count--;
+        is_last = slot->is_last;
+        if (is_last) {
+            *path = slot->path;
+            *line = slot->line;
+        }
+    }
+
+    if (is_writer_waiting && PIPELINE_SIZE - count >= PIPELINE_WAKE) {
+        pthread_cond_signal(&not_full);
+    }
+
+    pthread_mutex_unlock(&pipeline_lock);
+    *n = i;
+    return is_last;
+}
+
+INTERNAL int pipeline_is_producer(void)
+{
+    int is_producer;
+
+    pthread_mutex_lock(&pipeline_lock);
+    is_producer = is_producer_started
+        && pthread_equal(pthread_self(), producer_thread);
+    pthread_mutex_unlock(&pipeline_lock);
+    return is_producer;
+}
+
+INTERNAL void pipeline_begin_diagnostic(void)
+{
+    pthread_mutex_lock(&pipeline_lock);
+    while ((count || !is_reader_waiting) && !is_stopped) {
+        if (count && is_reader_waiting) {
+            pthread_cond_signal(&not_empty);
+        }
+        is_writer_waiting = 1;
+        pthread_cond_wait(&not_full, &pipeline_lock);
+        is_writer_waiting = 0;
+    }
+
+    if (is_stopped) {
+        pthread_mutex_unlock(&pipeline_lock);
+        pthread_exit(NULL);
+    }
+}
+
+INTERNAL void pipeline_end_diagnostic(void)
+{
+    pthread_mutex_unlock(&pipeline_lock);
+}
+
+INTERNAL void pipeline_stop(void)
+{
+    if (is_running) {
+        pthread_mutex_lock(&pipeline_lock);
+        is_stopped = 1;
+        pthread_cond_signal(&not_full);
+        pthread_mutex_unlock(&pipeline_lock);
+        pthread_join(pipeline_thread, NULL);
+        is_producer_started = 0;
+        is_running = 0;
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <lacc/string.h>
+#include <lacc/token.h>
+
+/*
+ * Bounded single producer, single consumer queue of tokens, used to run
+ * preprocessing on a separate thread with -fpreprocess-thread. Tokens
+ * are written in batches, each stamped with the input location after
+ * the batch was produced, which the consumer uses for diagnostics.
+ */
+INTERNAL void pipeline_start(void (*producer)(void));
+
+/*
+ * Write a batch of tokens, blocking while the queue is full. Return 0
+ * if the pipeline is stopped, in which case the producer should return
+ * without writing more.
+ */
+INTERNAL int pipeline_write(
+    const struct token *tokens,
+    unsigned n,
+    String path,
+    int line);
+
+/*
+ * Read at most n tokens, stopping at the end of a batch. Block until at
+ * least one token is available, and update n to the number of tokens
+ * read. Return non-zero if the end of a batch is reached, in which case
+ * the location is updated.
+ */
+INTERNAL int pipeline_read(
+    struct token *buffer,
+    unsigned *n,
+    String *path,
+    int *line);
+
+/* Determine whether the caller is running on the producer thread. */
+INTERNAL int pipeline_is_producer(void);
+
+/*
+ * Called on the producer thread before writing a diagnostic message.
+ * Wait until the consumer has read all tokens written so far and asks
+ * for more, such that messages are ordered with the diagnostics of the
+ * consumer as when running in sequence. The consumer is kept waiting
+ * until pipeline_end_diagnostic. If the pipeline is stopped, the
+ * message would never be reached, and the producer thread exits.
+ */
+INTERNAL void pipeline_begin_diagnostic(void);
+
+/* Let the consumer continue after writing a diagnostic message. */
+INTERNAL void pipeline_end_diagnostic(void);
+
+/* Stop producer if still running, and wait for the thread to finish. */
+INTERNAL void pipeline_stop(void);
+
+#endif
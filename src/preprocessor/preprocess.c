@@ -5,11 +5,14 @@
 #include "directive.h"
 #include "input.h"
 #include "macro.h"
+#include "pipeline.h"
 #include "preprocess.h"
 #include "strtab.h"
 #include "tokenize.h"
+#include "trace.h"
 #include <lacc/context.h>
 #include <lacc/deque.h>
+#include <lacc/pch.h>
 
 #include <assert.h>
 #include <ctype.h>
@@ -22,19 +25,136 @@
  */
 static deque_of(struct token) lookahead;
 
+/*
+ * Adjacent string literals are joined in a buffer, and only the final
+ * result is registered when the next token is added or the line is
+ * complete. This keeps joining many literals linear, and avoids storing
+ * each intermediate prefix in the string table.
+ */
+static char *join_buffer;
+static size_t join_length, join_capacity;
+static int is_joining;
+
+/*
+ * With -fpreprocess-thread, lookahead is filled by the preprocessor
+ * thread and written to the pipeline. The parser reads tokens from the
+ * pipeline into this buffer instead, together with the location where
+ * the preprocessor was after producing them.
+ */
+static deque_of(struct token) received;
+static int is_pipelined, is_received_end;
+static String received_path;
+static int received_line;
+
 /* Toggle for producing preprocessed output (-E). */
 static int output_preprocessed;
 
-/* Line currently being tokenized. */
-static char *line_buffer;
+/*
+ * Location of the line last read, recorded for line markers in the
+ * preprocessed output. The lookahead buffer holds at most one line of
+ * tokens when producing output, and a line spanning multiple lines in
+ * the source file is placed on the last of them, same as diagnostics.
+ */
+static String origin_path;
+static int origin_line;
 
-INTERNAL void preprocess_reset(void)
+/*
+ * Preprocessed output is formatted into a large buffer, and written in
+ * whole blocks instead of once per token.
+ */
+static FILE *output_stream;
+static char output_buffer[0x10000];
+static size_t output_length;
+
+/*
+ * Include stack as last described by line markers, and path and line
+ * number of the next line written. Keep the origin of the previous line
+ * to avoid repeating markers when one line in the source file is split
+ * over several in the output, like for pragma directives.
+ */
+struct line_marker {
+    unsigned id;
+    String path;
+    int line;
+    int sys;
+};
+
+static array_of(struct line_marker) marker_stack;
+static String output_path;
+static int output_line, output_origin;
+
+/*
+ * Line currently being tokenized. Points directly into the input source
+ * if line is read without initial preprocessing.
+ */
+static const char *line_buffer;
+static int line_is_raw;
+
+/*
+ * Tokens of current line if read from token cache. Otherwise, if the
+ * line is recorded for the cache, tokens produced so far.
+ */
+static const struct token *line_tokens;
+static int line_is_recorded;
+static TokenArray recorded_tokens;
+
+/* Stop reading the current line, ignoring any remaining tokens. */
+static void discard_line(void)
 {
     line_buffer = NULL;
+    line_tokens = NULL;
+    line_is_recorded = 0;
+    array_empty(&recorded_tokens);
+}
+
+/*
+ * With -fsnapshot-include, files given by -include are only read for
+ * the first input file. Tokens produced, and changes to macros, are
+ * recorded, and replayed for subsequent input files in place of reading
+ * the same files again. Strings and identifiers registered up to that
+ * point are kept in the string table. Replayed tokens have no location
+ * to write line markers for, so -E output only uses snapshots with -P.
+ *
+ * A snapshot can also be loaded from a precompiled header given by
+ * -include-pch, replayed for every input file. Tokens are recorded for
+ * the whole input when writing a precompiled header.
+ */
+static enum {
+    SNAPSHOT_NONE,
+    SNAPSHOT_RECORDING,
+    SNAPSHOT_READY,
+    SNAPSHOT_DISABLED,
+    SNAPSHOT_PCH
+} snapshot_state;
+
+static array_of(struct token) snapshot_tokens;
+static int is_snapshot_pending;
+
+/* Original header to include if precompiled header cannot be used. */
+static char *pch_header_path;
+
+/*
+ * Location of declarations written by the parser, read again for every
+ * input file. Offset is zero if the header is replayed as tokens.
+ */
+static char *pch_path;
+static long pch_declarations;
+
+INTERNAL void preprocess_reset(void)
+{
+    if (is_pipelined) {
+        pipeline_stop();
+        deque_empty(&received);
+        is_pipelined = 0;
+        is_received_end = 0;
+    }
+
+    discard_line();
     macro_reset();
     strtab_reset();
     tokenize_reset();
     deque_empty(&lookahead);
+    is_snapshot_pending = (snapshot_state == SNAPSHOT_READY);
 }
 
 INTERNAL void preprocess_finalize(void)
@@ -42,30 +162,138 @@ INTERNAL void preprocess_finalize(void)
     preprocess_reset();
     input_finalize();
     macro_finalize();
+    strtab_finalize();
+    array_clear(&snapshot_tokens);
+    array_clear(&recorded_tokens);
+    free(pch_header_path);
+    free(pch_path);
+    free(join_buffer);
+    array_clear(&marker_stack);
+    trace_finalize();
     deque_destroy(&lookahead);
+    deque_destroy(&received);
+}
+
+/*
+ * Called before and after reading a new line of input. Start recording
+ * if about to read the first line of files given by -include, and stop
+ * when input continues in the main source file. For later input files,
+ * replay the snapshot before reading the first line.
+ */
+static void update_snapshot(void)
+{
+    int i;
+
+    switch (snapshot_state) {
+    case SNAPSHOT_NONE:
+        if (context.snapshot_include
+            && is_reading_include_files()
+            && (context.target != TARGET_PREPROCESS || context.no_linemarkers))
+        {
+            macro_snapshot_begin();
+            snapshot_state = SNAPSHOT_RECORDING;
+        } else {
+            snapshot_state = SNAPSHOT_DISABLED;
+        }
+        break;
+    case SNAPSHOT_RECORDING:
+        if (!is_reading_include_files()) {
+            macro_snapshot_end();
+            strtab_mark();
+            save_header_state();
+            clear_include_files();
+            snapshot_state = SNAPSHOT_READY;
+        }
+        break;
+    case SNAPSHOT_READY:
+        if (is_snapshot_pending) {
+            is_snapshot_pending = 0;
+            macro_snapshot_restore();
+            restore_header_state();
+            for (i = 0; i < array_len(&snapshot_tokens); ++i) {
+                deque_push_back(&lookahead, array_get(&snapshot_tokens, i));
+            }
+        }
+        break;
+    default:
+        break;
+    }
 }
 
 static struct token get_token(void)
 {
     struct token r;
-    char *endptr;
+    const char *endptr;
 
-    if (!line_buffer && (line_buffer = getprepline()) == NULL) {
-        r = basic_token[END];
-    } else {
-        r = tokenize(line_buffer, (const char **) &endptr);
-        line_buffer = endptr;
+    if (!line_buffer) {
+        if (snapshot_state != SNAPSHOT_DISABLED) {
+            update_snapshot();
+        }
+        line_buffer = context.fused_lexer ? getrawline() : NULL;
+        line_is_raw = line_buffer != NULL;
+        if (!line_is_raw) {
+            line_buffer = getprepline();
+            line_tokens = getlinetokens();
+            line_is_recorded = is_line_recorded();
+        }
+        if (snapshot_state != SNAPSHOT_DISABLED) {
+            update_snapshot();
+        }
+        if (!line_buffer) {
+            return basic_token[END];
+        }
+    }
+
+    if (line_tokens) {
+        r = *line_tokens++;
         if (r.token == END) {
-            /*
-             * Newlines are removed by getprepline, and never present in
-             * the input data. Instead intercept end of string, which
-             * represents end of line.
-             */
-            line_buffer = NULL;
+            discard_line();
             r = basic_token[NEWLINE];
+        } else if (context.trace_includes) {
+            trace_include_token();
+        }
+        return r;
+    }
+
+    if (line_is_raw && !tokenize_raw(line_buffer, &endptr, &r)) {
+        /*
+         * Fall back to initial preprocessing of the rest of the line
+         * when encountering line continuations, trigraphs or comments
+         * spanning multiple lines.
+         */
+        line_buffer = getprepline_rest(line_buffer);
+        line_is_raw = 0;
+    }
+
+    if (!line_is_raw) {
+        r = tokenize(line_buffer, &endptr);
+    }
+
+    line_buffer = endptr;
+    if (line_is_recorded) {
+        if (r.token == END) {
+            set_line_tokens(
+                recorded_tokens.data,
+                array_len(&recorded_tokens));
+            line_is_recorded = 0;
+            array_empty(&recorded_tokens);
+        } else {
+            array_push_back(&recorded_tokens, r);
         }
     }
 
+    if (r.token == END) {
+        /*
+         * Newlines are removed by getprepline, and never present in
+         * the input data. Instead intercept end of string, which
+         * represents end of line.
+         */
+        line_buffer = NULL;
+        r = basic_token[NEWLINE];
+    } else if (context.trace_includes) {
+        trace_include_token();
+    }
+
     return r;
 }
 
@@ -179,7 +407,7 @@ static void read_defined_operator(TokenArray *line)
         exit(1);
     }
 
-    if (macro_definition(t.d.string))
+    if (macro_definition_of(t))
         t = tokenize("1", &endptr);
     else
         t = tokenize("0", &endptr);
@@ -278,7 +506,7 @@ static int read_complete_line(TokenArray *line, struct token t, int directive)
                 array_push_back(line, t);
                 read_Pragma_invocation(line);
             } else {
-                def = macro_definition(t.d.string);
+                def = macro_definition_of(t);
                 if (def) {
                     macros += 1;
                     if (def->type == FUNCTION_LIKE) {
@@ -326,7 +554,7 @@ static int refill_expanding_line(TokenArray *line)
     for (i = 0, n = 0; i < len; ++i) {
         t = array_get(line, i);
         if (t.is_expandable && !t.disable_expand) {
-            def = macro_definition(t.d.string);
+            def = macro_definition_of(t);
             if (def && def->type == FUNCTION_LIKE) {
                 i += skip_or_read_expansion(line, i + 1);
                 n += 1;
@@ -379,6 +607,42 @@ static const char *stringify_token(const struct token *t)
     }
 }
 
+static void join_string(String str)
+{
+    size_t len;
+
+    len = str_len(str);
+    if (join_length + len > join_capacity) {
+        join_capacity = join_capacity * 2;
+        if (join_capacity < join_length + len) {
+            join_capacity = join_length + len;
+        }
+        join_buffer = realloc(join_buffer, join_capacity);
+    }
+
+    memcpy(join_buffer + join_length, str_raw(str), len);
+    join_length += len;
+}
+
+static void finish_join(void)
+{
+    struct token *t;
+
+    assert(is_joining);
+    assert(deque_back(&lookahead).token == STRING);
+    t = &deque_back(&lookahead);
+    t->d.string = str_register(join_buffer, join_length);
+    if ((snapshot_state == SNAPSHOT_RECORDING
+            || snapshot_state == SNAPSHOT_PCH)
+        && array_len(&snapshot_tokens))
+    {
+        array_back(&snapshot_tokens) = *t;
+    }
+
+    is_joining = 0;
+    join_length = 0;
+}
+
 /*
  * Add preprocessed token to lookahead buffer, ready to be consumed by
  * the parser.
@@ -405,8 +669,11 @@ static void add_to_lookahead(struct token t)
             if (deque_len(&lookahead)) {
                 prev = deque_back(&lookahead);
                 if (prev.token == STRING) {
-                    t.d.string = str_cat(prev.d.string, t.d.string);
-                    deque_back(&lookahead) = t;
+                    if (!is_joining) {
+                        join_string(prev.d.string);
+                        is_joining = 1;
+                    }
+                    join_string(t.d.string);
                     goto added;
                 }
             }
@@ -415,7 +682,16 @@ static void add_to_lookahead(struct token t)
         }
     }
 
+    if (is_joining) {
+        finish_join();
+    }
+
     deque_push_back(&lookahead, t);
+    if (snapshot_state == SNAPSHOT_RECORDING
+        || snapshot_state == SNAPSHOT_PCH)
+    {
+        array_push_back(&snapshot_tokens, t);
+    }
 
 added:
     if (context.verbose) {
@@ -456,6 +732,12 @@ static void preprocess_pragma(TokenArray *line)
 
     assert(array_len(line) > 0);
     assert(!tok_cmp(ident__pragma, array_get(line, 0)));
+    if (array_len(line) > 1 && !tok_cmp(array_get(line, 1), ident__once)) {
+        set_pragma_once();
+        return;
+    }
+
+    include_guard_invalidate();
     if (output_preprocessed) {
         add_to_lookahead(basic_token[NEWLINE]);
         add_to_lookahead(basic_token['#']);
@@ -486,7 +768,7 @@ static const char *destringize(String str)
     size_t len;
     const char *raw;
 
-    len = str.len;
+    len = str_len(str);
     raw = str_raw(str);
     if (len + 1 > dstr_length) {
         dstr_length = len + 1;
@@ -583,10 +865,13 @@ static void preprocess_line(int n)
                     preprocess_directive(&line);
                 }
             } else {
-                line_buffer = NULL;
+                discard_line();
             }
         } else {
             assert(in_active_block());
+            if (t.token != NEWLINE) {
+                include_guard_invalidate();
+            }
             i = read_complete_line(&line, t, 0);
             while (i && expand(&line)) {
                 i = refill_expanding_line(&line);
@@ -601,27 +886,142 @@ static void preprocess_line(int n)
                 }
             }
         }
+        if (output_preprocessed) {
+            origin_path = current_file_path;
+            origin_line = current_file_line;
+        }
     } while (!is_lookahead_ready(n));
 
     while (deque_len(&lookahead) < n) {
         add_to_lookahead(basic_token[END]);
     }
+
+    if (is_joining) {
+        finish_join();
+    }
 }
 
 INTERNAL void inject_line(char *line)
 {
     assert(!line_buffer);
     line_buffer = line;
+    line_is_raw = 0;
     preprocess_line(0);
     while (deque_len(&lookahead) && deque_back(&lookahead).token == END) {
         (void) deque_pop_back(&lookahead);
     }
 
-    line_buffer = NULL;
+    discard_line();
+}
+
+/*
+ * Run on the preprocessor thread, writing tokens to the pipeline a line
+ * at a time until the end of input. File names are copied to the string
+ * table, as included files can be closed before the parser reads them.
+ */
+static void produce_tokens(void)
+{
+    int is_end;
+    String path = {0};
+
+    do {
+        preprocess_line(1);
+        is_end = deque_back(&lookahead).token == END;
+        if (str_cmp(path, current_file_path)) {
+            path = str_register(
+                str_raw(current_file_path),
+                str_len(current_file_path));
+        }
+        if (!pipeline_write(
+            &deque_get(&lookahead, 0),
+            deque_len(&lookahead),
+            path,
+            current_file_line))
+        {
+            break;
+        }
+        deque_empty(&lookahead);
+    } while (!is_end);
+}
+
+/*
+ * Read from pipeline until there are at least n tokens received. The
+ * thread is done after writing END, and further reads are padded with
+ * END like when preprocessing in sequence.
+ */
+static void receive_tokens(int n)
+{
+    int i, is_last;
+    unsigned len;
+    struct token buf[256];
+
+    while (deque_len(&received) < n) {
+        if (is_received_end) {
+            deque_push_back(&received, basic_token[END]);
+            continue;
+        }
+
+        do {
+            len = sizeof(buf) / sizeof(buf[0]);
+            is_last = pipeline_read(
+                buf,
+                &len,
+                &received_path,
+                &received_line);
+            for (i = 0; i < len; ++i) {
+                deque_push_back(&received, buf[i]);
+            }
+        } while (!is_last);
+
+        if (deque_back(&received).token == END) {
+            is_received_end = 1;
+            pipeline_stop();
+        }
+    }
+}
+
+INTERNAL void preprocess_start_thread(void)
+{
+    assert(!is_pipelined);
+    assert(!output_preprocessed);
+    is_pipelined = 1;
+    pipeline_start(produce_tokens);
+}
+
+INTERNAL int diagnostic_begin(String *path, int *line)
+{
+    if (is_pipelined && !pipeline_is_producer()) {
+        *path = received_path;
+        *line = received_line;
+        return 0;
+    }
+
+    *path = current_file_path;
+    *line = current_file_line;
+    if (is_pipelined) {
+        pipeline_begin_diagnostic();
+        return 1;
+    }
+
+    return 0;
+}
+
+INTERNAL void diagnostic_end(int is_held)
+{
+    if (is_held) {
+        pipeline_end_diagnostic();
+    }
 }
 
 INTERNAL struct token next(void)
 {
+    if (is_pipelined) {
+        if (deque_len(&received) < 1) {
+            receive_tokens(1);
+        }
+        return deque_pop_front(&received);
+    }
+
     if (deque_len(&lookahead) < 1) {
         preprocess_line(1);
     }
@@ -637,6 +1037,13 @@ INTERNAL struct token peek(void)
 INTERNAL struct token peekn(int n)
 {
     assert(n > 0);
+    if (is_pipelined) {
+        if (deque_len(&received) < n) {
+            receive_tokens(n);
+        }
+        return deque_get(&received, n - 1);
+    }
+
     if (deque_len(&lookahead) < n) {
         preprocess_line(n);
     }
@@ -673,34 +1080,339 @@ INTERNAL struct token consume(enum token_type type)
     return t;
 }
 
+static void output_flush(void)
+{
+    if (output_length) {
+        if (fwrite(output_buffer, 1, output_length, output_stream)
+            != output_length)
+        {
+            error("Failed to write preprocessed output.");
+            exit(1);
+        }
+        output_length = 0;
+    }
+}
+
+static void output_chars(const char *str, size_t len)
+{
+    if (output_length + len > sizeof(output_buffer)) {
+        output_flush();
+        if (len > sizeof(output_buffer)) {
+            if (fwrite(str, 1, len, output_stream) != len) {
+                error("Failed to write preprocessed output.");
+                exit(1);
+            }
+            return;
+        }
+    }
+
+    memcpy(output_buffer + output_length, str, len);
+    output_length += len;
+}
+
+static void output_char(char c)
+{
+    if (output_length == sizeof(output_buffer)) {
+        output_flush();
+    }
+
+    output_buffer[output_length++] = c;
+}
+
+static void output_spaces(int n)
+{
+    while (n--) {
+        output_char(' ');
+    }
+}
+
+/*
+ * Write line marker in the same format as GCC, with flag 1 when
+ * entering a file, 2 when returning to a file, and 3 4 if the file is
+ * a system header. The path is written as is, the same way __FILE__ is
+ * expanded, which keeps names given by #line directives intact.
+ */
+static void output_line_marker(String path, int line, int flag, int sys)
+{
+    size_t len;
+    char buf[32];
+
+    len = sprintf(buf, "# %d \"", line);
+    output_chars(buf, len);
+    output_chars(str_raw(path), str_len(path));
+    output_char('"');
+    if (flag) {
+        output_char(' ');
+        output_char('0' + flag);
+    }
+
+    if (sys) {
+        output_chars(" 3 4", 4);
+    }
+
+    output_char('\n');
+    output_path = path;
+    output_line = line;
+}
+
+/*
+ * Skip forward to line in the file of the last marker. Short runs of
+ * blank lines are written as is, longer runs are replaced by a marker.
+ */
+static void output_skip_to(int line, int sys)
+{
+    if (line > output_line + 8) {
+        output_line_marker(output_path, line, 0, sys);
+    } else while (output_line < line) {
+        output_char('\n');
+        output_line++;
+    }
+}
+
+/*
+ * Bring line markers up to date before writing the first token of a
+ * line. Pop files that have been closed, push files that have been
+ * opened, and skip forward to the line of the token. Like GCC, a file
+ * is entered at line 1, and returned to at the line after #include.
+ */
+static void output_line_start(void)
+{
+    int i, depth, common;
+    struct line_marker m, *top;
+
+    depth = include_depth();
+    if (!depth) {
+        return;
+    }
+
+    common = 0;
+    while (common < depth && common < array_len(&marker_stack)) {
+        m.id = include_stack_entry(common + 1, &m.path, &m.line, &m.sys);
+        if (m.id != array_get(&marker_stack, common).id) {
+            break;
+        }
+        common++;
+    }
+
+    while (array_len(&marker_stack) > common) {
+        (void) array_pop_back(&marker_stack);
+        i = array_len(&marker_stack);
+        if (i > common) {
+            top = &array_back(&marker_stack);
+            output_line_marker(top->path, top->line + 1, 2, top->sys);
+        } else if (i == depth) {
+            top = &array_back(&marker_stack);
+            output_line_marker(origin_path, top->line + 1, 2, top->sys);
+        } else {
+            include_stack_entry(i, &m.path, &m.line, &m.sys);
+            output_line_marker(m.path, m.line, 2, m.sys);
+        }
+    }
+
+    if (array_len(&marker_stack) == depth) {
+        m = array_back(&marker_stack);
+        if (str_cmp(origin_path, output_path)
+            || (origin_line < output_line && origin_line != output_origin))
+        {
+            output_line_marker(origin_path, origin_line, 0, m.sys);
+        } else {
+            output_skip_to(origin_line, m.sys);
+        }
+    } else while (array_len(&marker_stack) < depth) {
+        i = array_len(&marker_stack) + 1;
+        if (i > 1) {
+            array_back(&marker_stack).line = output_line;
+        }
+        m.id = include_stack_entry(i, &m.path, &m.line, &m.sys);
+        if (i == depth) {
+            m.path = origin_path;
+            m.line = origin_line;
+        }
+        output_line_marker(m.path, 1, i > 1, m.sys);
+        output_skip_to(m.line, m.sys);
+        array_push_back(&marker_stack, m);
+    }
+
+    output_origin = origin_line;
+}
+
 INTERNAL void preprocess(FILE *output)
 {
+    int is_line_start;
+    String str;
     struct token t;
 
     output_preprocessed = 1;
+    if (!output) {
+        while (next().token != END)
+            ;
+        return;
+    }
+
+    is_line_start = 1;
+    output_stream = output;
+    array_empty(&marker_stack);
     while ((t = next()).token != END) {
+        if (t.token == NEWLINE) {
+            if (!is_line_start) {
+                output_char('\n');
+                output_line++;
+                is_line_start = 1;
+            }
+            continue;
+        }
+
+        if (is_line_start) {
+            if (!context.no_linemarkers) {
+                output_line_start();
+            }
+            is_line_start = 0;
+        }
+
         if (t.leading_whitespace) {
-            fprintf(output, "%*s", t.leading_whitespace, " ");
+            output_spaces(t.leading_whitespace);
         }
 
+        str = t.d.string;
         switch (t.token) {
         case NUMBER:
             assert(0);
             break;
         case PREP_STRING:
         case STRING:
-            putc('\"', output);
-            fprintf(output, "%s", str_raw(t.d.string));
-            putc('\"', output);
+            output_char('\"');
+            output_chars(str_raw(str), str_len(str));
+            output_char('\"');
             break;
         case PREP_CHAR:
-            putc('\'', output);
-            fprintf(output, "%s", str_raw(t.d.string));
-            putc('\'', output);
+            output_char('\'');
+            output_chars(str_raw(str), str_len(str));
+            output_char('\'');
             break;
         default:
-            fprintf(output, "%s", str_raw(t.d.string));
+            output_chars(str_raw(str), str_len(str));
             break;
         }
     }
+
+    if (!is_line_start) {
+        output_char('\n');
+    }
+
+    output_flush();
+}
+
+INTERNAL void begin_pch(void)
+{
+    assert(snapshot_state == SNAPSHOT_NONE);
+    snapshot_state = SNAPSHOT_PCH;
+    macro_snapshot_begin();
+}
+
+INTERNAL void write_pch(
+    FILE *output,
+    const char *path,
+    const char *config,
+    int is_parsed)
+{
+    int i;
+
+    assert(snapshot_state == SNAPSHOT_PCH);
+    snapshot_state = SNAPSHOT_DISABLED;
+    while (array_len(&snapshot_tokens)
+        && array_back(&snapshot_tokens).token == END)
+    {
+        (void) array_pop_back(&snapshot_tokens);
+    }
+
+    macro_snapshot_end();
+    save_header_state();
+
+    pch_write_header(output);
+    pch_write_int(output, context.standard);
+    pch_write_chars(output, config);
+    pch_write_chars(output, path);
+    write_header_dependencies(output);
+    write_header_state(output);
+    macro_snapshot_write(output);
+    pch_write_int(output, is_parsed);
+    if (!is_parsed) {
+        pch_write_int(output, array_len(&snapshot_tokens));
+        for (i = 0; i < array_len(&snapshot_tokens); ++i) {
+            pch_write_token(output, array_get(&snapshot_tokens, i));
+        }
+    }
+
+    array_empty(&snapshot_tokens);
+}
+
+INTERNAL void include_pch(const char *path, const char *config)
+{
+    long i, n;
+    int is_valid;
+    char *str;
+    FILE *stream;
+
+    assert(snapshot_state == SNAPSHOT_NONE);
+    stream = fopen(path, "rb");
+    if (!stream) {
+        error("Unable to open precompiled header %s.", path);
+        exit(1);
+    }
+
+    if (!pch_read_header(stream)) {
+        error("Invalid precompiled header %s.", path);
+        exit(1);
+    }
+
+    is_valid = pch_read_int(stream) == context.standard;
+    str = pch_read_chars(stream);
+    is_valid = is_valid && !strcmp(str, config);
+    free(str);
+
+    pch_header_path = pch_read_chars(stream);
+    is_valid = read_header_dependencies(stream) && is_valid;
+    if (!is_valid || context.target == TARGET_PREPROCESS) {
+        if (!is_valid) {
+            warning("Precompiled header %s is out of date, including %s.",
+                path, pch_header_path);
+        }
+        add_include_file(pch_header_path);
+    } else {
+        read_header_state(stream);
+        add_saved_header(pch_header_path);
+        add_saved_header(path);
+        macro_snapshot_read(stream);
+        if (pch_read_int(stream)) {
+            pch_path = calloc(strlen(path) + 1, sizeof(*pch_path));
+            strcpy(pch_path, path);
+            pch_declarations = ftell(stream);
+        } else {
+            n = pch_read_int(stream);
+            for (i = 0; i < n; ++i) {
+                array_push_back(&snapshot_tokens, pch_read_token(stream));
+            }
+        }
+        strtab_mark();
+        snapshot_state = SNAPSHOT_READY;
+    }
+
+    fclose(stream);
+}
+
+INTERNAL FILE *open_pch_declarations(void)
+{
+    FILE *stream;
+
+    if (!pch_declarations) {
+        return NULL;
+    }
+
+    stream = fopen(pch_path, "rb");
+    if (!stream || fseek(stream, pch_declarations, SEEK_SET)) {
+        error("Unable to read precompiled header %s.", pch_path);
+        exit(1);
+    }
+
+    return stream;
 }
@@ -1,11 +1,14 @@
 #ifndef PREPROCESS_H
 #define PREPROCESS_H
 
+#include <lacc/string.h>
+
 #include <stdio.h>
 
 /*
  * Output preprocessed input to provided stream, toggled by -E program
- * option.
+ * option. Input is only read if output is NULL, which is used by -M to
+ * find dependencies.
  */
 INTERNAL void preprocess(FILE *output);
 
@@ -18,6 +21,58 @@ INTERNAL void preprocess(FILE *output);
  */
 INTERNAL void inject_line(char *line);
 
+/*
+ * Start recording tokens and changes to macro definitions, while the
+ * parser reads a header to be precompiled.
+ */
+INTERNAL void begin_pch(void);
+
+/*
+ * Write macro definitions and state of included headers recorded since
+ * begin_pch to a precompiled header. Path of the original header, and
+ * configuration given as a string of options, are stored to validate
+ * later use. Tokens are written unless the parser has declarations
+ * to write in their place, which follow directly after.
+ */
+INTERNAL void write_pch(
+    FILE *output,
+    const char *path,
+    const char *config,
+    int is_parsed);
+
+/*
+ * Load precompiled header, to be replayed at the start of every input
+ * file. Fall back to including the original header if any dependency
+ * has changed, or configuration is different. This must be called
+ * before processing the first input file.
+ */
+INTERNAL void include_pch(const char *path, const char *config);
+
+/*
+ * Open precompiled header at declarations to be read by the parser, or
+ * return NULL if tokens are replayed instead.
+ */
+INTERNAL FILE *open_pch_declarations(void);
+
+/*
+ * Run preprocessing on a separate thread for the rest of the current
+ * input file, enabled with -fpreprocess-thread.
+ */
+INTERNAL void preprocess_start_thread(void);
+
+/*
+ * Get location to report in diagnostics. When preprocessing runs on a
+ * separate thread, the parser reports where the preprocessor was after
+ * producing the last tokens received, as it would when running in
+ * sequence. Diagnostics from the preprocessor thread are held back
+ * until the parser has read all tokens produced before them. Return
+ * non-zero if the message must be completed with diagnostic_end.
+ */
+INTERNAL int diagnostic_begin(String *path, int *line);
+
+/* Complete diagnostic message, passing the result of diagnostic_begin. */
+INTERNAL void diagnostic_end(int is_held);
+
 /* Initialize data structures used for preprocessing. */
 INTERNAL void preprocess_reset(void);
 
@@ -3,27 +3,91 @@
 # define EXTERNAL extern
 #endif
 #include "strtab.h"
+#include "tokenize.h"
+#include <lacc/arena.h>
+#include <lacc/array.h>
+#include <lacc/context.h>
 #include <lacc/hash.h>
 
+#include <pthread.h>
 #include <assert.h>
 #include <ctype.h>
 #include <stdlib.h>
 #include <string.h>
 
 #define STRTAB_SIZE 1024
+#define IDENT_TABLE_SIZE 1024
+
+/* Identifiers are indexed in blocks of fixed size. */
+#define IDENT_BLOCK_SIZE 1024
+#define IDENT_BLOCKS 8192
 
 static struct hash_table strtab;
 
+/*
+ * Strings and identifier objects are allocated from an arena, and are
+ * released together on reset. Objects are placed contiguously in order
+ * of first occurrence.
+ */
+static struct arena arena;
+
+/*
+ * Map from name to identifier object, and list of identifiers indexed
+ * by id. Index 0 is never assigned. The list is stored in blocks which
+ * are never moved, such that identifiers can be read by id without
+ * locking while the preprocessor thread is adding more.
+ */
+static struct hash_table ident_table;
+static struct ident **ident_blocks[IDENT_BLOCKS];
+static unsigned ident_count;
+
+#define ident_at(i) \
+    ident_blocks[(i) / IDENT_BLOCK_SIZE][(i) % IDENT_BLOCK_SIZE]
+
+/*
+ * With -fpreprocess-thread, the parser can register and look up
+ * identifiers concurrently with the preprocessor. Hash tables and the
+ * arena are only accessed while holding this lock.
+ */
+static pthread_mutex_t strtab_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void strtab_acquire(void)
+{
+    if (context.preprocess_thread) {
+        pthread_mutex_lock(&strtab_lock);
+    }
+}
+
+static void strtab_release(void)
+{
+    if (context.preprocess_thread) {
+        pthread_mutex_unlock(&strtab_lock);
+    }
+}
+
 /* Buffer used to concatenate strings before registering them. */
 static char *catbuf;
 static size_t catlen;
 
 static int initialized;
 
+/*
+ * State saved by strtab_mark. Strings and identifiers registered before
+ * the mark are kept on reset, and strings registered after are tracked
+ * in order to remove them from the table.
+ */
+static struct {
+    int is_set;
+    unsigned idents;
+    struct arena_mark arena;
+} mark;
+
+static array_of(String *) marked_strings;
+
 /*
  * Every unique string encountered, being identifiers or literals, is
- * kept for the lifetime of the program. To save allocations, store the
- * raw string buffer in the same allocation as the struct.
+ * kept until the string table is reset. Store the raw string buffer
+ * next to the struct, in memory owned by the arena.
  *
  *  _________ String ________    ________ const char [] ________
  * |                          | |                               |
@@ -33,16 +97,21 @@ static void *str_hash_add(void *ref)
 {
     String *s;
     char *buffer;
-    unsigned short l;
+    unsigned int l;
 
     s = (String *) ref;
-    l = s->p.len;
-    buffer = malloc(sizeof(String) + l + 1);
+    l = s->p.size;
+    buffer = arena_alloc(&arena, sizeof(String) + l + 1);
     buffer[sizeof(String) + l] = '\0';
     memcpy(buffer + sizeof(String), s->p.str, l);
     s = (String *) buffer;
     s->p.str = buffer + sizeof(*s);
-    s->p.len = l;
+    s->p.len = SHORT_STRING_LEN;
+    s->p.size = l;
+    if (mark.is_set) {
+        array_push_back(&marked_strings, s);
+    }
+
     return s;
 }
 
@@ -52,11 +121,196 @@ static String str_hash_key(void *ref)
     return *str;
 }
 
+static String ident_hash_key(void *ref)
+{
+    return ((struct ident *) ref)->name;
+}
+
+static String register_string(const char *str, size_t len);
+
+static void ident_push(struct ident *id)
+{
+    unsigned i;
+
+    i = ident_count / IDENT_BLOCK_SIZE;
+    if (i == IDENT_BLOCKS) {
+        strtab_release();
+        error("Too many identifiers.");
+        exit(1);
+    }
+
+    if (!ident_blocks[i]) {
+        ident_blocks[i] = calloc(IDENT_BLOCK_SIZE, sizeof(struct ident *));
+    }
+
+    ident_at(ident_count) = id;
+    ident_count++;
+}
+
+static void *ident_hash_add(void *ref)
+{
+    struct ident *id;
+
+    id = arena_alloc(&arena, sizeof(*id));
+    *id = *((struct ident *) ref);
+    if (id->name.len >= SHORT_STRING_LEN) {
+        id->name = register_string(id->name.p.str, id->name.p.size);
+    }
+
+    if (!id->id) {
+        id->id = ident_count;
+        ident_push(id);
+    } else {
+        assert(id->id < ident_count);
+        ident_at(id->id) = id;
+    }
+
+    return id;
+}
+
+/*
+ * Register all keywords with index corresponding to token type, such
+ * that keyword tokens can refer to interned objects without lookup.
+ */
+static void ident_table_init(void)
+{
+    int i;
+    struct ident id = {0};
+
+    hash_init(
+        &ident_table,
+        IDENT_TABLE_SIZE,
+        ident_hash_key,
+        ident_hash_add,
+        NULL);
+
+    for (i = 0; i < 128; ++i) {
+        ident_push(NULL);
+    }
+
+    for (i = 1; i < 128; ++i) {
+        if (basic_token[i].is_expandable && basic_token[i].id) {
+            assert(basic_token[i].id == i);
+            id.id = i;
+            id.name = basic_token[i].d.string;
+            if (i == STATIC_ASSERT) {
+                id.name = str_init("_Static_assert");
+            }
+            hash_insert(&ident_table, &id);
+        }
+    }
+}
+
+INTERNAL unsigned int ident_register(const char *str, size_t len)
+{
+    String name = {0};
+    struct ident *ref, id = {0};
+
+    strtab_acquire();
+    if (!ident_count) {
+        ident_table_init();
+    }
+
+    if (len < SHORT_STRING_LEN) {
+        memcpy(name.a.str, str, len);
+        name.a.len = len;
+    } else {
+        name.p.str = str;
+        name.p.len = SHORT_STRING_LEN;
+        name.p.size = len;
+    }
+
+    id.name = name;
+    ref = hash_insert(&ident_table, &id);
+    strtab_release();
+    return ref->id;
+}
+
+INTERNAL struct ident *ident_get(unsigned int id)
+{
+    assert(id > 0);
+    assert(ident_blocks[id / IDENT_BLOCK_SIZE]);
+    return ident_at(id);
+}
+
+INTERNAL struct ident *ident_lookup(String name)
+{
+    struct ident *id;
+
+    strtab_acquire();
+    id = ident_count ? hash_lookup(&ident_table, name) : NULL;
+    strtab_release();
+    return id;
+}
+
+INTERNAL void strtab_mark(void)
+{
+    strtab_acquire();
+    if (!ident_count) {
+        ident_table_init();
+    }
+
+    mark.is_set = 1;
+    mark.idents = ident_count;
+    mark.arena = arena_mark(&arena);
+    strtab_release();
+}
+
+/*
+ * Remove everything registered after the mark, and clear cached macro
+ * and symbol references of the identifiers that are kept.
+ */
+static void strtab_rewind(void)
+{
+    unsigned i;
+    String *s;
+    struct ident *id;
+
+    while (ident_count > mark.idents) {
+        ident_count -= 1;
+        id = ident_at(ident_count);
+        hash_remove(&ident_table, id->name);
+    }
+
+    for (i = 1; i < ident_count; ++i) {
+        id = ident_at(i);
+        if (id) {
+            id->macro = NULL;
+            id->sym = NULL;
+        }
+    }
+
+    while (array_len(&marked_strings)) {
+        s = array_pop_back(&marked_strings);
+        hash_remove(&strtab, *s);
+    }
+
+    arena_rewind(&arena, mark.arena);
+}
+
 INTERNAL void strtab_reset(void)
 {
-    if (initialized) {
-        hash_destroy(&strtab);
-        initialized = 0;
+    unsigned i;
+
+    if (mark.is_set) {
+        strtab_rewind();
+    } else {
+        if (ident_count) {
+            hash_destroy(&ident_table);
+            ident_count = 0;
+        }
+
+        for (i = 0; i < IDENT_BLOCKS && ident_blocks[i]; ++i) {
+            free(ident_blocks[i]);
+            ident_blocks[i] = NULL;
+        }
+
+        if (initialized) {
+            hash_destroy(&strtab);
+            initialized = 0;
+        }
+
+        arena_reset(&arena);
     }
 
     free(catbuf);
@@ -64,7 +318,15 @@ INTERNAL void strtab_reset(void)
     catlen = 0;
 }
 
-INTERNAL String str_register(const char *str, size_t len)
+INTERNAL void strtab_finalize(void)
+{
+    mark.is_set = 0;
+    array_clear(&marked_strings);
+    strtab_reset();
+    arena_destroy(&arena);
+}
+
+static String register_string(const char *str, size_t len)
 {
     String data = {0}, *ref;
     assert(len >= 0);
@@ -80,28 +342,43 @@ INTERNAL String str_register(const char *str, size_t len)
                 STRTAB_SIZE,
                 str_hash_key,
                 str_hash_add,
-                free);
+                NULL);
             initialized = 1;
         }
         data.p.str = str;
-        data.p.len = len;
+        data.p.len = SHORT_STRING_LEN;
+        data.p.size = len;
         ref = hash_insert(&strtab, &data);
     }
 
     return *ref;
 }
 
+INTERNAL String str_register(const char *str, size_t len)
+{
+    String s;
+
+    if (len < SHORT_STRING_LEN) {
+        return register_string(str, len);
+    }
+
+    strtab_acquire();
+    s = register_string(str, len);
+    strtab_release();
+    return s;
+}
+
 INTERNAL String str_cat(String a, String b)
 {
     size_t len;
 
-    len = a.len + b.len;
+    len = str_len(a) + str_len(b);
     if (len > catlen) {
         catlen = len;
         catbuf = realloc(catbuf, catlen);
     }
 
-    memcpy(catbuf, str_raw(a), a.len);
-    memcpy(catbuf + a.len, str_raw(b), b.len);
+    memcpy(catbuf, str_raw(a), str_len(a));
+    memcpy(catbuf + str_len(a), str_raw(b), str_len(b));
     return str_register(catbuf, len);
 }
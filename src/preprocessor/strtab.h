@@ -17,7 +17,19 @@ INTERNAL String str_register(const char *str, size_t len);
 /* Concatenate two strings together. */
 INTERNAL String str_cat(String a, String b);
 
-/* Free memory used for string table. */
+/*
+ * Free memory used for string table and identifiers, except what was
+ * registered before calling strtab_mark.
+ */
 INTERNAL void strtab_reset(void);
 
+/*
+ * Keep all strings and identifiers registered so far when resetting,
+ * to be shared by subsequent translation units.
+ */
+INTERNAL void strtab_mark(void);
+
+/* Free all memory used for string table and identifiers. */
+INTERNAL void strtab_finalize(void);
+
 #endif
@@ -0,0 +1,492 @@
+#if !AMALGAMATION
+# define INTERNAL
+# define EXTERNAL extern
+#endif
+#include "strtab.h"
+#include "tokencache.h"
+#include "tokenize.h"
+#include <lacc/context.h>
+#include <lacc/hash.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define CACHE_MAGIC "lacc-tok"
+#define CACHE_VERSION 2
+
+/* Last value of enum token_type, changing if tokens are added. */
+#define CACHE_TOKEN_MAX NEG
+
+/* Flags stored with each token. */
+#define CACHE_EXPANDABLE 1
+#define CACHE_DISABLE_EXPAND 2
+#define CACHE_IDENT 4
+
+/*
+ * Entries are stored in native layout, with record sizes and the range
+ * of token values in the header to detect files written by a different
+ * build. The header is followed by path of the file, length of each
+ * string, characters of all strings, line and token records, and
+ * finally text of lines stored as text.
+ */
+struct cache_header {
+    char magic[sizeof(CACHE_MAGIC)];
+    long version;
+    long token_size;
+    long line_size;
+    long token_max;
+    unsigned long hash;
+    long size;
+    long path;
+    long strings;
+    long chars;
+    long lines;
+    long tokens;
+    long text;
+};
+
+/*
+ * Tokens produced by the tokenizer have no numeric value, only a string
+ * which is referenced by index in the string list.
+ */
+struct cache_token {
+    int token;
+    int leading_whitespace;
+    int flags;
+    int string;
+};
+
+/* String and its index, used to deduplicate strings on write. */
+struct cache_string {
+    String str;
+    int index;
+};
+
+static const char *cache_directory;
+
+INTERNAL int set_token_cache_directory(const char *path)
+{
+    cache_directory = path;
+    return 0;
+}
+
+INTERNAL int has_token_cache(void)
+{
+    return cache_directory != NULL;
+}
+
+/*
+ * Hash a word at a time, continuing from the given hash value. Used both
+ * to identify file content, and to name cache entries.
+ */
+static unsigned long hash_bytes(
+    unsigned long hash,
+    const char *data,
+    size_t size)
+{
+    size_t i;
+    unsigned long w;
+
+    for (i = 0; i + sizeof(w) <= size; i += sizeof(w)) {
+        memcpy(&w, data + i, sizeof(w));
+        hash = (hash ^ w) * 0x100000001b3ul;
+        hash ^= hash >> 29;
+    }
+
+    if (i < size) {
+        w = 0;
+        memcpy(&w, data + i, size - i);
+        hash = (hash ^ w) * 0x100000001b3ul;
+        hash ^= hash >> 29;
+    }
+
+    return hash ^ size;
+}
+
+/*
+ * Entry is named by hash of both path and content. Return name in
+ * buffer owned by caller.
+ */
+static char *cache_file_name(const char *path, unsigned long hash)
+{
+    char *name;
+    unsigned long key;
+
+    key = hash_bytes(hash, path, strlen(path));
+    name = calloc(strlen(cache_directory) + 32, sizeof(*name));
+    sprintf(name, "%s/%016lx.tok", cache_directory, key);
+    return name;
+}
+
+static char *read_file(const char *name, size_t *size)
+{
+    long len;
+    char *data;
+    FILE *stream;
+
+    stream = fopen(name, "rb");
+    if (!stream) {
+        return NULL;
+    }
+
+    data = NULL;
+    if (!fseek(stream, 0, SEEK_END) && (len = ftell(stream)) > 0) {
+        data = malloc(len);
+        rewind(stream);
+        if (fread(data, len, 1, stream) == 1) {
+            *size = len;
+        } else {
+            free(data);
+            data = NULL;
+        }
+    }
+
+    fclose(stream);
+    return data;
+}
+
+/*
+ * Check that the header matches the file being read, and that sizes add
+ * up to the size of the entry.
+ */
+static int is_valid_header(
+    const struct cache_header *header,
+    size_t total,
+    const char *path,
+    unsigned long hash,
+    size_t size)
+{
+    size_t expected;
+
+    if (memcmp(header->magic, CACHE_MAGIC, sizeof(header->magic))
+        || header->version != CACHE_VERSION
+        || header->token_size != (long) sizeof(struct cache_token)
+        || header->line_size != (long) sizeof(struct cached_line)
+        || header->token_max != CACHE_TOKEN_MAX
+        || header->hash != hash
+        || header->size != (long) size
+        || header->path != (long) strlen(path)
+        || header->strings < 0
+        || header->chars < 0
+        || header->lines < 0
+        || header->tokens < 0
+        || header->text < 0)
+    {
+        return 0;
+    }
+
+    expected = sizeof(*header)
+        + header->path
+        + header->strings * sizeof(int)
+        + header->chars
+        + header->lines * sizeof(struct cached_line)
+        + header->tokens * sizeof(struct cache_token)
+        + header->text;
+
+    return expected == total;
+}
+
+/*
+ * Line refers to either tokens or text, not both. Each run of tokens is
+ * terminated by END, which is checked by requiring the last token to be
+ * END. Text is terminated by the last character of the entry.
+ */
+static int is_valid_line(
+    const struct cache_header *header,
+    const struct cached_line *line)
+{
+    if (line->tokens < -1 || line->tokens >= header->tokens
+        || line->text < -1 || line->text >= header->text)
+    {
+        return 0;
+    }
+
+    return (line->tokens == -1) != (line->text == -1);
+}
+
+/*
+ * Only tokens produced by the tokenizer are stored, which all have an
+ * entry in the basic token table.
+ */
+static int is_valid_token(int token)
+{
+    return token == END
+        || (token > END && token <= CACHE_TOKEN_MAX
+            && basic_token[token].token == token);
+}
+
+INTERNAL struct token_cache *token_cache_load(
+    const char *path,
+    const char *data,
+    size_t size)
+{
+    int i, len;
+    char *name, *buf;
+    const char *ptr, *chars, *end;
+    size_t total;
+    unsigned long hash;
+    unsigned *ids;
+    String *strings;
+    struct cache_header header;
+    struct cache_token rec;
+    struct cached_line line;
+    struct token t;
+    struct token_cache *cache;
+
+    assert(cache_directory);
+    hash = hash_bytes(0xcbf29ce484222325ul, data, size);
+    name = cache_file_name(path, hash);
+    buf = read_file(name, &total);
+    free(name);
+    if (!buf) {
+        return NULL;
+    }
+
+    cache = NULL;
+    if (total < sizeof(header)) {
+        goto end;
+    }
+
+    memcpy(&header, buf, sizeof(header));
+    if (!is_valid_header(&header, total, path, hash, size)) {
+        goto end;
+    }
+
+    ptr = buf + sizeof(header);
+    if (memcmp(ptr, path, header.path)) {
+        goto end;
+    }
+
+    ptr += header.path;
+    chars = ptr + header.strings * sizeof(int);
+    end = chars + header.chars;
+    strings = calloc(header.strings + 1, sizeof(*strings));
+    ids = calloc(header.strings + 1, sizeof(*ids));
+    for (i = 0; i < header.strings; ++i) {
+        memcpy(&len, ptr + i * sizeof(int), sizeof(int));
+        if (len < 0 || len > end - chars) {
+            goto fail;
+        }
+        strings[i] = str_register(chars, len);
+        chars += len;
+    }
+
+    ptr = end;
+    if (header.text && buf[total - 1] != '\0') {
+        goto fail;
+    }
+
+    cache = token_cache_create();
+    for (i = 0; i < header.lines; ++i) {
+        memcpy(&line, ptr, sizeof(line));
+        ptr += sizeof(line);
+        if (!is_valid_line(&header, &line)) {
+            goto fail;
+        }
+        array_push_back(&cache->lines, line);
+    }
+
+    for (i = 0; i < header.tokens; ++i) {
+        memcpy(&rec, ptr, sizeof(rec));
+        ptr += sizeof(rec);
+        if (rec.string < 0 || rec.string >= header.strings
+            || !is_valid_token(rec.token)
+            || (i == header.tokens - 1 && rec.token != END))
+        {
+            goto fail;
+        }
+        t = basic_token[END];
+        t.token = rec.token;
+        t.leading_whitespace = rec.leading_whitespace;
+        t.is_expandable = (rec.flags & CACHE_EXPANDABLE) != 0;
+        t.disable_expand = (rec.flags & CACHE_DISABLE_EXPAND) != 0;
+        t.d.string = strings[rec.string];
+        if (rec.flags & CACHE_IDENT) {
+            if (!ids[rec.string]) {
+                ids[rec.string] =
+                    ident_register(str_raw(t.d.string), str_len(t.d.string));
+            }
+            t.id = ids[rec.string];
+        }
+        array_push_back(&cache->tokens, t);
+    }
+
+    if (header.text) {
+        array_realloc(&cache->text, (unsigned) header.text);
+        memcpy(cache->text.data, ptr, header.text);
+        cache->text.length = header.text;
+    }
+
+    goto done;
+
+fail:
+    if (cache) {
+        token_cache_free(cache);
+        cache = NULL;
+    }
+
+done:
+    free(strings);
+    free(ids);
+
+end:
+    free(buf);
+    return cache;
+}
+
+INTERNAL struct token_cache *token_cache_create(void)
+{
+    return calloc(1, sizeof(struct token_cache));
+}
+
+INTERNAL void token_cache_add_line(
+    struct token_cache *cache,
+    const char *text,
+    int line)
+{
+    size_t len;
+    struct cached_line l;
+
+    len = strlen(text);
+    l.line = line;
+    l.tokens = -1;
+    l.text = array_len(&cache->text);
+    if (l.text + len + 1 > cache->text.capacity) {
+        array_realloc(&cache->text, (l.text + len + 1) * 2);
+    }
+
+    memcpy(cache->text.data + l.text, text, len + 1);
+    cache->text.length += len + 1;
+    array_push_back(&cache->lines, l);
+}
+
+INTERNAL void token_cache_set_tokens(
+    struct token_cache *cache,
+    const struct token *tokens,
+    unsigned n)
+{
+    unsigned i;
+    struct cached_line *l;
+
+    assert(array_len(&cache->lines));
+    l = &array_back(&cache->lines);
+    assert(l->tokens == -1);
+    cache->text.length = l->text;
+    l->text = -1;
+    l->tokens = array_len(&cache->tokens);
+    for (i = 0; i < n; ++i) {
+        array_push_back(&cache->tokens, tokens[i]);
+    }
+
+    array_push_back(&cache->tokens, basic_token[END]);
+}
+
+static String cache_string_key(void *ref)
+{
+    return ((struct cache_string *) ref)->str;
+}
+
+static void *cache_string_add(void *ref)
+{
+    struct cache_string *s;
+
+    s = malloc(sizeof(*s));
+    *s = *((struct cache_string *) ref);
+    return s;
+}
+
+INTERNAL void token_cache_store(
+    struct token_cache *cache,
+    const char *path,
+    const char *data,
+    size_t size)
+{
+    int i, len;
+    char *name, *temp;
+    FILE *stream;
+    struct token t;
+    struct cache_string s, *ref;
+    struct cache_token rec;
+    struct cache_header header = {{0}};
+    struct hash_table table;
+    array_of(String) strings = {0};
+    array_of(struct cache_token) records = {0};
+
+    assert(cache_directory);
+    hash_init(&table, 256, cache_string_key, cache_string_add, free);
+    for (i = 0; i < array_len(&cache->tokens); ++i) {
+        t = array_get(&cache->tokens, i);
+        s.str = t.d.string;
+        s.index = array_len(&strings);
+        ref = hash_insert(&table, &s);
+        if (ref->index == array_len(&strings)) {
+            array_push_back(&strings, t.d.string);
+            header.chars += str_len(t.d.string);
+        }
+        rec.token = t.token;
+        rec.leading_whitespace = t.leading_whitespace;
+        rec.flags = (t.is_expandable ? CACHE_EXPANDABLE : 0)
+            | (t.disable_expand ? CACHE_DISABLE_EXPAND : 0)
+            | (t.id ? CACHE_IDENT : 0);
+        rec.string = ref->index;
+        array_push_back(&records, rec);
+    }
+
+    memcpy(header.magic, CACHE_MAGIC, sizeof(header.magic));
+    header.version = CACHE_VERSION;
+    header.token_size = sizeof(struct cache_token);
+    header.line_size = sizeof(struct cached_line);
+    header.token_max = CACHE_TOKEN_MAX;
+    header.hash = hash_bytes(0xcbf29ce484222325ul, data, size);
+    header.size = size;
+    header.path = strlen(path);
+    header.strings = array_len(&strings);
+    header.lines = array_len(&cache->lines);
+    header.tokens = array_len(&records);
+    header.text = array_len(&cache->text);
+
+    name = cache_file_name(path, header.hash);
+    temp = calloc(strlen(name) + 32, sizeof(*temp));
+    sprintf(temp, "%s.%ld", name, (long) getpid());
+    stream = fopen(temp, "wb");
+    if (!stream) {
+        verbose("Unable to write token cache file %s.", temp);
+    } else {
+        fwrite(&header, sizeof(header), 1, stream);
+        fwrite(path, 1, header.path, stream);
+        for (i = 0; i < array_len(&strings); ++i) {
+            len = str_len(array_get(&strings, i));
+            fwrite(&len, sizeof(len), 1, stream);
+        }
+        for (i = 0; i < array_len(&strings); ++i) {
+            s.str = array_get(&strings, i);
+            fwrite(str_raw(s.str), 1, str_len(s.str), stream);
+        }
+        fwrite(cache->lines.data, sizeof(struct cached_line),
+            array_len(&cache->lines), stream);
+        fwrite(records.data, sizeof(struct cache_token),
+            array_len(&records), stream);
+        fwrite(cache->text.data, 1, array_len(&cache->text), stream);
+        if (fclose(stream) || rename(temp, name)) {
+            verbose("Unable to write token cache file %s.", name);
+            remove(temp);
+        }
+    }
+
+    free(temp);
+    free(name);
+    hash_destroy(&table);
+    array_clear(&strings);
+    array_clear(&records);
+}
+
+INTERNAL void token_cache_free(struct token_cache *cache)
+{
+    array_clear(&cache->lines);
+    array_clear(&cache->tokens);
+    array_clear(&cache->text);
+    free(cache);
+}
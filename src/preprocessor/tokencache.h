@@ -0,0 +1,82 @@
+#ifndef TOKENCACHE_H
+#define TOKENCACHE_H
+
+#include <lacc/array.h>
+#include <lacc/token.h>
+
+#include <stddef.h>
+
+/*
+ * Line read from a header file, stored with line number of the next
+ * line. Lines that were completely tokenized when the file was first
+ * read are stored as a list of tokens, terminated by END. Other lines,
+ * such as those in inactive conditional blocks, are stored as text
+ * after initial preprocessing.
+ */
+struct cached_line {
+    int line;
+    int tokens;
+    int text;
+};
+
+/*
+ * Content of a header file, either loaded from the token cache or
+ * recorded while reading the file for storing in the cache.
+ */
+struct token_cache {
+    array_of(struct cached_line) lines;
+    array_of(struct token) tokens;
+    array_of(char) text;
+};
+
+/*
+ * Set directory used to store tokenized header files, specified with
+ * -ftoken-cache=<dir>. The cache is disabled by default.
+ */
+INTERNAL int set_token_cache_directory(const char *path);
+
+/* Return non-zero if token cache is enabled. */
+INTERNAL int has_token_cache(void);
+
+/*
+ * Look up header with the given path and content in the cache. Return
+ * NULL if there is no entry, or it was written for different content.
+ */
+INTERNAL struct token_cache *token_cache_load(
+    const char *path,
+    const char *data,
+    size_t size);
+
+/* Create empty entry, to be filled while reading a file. */
+INTERNAL struct token_cache *token_cache_create(void);
+
+/*
+ * Add line of text after initial preprocessing, and line number of the
+ * next line.
+ */
+INTERNAL void token_cache_add_line(
+    struct token_cache *cache,
+    const char *text,
+    int line);
+
+/* Replace text of the last line added by the tokens it produced. */
+INTERNAL void token_cache_set_tokens(
+    struct token_cache *cache,
+    const struct token *tokens,
+    unsigned n);
+
+/*
+ * Write entry for header with the given path and content. The file is
+ * written under a temporary name and renamed, such that concurrent
+ * invocations never see a partial file.
+ */
+INTERNAL void token_cache_store(
+    struct token_cache *cache,
+    const char *path,
+    const char *data,
+    size_t size);
+
+/* Free memory used by cache entry. */
+INTERNAL void token_cache_free(struct token_cache *cache);
+
+#endif
@@ -17,10 +17,11 @@
 
 /*
  * Static initializer for token. Only works with string representation
- * that can fit inline.
+ * that can fit inline. Keywords are interned with the same index as the
+ * token type.
  */
-#define TOK(t, s) {(t), 0, 0, 0, {0}, {SHORT_STRING_INIT(s)}}
-#define IDN(t, s) {(t), 0, 1, 0, {0}, {SHORT_STRING_INIT(s)}}
+#define TOK(t, s) {(t), 0, 0, 0, {0}, 0, {SHORT_STRING_INIT(s)}}
+#define IDN(t, s) {(t), 0, 1, 0, {0}, (t), {SHORT_STRING_INIT(s)}}
 
 INTERNAL const struct token basic_token[] = {
 /* 0x00 */  TOK(END, "$"),              IDN(AUTO, "auto"),
@@ -231,7 +232,7 @@ INTERNAL struct token convert_preprocessing_number(struct token t)
 
     assert(t.token == PREP_NUMBER);
     str = str_raw(t.d.string);
-    len = t.d.string.len;
+    len = str_len(t.d.string);
     tok.leading_whitespace = t.leading_whitespace;
 
     /*
@@ -371,10 +372,10 @@ INTERNAL struct token convert_preprocessing_string(struct token t)
     char *buf, *btr;
 
     raw = str_raw(t.d.string);
-    buf = get_string_buffer(t.d.string.len);
+    buf = get_string_buffer(str_len(t.d.string));
     btr = buf;
     ptr = raw;
-    while (ptr - raw < t.d.string.len) {
+    while (ptr - raw < str_len(t.d.string)) {
         *btr++ = convert_char(ptr, &ptr);
     }
 
@@ -516,7 +517,7 @@ static struct token strtostr(const char *in, const char **endptr)
 
 #define MATCH(id) \
     do { \
-        *endptr = start + basic_token[id].d.string.len; \
+        *endptr = start + str_len(basic_token[id].d.string); \
         return basic_token[id]; \
     } while (0)
 
@@ -537,7 +538,7 @@ static struct token strtoident(const char *in, const char **endptr)
         if (!strncmp(in, "Static_assert", 13)) {
             ident = basic_token[STATIC_ASSERT];
             ident.d.string = str_init("_Static_assert");
-            *endptr = start + ident.d.string.len;
+            *endptr = start + str_len(ident.d.string);
             return ident;
         }
         break;
@@ -637,7 +638,8 @@ static struct token strtoident(const char *in, const char **endptr)
         in++;
     }
 
-    ident.d.string = str_register(start, in - start);
+    ident.id = ident_register(start, in - start);
+    ident.d.string = ident_get(ident.id)->name;
     ident.is_expandable = 1;
     *endptr = in;
     return ident;
@@ -757,3 +759,116 @@ INTERNAL struct token tokenize(const char *in, const char **endptr)
     tok.leading_whitespace = ws;
     return tok;
 }
+
+/*
+ * Determine if input at this position is changed by initial
+ * preprocessing, by a line continuation or trigraph.
+ */
+#define is_spliced(in) \
+    (((in)[0] == '\\' && (in)[1] == '\n') \
+        || ((in)[0] == '?' && (in)[1] == '?'))
+
+/*
+ * Skip whitespace and comments in unprocessed input, where each comment
+ * counts as a single whitespace character. Return -1 if anything needs
+ * initial preprocessing, like comments spanning multiple lines.
+ */
+static int skip_raw_spaces(const char *in, const char **endptr)
+{
+    int ws;
+    const char *ptr;
+
+    ws = 0;
+    while (1) {
+        if (*in == '/' && in[1] == '*') {
+            ptr = in + 2;
+            while (ptr[0] != '*' || ptr[1] != '/') {
+                if (*ptr == '\n' || *ptr == '\0') {
+                    return -1;
+                }
+                ptr++;
+            }
+            in = ptr + 2;
+            ws++;
+        } else if (*in == '/' && in[1] == '/') {
+            /* Comment continues on next line, possibly by trigraph. */
+            ptr = strchr(in, '\n');
+            if (!ptr || ptr[-1] == '\\'
+                || (ptr[-1] == '/' && ptr[-2] == '?'))
+            {
+                return -1;
+            }
+            in = ptr;
+        } else if (isspace(*in) && *in != '\n') {
+            in++;
+            ws++;
+        } else if (is_spliced(in)) {
+            return -1;
+        } else {
+            break;
+        }
+    }
+
+    *endptr = in;
+    return ws;
+}
+
+/*
+ * Determine if string or character literal ends on the same line,
+ * without any line continuation or trigraph.
+ */
+static int is_raw_literal(const char *in)
+{
+    const char q = *in++;
+
+    while (*in != q) {
+        if (*in == '\n' || *in == '\0' || is_spliced(in)) {
+            return 0;
+        }
+        if (*in == '\\') {
+            in++;
+            if (*in == '\n' || *in == '\0' || is_spliced(in)) {
+                return 0;
+            }
+        }
+        in++;
+    }
+
+    return 1;
+}
+
+INTERNAL int tokenize_raw(
+    const char *in,
+    const char **endptr,
+    struct token *tok)
+{
+    int ws;
+    const char *start, *end;
+
+    assert(in);
+    assert(endptr);
+
+    ws = skip_raw_spaces(in, &start);
+    if (ws < 0 || is_spliced(start) || *start == '\0') {
+        *endptr = in;
+        return 0;
+    }
+
+    end = start;
+    if (*start == '\n') {
+        *tok = basic_token[END];
+    } else if ((*start == '"' || *start == '\'') && !is_raw_literal(start)) {
+        *endptr = in;
+        return 0;
+    } else {
+        *tok = tokenize(start, &end);
+        if (is_spliced(end)) {
+            *endptr = in;
+            return 0;
+        }
+    }
+
+    tok->leading_whitespace = ws;
+    *endptr = end;
+    return 1;
+}
@@ -45,6 +45,18 @@ INTERNAL struct token convert_preprocessing_char(struct token t);
  */
 INTERNAL struct token tokenize(const char *in, const char **endptr);
 
+/*
+ * Parse next preprocessing token directly from source input, where the
+ * line ends with a newline character. Comments contained on the line
+ * are skipped. Return 0 if the input needs initial preprocessing before
+ * it can be tokenized, for example because of line continuations. On
+ * end of line, END is returned with endptr pointing to the newline.
+ */
+INTERNAL int tokenize_raw(
+    const char *in,
+    const char **endptr,
+    struct token *tok);
+
 /* Free memory used to hold temporary strings during tokenization. */
 INTERNAL void tokenize_reset(void);
 
@@ -0,0 +1,496 @@
+#if !AMALGAMATION
+# define INTERNAL
+# define EXTERNAL extern
+#endif
+#include "trace.h"
+#include <lacc/array.h>
+#include <lacc/context.h>
+#include <lacc/hash.h>
+
+#include <sys/time.h>
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Accumulated cost of a file, over all times it was opened. The parent
+ * is the file which first included it, following parents gives the
+ * include chain.
+ */
+struct include_trace {
+    String path;
+    char *name;
+    struct include_trace *parent;
+    unsigned long opened;
+    unsigned long skipped;
+    unsigned long bytes;
+    unsigned long lines;
+    unsigned long tokens;
+    long inclusive;
+    long exclusive;
+};
+
+/*
+ * File currently open or macro being expanded, with start time and time
+ * spent in nested files or expansions so far. Times are in microseconds.
+ * Only files refer to a trace object.
+ */
+struct trace_frame {
+    struct include_trace *trace;
+    long start;
+    long children;
+};
+
+/* Accumulated cost of expanding a macro, over all its definitions. */
+struct macro_profile {
+    String name;
+    char *str;
+    unsigned long expansions;
+    unsigned long produced;
+    unsigned long copied;
+    unsigned max_depth;
+    long inclusive;
+    long exclusive;
+};
+
+static const char *trace_file_name;
+static struct hash_table trace_table;
+static int trace_table_initialized;
+static array_of(struct include_trace *) trace_list;
+static array_of(struct trace_frame) trace_stack;
+
+static const char *profile_file_name;
+static struct hash_table profile_table;
+static int profile_table_initialized;
+static array_of(struct macro_profile *) profile_list;
+static array_of(struct trace_frame) profile_stack;
+
+static long trace_time(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000l + tv.tv_usec;
+}
+
+static String trace_hash_key(void *ref)
+{
+    return ((struct include_trace *) ref)->path;
+}
+
+static void *trace_hash_add(void *ref)
+{
+    struct include_trace *t;
+
+    t = calloc(1, sizeof(*t));
+    *t = *((struct include_trace *) ref);
+    t->name = calloc(str_len(t->path) + 1, sizeof(*t->name));
+    memcpy(t->name, str_raw(t->path), str_len(t->path));
+    t->path = str_init(t->name);
+    array_push_back(&trace_list, t);
+    return t;
+}
+
+static void trace_hash_del(void *ref)
+{
+    struct include_trace *t;
+
+    t = (struct include_trace *) ref;
+    free(t->name);
+    free(t);
+}
+
+static struct include_trace *lookup_trace(String path)
+{
+    struct include_trace t = {0};
+
+    if (!trace_table_initialized) {
+        hash_init(
+            &trace_table,
+            256,
+            trace_hash_key,
+            trace_hash_add,
+            trace_hash_del);
+        trace_table_initialized = 1;
+    }
+
+    t.path = path;
+    return hash_insert(&trace_table, &t);
+}
+
+INTERNAL int set_include_trace_file(const char *path)
+{
+    trace_file_name = path;
+    context.trace_includes = 1;
+    return 0;
+}
+
+INTERNAL void trace_include_push(String path)
+{
+    struct trace_frame frame;
+
+    frame.trace = lookup_trace(path);
+    if (!frame.trace->opened && array_len(&trace_stack)) {
+        frame.trace->parent = array_back(&trace_stack).trace;
+    }
+
+    frame.trace->opened++;
+    frame.children = 0;
+    frame.start = trace_time();
+    array_push_back(&trace_stack, frame);
+}
+
+INTERNAL void trace_include_pop(size_t bytes, int lines)
+{
+    long elapsed;
+    struct trace_frame frame;
+
+    assert(array_len(&trace_stack));
+    frame = array_pop_back(&trace_stack);
+    elapsed = trace_time() - frame.start;
+    frame.trace->inclusive += elapsed;
+    frame.trace->exclusive += elapsed - frame.children;
+    frame.trace->bytes += bytes;
+    frame.trace->lines += lines;
+    if (array_len(&trace_stack)) {
+        array_back(&trace_stack).children += elapsed;
+    }
+}
+
+INTERNAL void trace_include_skip(String path)
+{
+    lookup_trace(path)->skipped++;
+}
+
+INTERNAL void trace_include_token(void)
+{
+    if (array_len(&trace_stack)) {
+        array_back(&trace_stack).trace->tokens++;
+    }
+}
+
+static int compare_trace(const void *a, const void *b)
+{
+    const struct include_trace *l, *r;
+
+    l = *((const struct include_trace **) a);
+    r = *((const struct include_trace **) b);
+    if (l->inclusive != r->inclusive) {
+        return l->inclusive < r->inclusive ? 1 : -1;
+    }
+
+    return strcmp(l->name, r->name);
+}
+
+static void write_json_string(FILE *stream, const char *str)
+{
+    putc('"', stream);
+    for (; *str; ++str) {
+        if (*str == '"' || *str == '\\') {
+            fprintf(stream, "\\%c", *str);
+        } else if ((unsigned char) *str < 0x20) {
+            fprintf(stream, "\\u%04x", *str);
+        } else {
+            putc(*str, stream);
+        }
+    }
+
+    putc('"', stream);
+}
+
+static String profile_hash_key(void *ref)
+{
+    return ((struct macro_profile *) ref)->name;
+}
+
+static void *profile_hash_add(void *ref)
+{
+    struct macro_profile *p;
+
+    p = calloc(1, sizeof(*p));
+    *p = *((struct macro_profile *) ref);
+    p->str = calloc(str_len(p->name) + 1, sizeof(*p->str));
+    memcpy(p->str, str_raw(p->name), str_len(p->name));
+    p->name = str_init(p->str);
+    array_push_back(&profile_list, p);
+    return p;
+}
+
+static void profile_hash_del(void *ref)
+{
+    struct macro_profile *p;
+
+    p = (struct macro_profile *) ref;
+    free(p->str);
+    free(p);
+}
+
+INTERNAL int set_macro_profile_file(const char *path)
+{
+    profile_file_name = path;
+    context.profile_macros = 1;
+    return 0;
+}
+
+/*
+ * Expansions are often shorter than the resolution of the clock. Sums
+ * of many measurements are still meaningful, as the error of each one
+ * is as likely to be positive as negative.
+ */
+INTERNAL void trace_macro_begin(void)
+{
+    struct trace_frame frame;
+
+    frame.trace = NULL;
+    frame.children = 0;
+    frame.start = trace_time();
+    array_push_back(&profile_stack, frame);
+}
+
+INTERNAL void trace_macro_end(
+    String name,
+    unsigned depth,
+    unsigned produced,
+    unsigned copied)
+{
+    long elapsed;
+    struct trace_frame frame;
+    struct macro_profile *p, m = {0};
+
+    assert(array_len(&profile_stack));
+    frame = array_pop_back(&profile_stack);
+    elapsed = trace_time() - frame.start;
+    if (array_len(&profile_stack)) {
+        array_back(&profile_stack).children += elapsed;
+    }
+
+    if (!profile_table_initialized) {
+        hash_init(
+            &profile_table,
+            256,
+            profile_hash_key,
+            profile_hash_add,
+            profile_hash_del);
+        profile_table_initialized = 1;
+    }
+
+    m.name = name;
+    p = hash_insert(&profile_table, &m);
+    p->expansions++;
+    p->produced += produced;
+    p->copied += copied;
+    p->inclusive += elapsed;
+    p->exclusive += elapsed - frame.children;
+    if (depth > p->max_depth) {
+        p->max_depth = depth;
+    }
+}
+
+static int compare_profile(const void *a, const void *b)
+{
+    const struct macro_profile *l, *r;
+
+    l = *((const struct macro_profile **) a);
+    r = *((const struct macro_profile **) b);
+    if (l->exclusive != r->exclusive) {
+        return l->exclusive < r->exclusive ? 1 : -1;
+    }
+
+    if (l->expansions != r->expansions) {
+        return l->expansions < r->expansions ? 1 : -1;
+    }
+
+    return strcmp(l->str, r->str);
+}
+
+/*
+ * Write include chain starting from the main source file, ending with
+ * the file itself.
+ */
+static void write_json_chain(FILE *stream, const struct include_trace *t)
+{
+    if (t->parent) {
+        write_json_chain(stream, t->parent);
+        fputs(", ", stream);
+    }
+
+    write_json_string(stream, t->name);
+}
+
+static void write_text_chain(FILE *stream, const struct include_trace *t)
+{
+    if (t->parent) {
+        write_text_chain(stream, t->parent);
+        fputs(" > ", stream);
+    }
+
+    fputs(t->name, stream);
+}
+
+static void write_json_report(FILE *stream)
+{
+    int i;
+    const struct include_trace *t;
+
+    fputs("{\"files\": [", stream);
+    for (i = 0; i < array_len(&trace_list); ++i) {
+        t = array_get(&trace_list, i);
+        fputs(i ? ",\n  {" : "\n  {", stream);
+        fputs("\"path\": ", stream);
+        write_json_string(stream, t->name);
+        fputs(", \"chain\": [", stream);
+        write_json_chain(stream, t);
+        fprintf(stream,
+            "], \"opened\": %lu, \"skipped\": %lu, \"bytes\": %lu"
+            ", \"lines\": %lu, \"tokens\": %lu"
+            ", \"inclusive_us\": %ld, \"exclusive_us\": %ld}",
+            t->opened, t->skipped, t->bytes, t->lines, t->tokens,
+            t->inclusive, t->exclusive);
+    }
+
+    fputs("\n]}\n", stream);
+}
+
+static void write_profile_json_report(FILE *stream)
+{
+    int i;
+    const struct macro_profile *p;
+
+    fputs("{\"macros\": [", stream);
+    for (i = 0; i < array_len(&profile_list); ++i) {
+        p = array_get(&profile_list, i);
+        fputs(i ? ",\n  {" : "\n  {", stream);
+        fputs("\"name\": ", stream);
+        write_json_string(stream, p->str);
+        fprintf(stream,
+            ", \"expansions\": %lu, \"produced\": %lu, \"copied\": %lu"
+            ", \"max_depth\": %u"
+            ", \"inclusive_us\": %ld, \"exclusive_us\": %ld}",
+            p->expansions, p->produced, p->copied, p->max_depth,
+            p->inclusive, p->exclusive);
+    }
+
+    fputs("\n]}\n", stream);
+}
+
+static void write_profile_text_report(FILE *stream)
+{
+    int i;
+    long total;
+    const struct macro_profile *p;
+
+    total = 0;
+    for (i = 0; i < array_len(&profile_list); ++i) {
+        p = array_get(&profile_list, i);
+        total += p->exclusive;
+    }
+
+    fprintf(stream, "Macro profile: %u macros, %.3f ms total.\n",
+        array_len(&profile_list), total / 1000.0);
+    fprintf(stream, "%10s %10s %10s %10s %10s %6s  %s\n",
+        "excl ms", "incl ms", "expansions", "produced", "copied", "depth",
+        "name");
+    for (i = 0; i < array_len(&profile_list); ++i) {
+        p = array_get(&profile_list, i);
+        fprintf(stream, "%10.3f %10.3f %10lu %10lu %10lu %6u  %s\n",
+            p->exclusive / 1000.0, p->inclusive / 1000.0, p->expansions,
+            p->produced, p->copied, p->max_depth, p->str);
+    }
+}
+
+static void write_text_report(FILE *stream)
+{
+    int i;
+    long total;
+    const struct include_trace *t;
+
+    total = 0;
+    for (i = 0; i < array_len(&trace_list); ++i) {
+        t = array_get(&trace_list, i);
+        total += t->exclusive;
+    }
+
+    fprintf(stream, "Include trace: %u files, %.3f ms total.\n",
+        array_len(&trace_list), total / 1000.0);
+    fprintf(stream, "%10s %10s %6s %6s %10s %8s %8s  %s\n",
+        "incl ms", "excl ms", "opened", "skip", "bytes", "lines",
+        "tokens", "path");
+    for (i = 0; i < array_len(&trace_list); ++i) {
+        t = array_get(&trace_list, i);
+        fprintf(stream, "%10.3f %10.3f %6lu %6lu %10lu %8lu %8lu  %s\n",
+            t->inclusive / 1000.0, t->exclusive / 1000.0, t->opened,
+            t->skipped, t->bytes, t->lines, t->tokens, t->name);
+        if (t->parent) {
+            fprintf(stream, "%66s", "from ");
+            write_text_chain(stream, t->parent);
+            putc('\n', stream);
+        }
+    }
+}
+
+/*
+ * Write report to stderr if no file name is given. Files with suffix
+ * '.json' get JSON output.
+ */
+static void write_report(
+    const char *name,
+    void (*write_text)(FILE *),
+    void (*write_json)(FILE *))
+{
+    size_t len;
+    FILE *stream;
+
+    if (name) {
+        stream = fopen(name, "w");
+        if (!stream) {
+            error("Unable to open report file %s.", name);
+            return;
+        }
+        len = strlen(name);
+        if (len > 5 && !strcmp(name + len - 5, ".json")) {
+            write_json(stream);
+        } else {
+            write_text(stream);
+        }
+        fclose(stream);
+    } else {
+        write_text(stderr);
+    }
+}
+
+INTERNAL void trace_report(void)
+{
+    if (context.trace_includes) {
+        qsort(trace_list.data, array_len(&trace_list),
+            sizeof(struct include_trace *), compare_trace);
+        write_report(trace_file_name, write_text_report, write_json_report);
+    }
+
+    if (context.profile_macros) {
+        qsort(profile_list.data, array_len(&profile_list),
+            sizeof(struct macro_profile *), compare_profile);
+        write_report(
+            profile_file_name,
+            write_profile_text_report,
+            write_profile_json_report);
+    }
+}
+
+INTERNAL void trace_finalize(void)
+{
+    if (trace_table_initialized) {
+        hash_destroy(&trace_table);
+        trace_table_initialized = 0;
+    }
+
+    if (profile_table_initialized) {
+        hash_destroy(&profile_table);
+        profile_table_initialized = 0;
+    }
+
+    array_clear(&trace_list);
+    array_clear(&trace_stack);
+    array_clear(&profile_list);
+    array_clear(&profile_stack);
+}
@@ -0,0 +1,62 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <lacc/string.h>
+
+#include <stddef.h>
+
+/*
+ * Profile of files opened by the preprocessor, enabled with option
+ * --trace-includes. For each file, record the chain of includes leading
+ * to it, bytes, lines and tokens read, and time spent while the file is
+ * open, both including and excluding files it includes.
+ *
+ * The report is written to stderr, or to file given by
+ * --trace-includes=<file>. Use suffix '.json' to write JSON instead of
+ * a text report.
+ */
+INTERNAL int set_include_trace_file(const char *path);
+
+/* Called when a file is pushed to, and popped from the include stack. */
+INTERNAL void trace_include_push(String path);
+INTERNAL void trace_include_pop(size_t bytes, int lines);
+
+/* Called when include is skipped because of guard or #pragma once. */
+INTERNAL void trace_include_skip(String path);
+
+/* Count token produced from the file currently being read. */
+INTERNAL void trace_include_token(void);
+
+/*
+ * Profile of macro expansions, enabled with option --profile-macros.
+ * For each macro name, count expansions, tokens produced, argument
+ * tokens substituted in the replacement list, and maximum nesting depth
+ * of expansion. Also record time spent, including and excluding nested
+ * expansions.
+ *
+ * The report is written to stderr, or to file given by
+ * --profile-macros=<file>, in the same format as for includes.
+ */
+INTERNAL int set_macro_profile_file(const char *path);
+
+/*
+ * Called before reading arguments of a macro, and after the expansion
+ * is complete.
+ */
+INTERNAL void trace_macro_begin(void);
+INTERNAL void trace_macro_end(
+    String name,
+    unsigned depth,
+    unsigned produced,
+    unsigned copied);
+
+/*
+ * Write enabled reports. Files are sorted by inclusive time, and macros
+ * by exclusive time.
+ */
+INTERNAL void trace_report(void);
+
+/* Free memory used for tracing. */
+INTERNAL void trace_finalize(void);
+
+#endif
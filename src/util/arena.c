@@ -0,0 +1,91 @@
+#if !AMALGAMATION
+# define INTERNAL
+# define EXTERNAL extern
+#endif
+#include <lacc/arena.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_CHUNK_MIN 0x400
+#define ARENA_CHUNK_MAX 0x10000
+
+/*
+ * Alignment is the same as for malloc, as objects can hold long double
+ * values.
+ */
+#define ARENA_ALIGNMENT 16
+
+static size_t arena_chunk_size(unsigned i)
+{
+    return i < 6 ? (size_t) ARENA_CHUNK_MIN << i : ARENA_CHUNK_MAX;
+}
+
+INTERNAL void *arena_alloc(struct arena *arena, size_t size)
+{
+    char *ptr;
+
+    size = (size + ARENA_ALIGNMENT - 1) & ~(size_t) (ARENA_ALIGNMENT - 1);
+    if (size > ARENA_CHUNK_MAX) {
+        ptr = malloc(size);
+        array_push_back(&arena->large, ptr);
+        return ptr;
+    }
+
+    while (size > (size_t) (arena->end - arena->ptr)) {
+        if (arena->chunk == array_len(&arena->chunks)) {
+            ptr = malloc(arena_chunk_size(arena->chunk));
+            array_push_back(&arena->chunks, ptr);
+        }
+
+        arena->ptr = array_get(&arena->chunks, arena->chunk);
+        arena->end = arena->ptr + arena_chunk_size(arena->chunk);
+        arena->chunk++;
+    }
+
+    ptr = arena->ptr;
+    arena->ptr += size;
+    return ptr;
+}
+
+INTERNAL struct arena_mark arena_mark(const struct arena *arena)
+{
+    struct arena_mark mark;
+
+    mark.chunk = arena->chunk;
+    mark.large = array_len(&arena->large);
+    mark.ptr = arena->ptr;
+    mark.end = arena->end;
+    return mark;
+}
+
+INTERNAL void arena_rewind(struct arena *arena, struct arena_mark mark)
+{
+    while (array_len(&arena->large) > mark.large) {
+        free(array_pop_back(&arena->large));
+    }
+
+    arena->chunk = mark.chunk;
+    arena->ptr = mark.ptr;
+    arena->end = mark.end;
+}
+
+INTERNAL void arena_reset(struct arena *arena)
+{
+    struct arena_mark mark = {0};
+
+    arena_rewind(arena, mark);
+}
+
+INTERNAL void arena_destroy(struct arena *arena)
+{
+    int i;
+
+    arena_reset(arena);
+    for (i = 0; i < array_len(&arena->chunks); ++i) {
+        free(array_get(&arena->chunks, i));
+    }
+
+    array_clear(&arena->chunks);
+    array_clear(&arena->large);
+}
@@ -11,129 +11,113 @@
 struct hash_entry {
     /*
      * We don't own the data, only keep pointers to some block of memory
-     * controlled by the client.
+     * controlled by the client. Empty slots have data set to NULL.
      */
     void *data;
 
+    /*
+     * Full hash value of the key, avoiding string comparison on most
+     * mismatches, and recomputing hashes when growing the table.
+     */
     unsigned long hash;
-    struct hash_entry *next;
 };
 
-enum hash_op {
-    HASH_LOOKUP,
-    HASH_INSERT,
-    HASH_REMOVE
-};
+/* Smallest number of slots allocated. */
+#define HASH_MIN_CAPACITY 8
+
+/* Grow when more than 3/4 of the slots are in use. */
+#define HASH_OVERLOADED(tab) ((tab)->count + 1 > (tab)->capacity / 4 * 3)
 
 /*
- * Hash algorithm is adapted from http://www.cse.yorku.ca/~oz/hash.html.
+ * Hash string a word at a time, mixing each chunk with a multiply and
+ * xor-shift. Strings shorter than a word, which is the common case for
+ * identifiers, are hashed with a single round.
  */
-static unsigned long djb2_hash(String str)
+static unsigned long string_hash(String str)
 {
-    int c;
-    unsigned long hash = 5381;
-    const char
-        *p = str_raw(str),
-        *q = p + str.len;
-
-    while (p < q) {
-        c = *p++;
-        hash = ((hash << 5) + hash) + c; /* hash * 33 + c */
+    size_t i, len;
+    unsigned long w, hash;
+    const char *p;
+
+    len = str_len(str);
+    p = str_raw(str);
+    hash = 0xcbf29ce484222325ul ^ len;
+    for (i = 0; i + sizeof(w) <= len; i += sizeof(w)) {
+        memcpy(&w, p + i, sizeof(w));
+        hash = (hash ^ w) * 0x100000001b3ul;
+        hash ^= hash >> 29;
     }
 
-    return hash;
-}
-
-static struct hash_entry *hash_alloc_entry(struct hash_table *tab)
-{
-    struct hash_entry *ref;
-
-    ref = tab->table[tab->capacity].next;
-    if (ref) {
-        tab->table[tab->capacity].next = ref->next;
-        memset(ref, 0, sizeof(*ref));
-    } else {
-        ref = calloc(1, sizeof(*ref));
+    if (i < len) {
+        w = 0;
+        memcpy(&w, p + i, len - i);
+        hash = (hash ^ w) * 0x100000001b3ul;
+        hash ^= hash >> 29;
     }
 
-    return ref;
+    hash *= 0x9e3779b97f4a7c15ul;
+    return hash ^ (hash >> 32);
 }
 
-static void hash_free_entry(struct hash_table *tab, struct hash_entry *ref)
-{
-    ref->next = tab->table[tab->capacity].next;
-    tab->table[tab->capacity].next = ref;
-}
-
-static struct hash_entry *hash_walk(
+/*
+ * Find slot holding element with the given key, or the empty slot where
+ * it would be inserted.
+ */
+static struct hash_entry *hash_probe(
     struct hash_table *tab,
-    enum hash_op op,
-    String key)
+    String key,
+    unsigned long hash)
 {
-    /*
-     * Sentinel to hold return value from deleted entries, as we want to
-     * have the same interface for all invocations.
-     */
-    static struct hash_entry deleted;
-
-    struct hash_entry *ref, *pre;
-    unsigned long
-        hash = djb2_hash(key),
-        pos = hash % tab->capacity;
+    unsigned long mask, pos;
+    struct hash_entry *ref;
 
-    pre = NULL;
-    ref = &tab->table[pos];
-    while (ref && ref->data) {
-        if (ref->hash == hash && !str_cmp(tab->key(ref->data), key))
+    mask = tab->capacity - 1;
+    pos = hash & mask;
+    while (1) {
+        ref = &tab->table[pos];
+        if (!ref->data) {
             break;
+        }
 
-        if (!ref->next && op == HASH_INSERT)
-            ref->next = hash_alloc_entry(tab);
+        if (ref->hash == hash && !str_cmp(tab->key(ref->data), key)) {
+            break;
+        }
 
-        pre = ref;
-        ref = ref->next;
+        pos = (pos + 1) & mask;
     }
 
-    if (op == HASH_INSERT) {
-        assert(!ref->data || ref->hash == hash);
-        ref->hash = hash;
-    } else if (op == HASH_REMOVE && ref) {
-        if (!ref->data) {
-            assert(!pre);
-            assert(!ref->hash);
-
-            /* Delete in first slot, but no data. Nothing to do. */
-            ref = NULL;
-        } else {
-            deleted.data = ref->data;
-            deleted.hash = ref->hash;
-
-            if (!pre) {
-                /*
-                 * Delete entry in first slot, moving the next element
-                 * in if it exists, or reset to zero.
-                 */
-                if (ref->next) {
-                    pre = ref->next;
-                    *ref = *(ref->next);
-                    hash_free_entry(tab, pre);
-                } else {
-                    memset(ref, 0, sizeof(*ref));
-                }
-            } else {
-                pre->next = ref->next;
-                hash_free_entry(tab, ref);
-            }
+    return ref;
+}
 
-            /*
-             * Entry is freed, but pointer to data as well as hash value
-             * is still valid.
-             */
-            ref = &deleted;
+/*
+ * Double the number of slots, moving existing elements to their new
+ * position using the stored hash values.
+ */
+static void hash_grow(struct hash_table *tab)
+{
+    unsigned i, cap;
+    unsigned long mask, pos;
+    struct hash_entry *old, *ref;
+
+    old = tab->table;
+    cap = tab->capacity;
+    tab->capacity = cap * 2;
+    tab->table = calloc(tab->capacity, sizeof(*tab->table));
+    mask = tab->capacity - 1;
+    for (i = 0; i < cap; ++i) {
+        if (old[i].data) {
+            pos = old[i].hash & mask;
+            while (1) {
+                ref = &tab->table[pos];
+                if (!ref->data)
+                    break;
+                pos = (pos + 1) & mask;
+            }
+            *ref = old[i];
         }
     }
 
-    return ref;
+    free(old);
 }
 
 static void *hash_add_identity(void *elem)
@@ -146,32 +130,6 @@ static void hash_del_noop(void *elem)
     return;
 }
 
-static void hash_chain_free(struct hash_entry *ref, void (*del)(void *))
-{
-    if (ref->next) {
-        hash_chain_free(ref->next, del);
-        free(ref->next);
-    }
-
-    del(ref->data);
-}
-
-static struct hash_entry *hash_chain_clear(
-    struct hash_table *tab,
-    struct hash_entry *ref)
-{
-    struct hash_entry *last = ref;
-    assert(tab->table);
-    assert(ref->data);
-
-    if (ref->next) {
-        last = hash_chain_clear(tab, ref->next);
-    }
-
-    tab->del(ref->data);
-    return last;
-}
-
 INTERNAL struct hash_table *hash_init(
     struct hash_table *tab,
     unsigned cap,
@@ -182,73 +140,69 @@ INTERNAL struct hash_table *hash_init(
     assert(cap > 0);
     assert(key);
 
-    tab->capacity = cap;
+    tab->capacity = HASH_MIN_CAPACITY;
+    while (tab->capacity < cap) {
+        tab->capacity *= 2;
+    }
+
+    tab->count = 0;
     tab->key = key;
     tab->add = add ? add : hash_add_identity;
     tab->del = del ? del : hash_del_noop;
-    tab->table = calloc(tab->capacity + 1, sizeof(*tab->table));
+    tab->table = calloc(tab->capacity, sizeof(*tab->table));
     return tab;
 }
 
 /*
- * Delete all values, putting hash_entry objects already allocated in
- * overflow slot at table[capacity].
+ * Delete all values, keeping the table allocated at its current size.
  */
 INTERNAL void hash_clear(struct hash_table *tab)
 {
     unsigned i;
-    struct hash_entry *ref, *last;
     assert(tab->table);
 
-    for (i = 0; i < tab->capacity; ++i) {
-        ref = &tab->table[i];
-        if (ref->data) {
-            tab->del(ref->data);
-            if (ref->next) {
-                /*
-                 * Put chain of allocated hash_entry objects at the
-                 * beginning of overflow slot.
-                 */
-                last = hash_chain_clear(tab, ref->next);
-                last->next = tab->table[tab->capacity].next;
-                tab->table[tab->capacity].next = ref->next;
+    if (tab->count) {
+        for (i = 0; i < tab->capacity; ++i) {
+            if (tab->table[i].data) {
+                tab->del(tab->table[i].data);
             }
         }
-    }
 
-    memset(tab->table, 0, sizeof(*tab->table) * tab->capacity);
+        memset(tab->table, 0, sizeof(*tab->table) * tab->capacity);
+        tab->count = 0;
+    }
 }
 
 INTERNAL void hash_destroy(struct hash_table *tab)
 {
-    unsigned i;
-    struct hash_entry *ref;
-
     assert(tab->table);
-    for (i = 0; i < tab->capacity; ++i) {
-        ref = &tab->table[i];
-
-        if (ref->data)
-            hash_chain_free(ref, tab->del);
-        else
-            assert(!ref->next);
-    }
-
-    hash_chain_free(&tab->table[tab->capacity], &hash_del_noop);
+    hash_clear(tab);
     free(tab->table);
     memset(tab, 0, sizeof(*tab));
 }
 
 INTERNAL void *hash_insert(struct hash_table *tab, void *val)
 {
+    String key;
+    unsigned long hash;
     struct hash_entry *ref;
 
     assert(val);
     assert(tab->table);
 
-    ref = hash_walk(tab, HASH_INSERT, tab->key(val));
-    if (!ref->data)
+    key = tab->key(val);
+    hash = string_hash(key);
+    ref = hash_probe(tab, key, hash);
+    if (!ref->data) {
+        if (HASH_OVERLOADED(tab)) {
+            hash_grow(tab);
+            ref = hash_probe(tab, key, hash);
+        }
+
         ref->data = tab->add(val);
+        ref->hash = hash;
+        tab->count++;
+    }
 
     return ref->data;
 }
@@ -257,15 +211,47 @@ INTERNAL void *hash_lookup(struct hash_table *tab, String key)
 {
     struct hash_entry *ref;
 
-    ref = hash_walk(tab, HASH_LOOKUP, key);
-    return ref ? ref->data : NULL;
+    ref = hash_probe(tab, key, string_hash(key));
+    return ref->data;
 }
 
+/*
+ * Remove element, and shift following elements in the same probe
+ * sequence back to fill the gap. This keeps every element reachable
+ * from its home slot without leaving tombstones.
+ */
 INTERNAL void hash_remove(struct hash_table *tab, String key)
 {
+    void *data;
+    unsigned long mask, i, j, home;
     struct hash_entry *ref;
 
-    ref = hash_walk(tab, HASH_REMOVE, key);
-    if (ref)
-        tab->del(ref->data);
+    ref = hash_probe(tab, key, string_hash(key));
+    data = ref->data;
+    if (!data)
+        return;
+
+    mask = tab->capacity - 1;
+    i = ref - tab->table;
+    j = i;
+    while (1) {
+        j = (j + 1) & mask;
+        if (!tab->table[j].data)
+            break;
+
+        /*
+         * Element at j can move to the gap at i only if its home slot is
+         * not cyclically within (i, j].
+         */
+        home = tab->table[j].hash & mask;
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            tab->table[i] = tab->table[j];
+            i = j;
+        }
+    }
+
+    tab->table[i].data = NULL;
+    tab->table[i].hash = 0;
+    tab->count--;
+    tab->del(data);
 }
@@ -42,7 +42,7 @@ INTERNAL int fprintstr(FILE *stream, String str)
 
     raw = str_raw(str);
     putc('"', stream);
-    for (n = 0, i = 0; i < str.len; ++i) {
+    for (n = 0, i = 0; i < str_len(str); ++i) {
         n += printchar(stream, raw[i]);
     }
 
@@ -52,12 +52,16 @@ INTERNAL int fprintstr(FILE *stream, String str)
 
 INTERNAL String str_init(const char *str)
 {
+    size_t len;
     String s = {0};
 
-    s.len = strlen(str);
-    if (s.len < SHORT_STRING_LEN) {
-        memcpy(s.a.str, str, s.len);
+    len = strlen(str);
+    if (len < SHORT_STRING_LEN) {
+        s.a.len = len;
+        memcpy(s.a.str, str, len);
     } else {
+        s.p.len = SHORT_STRING_LEN;
+        s.p.size = len;
         s.p.str = str;
     }
 
@@ -77,7 +81,11 @@ INTERNAL int str_cmp(String s1, String s2)
         return a[0] != b[0] || a[1] != b[1];
     }
 
-    return memcmp(s1.p.str, s2.p.str, s1.len);
+    if (s1.p.size != s2.p.size) {
+        return 1;
+    }
+
+    return memcmp(s1.p.str, s2.p.str, s1.p.size);
 }
 
 INTERNAL const char *str_chr(String s, char c)
@@ -86,7 +94,7 @@ INTERNAL const char *str_chr(String s, char c)
     const char *str;
 
     str = str_raw(s);
-    for (i = 0; i < s.len; ++i) {
+    for (i = 0; i < str_len(s); ++i) {
         if (str[i] == c) {
             return str + i;
         }
@@ -0,0 +1,109 @@
+#define INTERNAL
+#define EXTERNAL extern
+#include <lacc/hash.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * Micro-benchmark for hash table, measuring throughput of insert and
+ * lookup with identifier-like keys. Build and run with make bench-hash.
+ *
+ * Tables start at the same fixed capacity as the string table, and keys
+ * are a mix of short names stored inline and long names stored by
+ * pointer, as with identifiers in a large translation unit.
+ */
+#define INITIAL_CAPACITY 1024
+#define ROUNDS 10
+
+static String key_of(void *ref)
+{
+    return *(String *) ref;
+}
+
+static String *make_keys(int n, const char *prefix)
+{
+    int i;
+    char *buf;
+    String *keys;
+
+    keys = calloc(n, sizeof(*keys));
+    for (i = 0; i < n; ++i) {
+        buf = malloc(64);
+        if (i % 4 == 0) {
+            sprintf(buf, "%s_long_identifier_name_%d", prefix, i);
+        } else {
+            sprintf(buf, "%s%d", prefix, i);
+        }
+        keys[i] = str_init(buf);
+    }
+
+    return keys;
+}
+
+static double elapsed(clock_t start, long ops)
+{
+    double sec = (double) (clock() - start) / CLOCKS_PER_SEC;
+    return sec > 0 ? ops / sec / 1e6 : 0;
+}
+
+static void run(int n)
+{
+    int i, r;
+    long found;
+    clock_t start;
+    String *keys, *miss;
+    struct hash_table tab;
+    double insert, hit, fail;
+
+    keys = make_keys(n, "x");
+    miss = make_keys(n, "y");
+    found = 0;
+
+    start = clock();
+    for (r = 0; r < ROUNDS; ++r) {
+        hash_init(&tab, INITIAL_CAPACITY, &key_of, NULL, NULL);
+        for (i = 0; i < n; ++i) {
+            hash_insert(&tab, &keys[i]);
+        }
+        if (r < ROUNDS - 1) {
+            hash_destroy(&tab);
+        }
+    }
+    insert = elapsed(start, (long) n * ROUNDS);
+
+    start = clock();
+    for (r = 0; r < ROUNDS; ++r) {
+        for (i = 0; i < n; ++i) {
+            found += hash_lookup(&tab, keys[i]) != NULL;
+        }
+    }
+    hit = elapsed(start, (long) n * ROUNDS);
+
+    start = clock();
+    for (r = 0; r < ROUNDS; ++r) {
+        for (i = 0; i < n; ++i) {
+            found += hash_lookup(&tab, miss[i]) != NULL;
+        }
+    }
+    fail = elapsed(start, (long) n * ROUNDS);
+
+    if (found != (long) n * ROUNDS) {
+        fprintf(stderr, "Unexpected number of hits: %ld.\n", found);
+        exit(1);
+    }
+
+    printf("%8d keys: %8.2f insert, %8.2f hit, %8.2f miss (Mops/s)\n",
+        n, insert, hit, fail);
+    hash_destroy(&tab);
+}
+
+int main(void)
+{
+    run(1000);
+    run(10000);
+    run(100000);
+    return 0;
+}
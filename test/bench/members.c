@@ -0,0 +1,57 @@
+/*
+ * Benchmark input for struct member lookup, with an aggregate of 1000
+ * members accessed 40000 times through '.', '->' and designators. Run
+ * with make bench-members, which prints user and system time spent
+ * compiling it ten times, first with a build scanning the member list
+ * on every lookup, and then with the index of members.
+ */
+#define M1(p, n) p##n;
+#define M10(p, n) \
+	M1(p, n##0) M1(p, n##1) M1(p, n##2) M1(p, n##3) M1(p, n##4) \
+	M1(p, n##5) M1(p, n##6) M1(p, n##7) M1(p, n##8) M1(p, n##9)
+#define M100(p, n) \
+	M10(p, n##0) M10(p, n##1) M10(p, n##2) M10(p, n##3) M10(p, n##4) \
+	M10(p, n##5) M10(p, n##6) M10(p, n##7) M10(p, n##8) M10(p, n##9)
+#define M1000(p) \
+	M100(p, 0) M100(p, 1) M100(p, 2) M100(p, 3) M100(p, 4) \
+	M100(p, 5) M100(p, 6) M100(p, 7) M100(p, 8) M100(p, 9)
+
+struct protocol {
+	M1000(int m)
+};
+
+#define ADD(n) a.m##n += b->m##n
+#define INIT(n) .m##n = 1,
+
+#undef M1
+#define M1(p, n) ADD(n);
+
+void update(struct protocol *b) {
+	struct protocol a = {0};
+	M1000(x)
+	M1000(x)
+	M1000(x)
+	M1000(x)
+	M1000(x)
+	M1000(x)
+	M1000(x)
+	M1000(x)
+	M1000(x)
+	M1000(x)
+	M1000(x)
+	M1000(x)
+	M1000(x)
+	M1000(x)
+	M1000(x)
+	M1000(x)
+	M1000(x)
+	M1000(x)
+	M1000(x)
+	M1000(x)
+	*b = a;
+}
+
+#undef M1
+#define M1(p, n) INIT(n)
+
+struct protocol initial = { M1000(x) };
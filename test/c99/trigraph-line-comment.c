@@ -0,0 +1,10 @@
+int printf(const char *, ...);
+
+int main(void) {
+	int n = 1;
+	// Trigraph for backslash continues the comment on the next line ??/
+	n = 2;
+	// Other trigraphs at the end of a comment have no effect ??)
+	n += 3;
+	return printf("%d\n", n);
+}
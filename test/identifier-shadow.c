@@ -0,0 +1,34 @@
+int printf(const char *, ...);
+
+typedef int T;
+
+static int x = 1;
+
+#define x x + 1
+
+static int f(T T) {
+	int r = T;
+	{
+		typedef char T;
+		r += sizeof(T) + x;
+#undef x
+		{
+			int x = 10;
+			r += x;
+		}
+	}
+	return r + x;
+}
+
+static int g(void) {
+	T y = sizeof(T);
+	{
+		int T = 3;
+		y += T;
+	}
+	return y;
+}
+
+int main(void) {
+	return printf("%d, %d\n", f(5), g());
+}
@@ -0,0 +1,18 @@
+#include <stdio.h>
+
+int main(void) {
+	int n = 0;
+
+#include "include-guard.h"
+#include "include-guard.h"
+#include "include-unguarded.h"
+#include "include-unguarded.h"
+#undef INCLUDE_GUARD_H
+#include "include-guard.h"
+#include "pragma-once.h"
+#include "./pragma-once.h"
+#include "pragma-once.h"
+
+	printf("%d\n", n);
+	return 0;
+}
@@ -0,0 +1,6 @@
+#ifndef INCLUDE_GUARD_H
+#define INCLUDE_GUARD_H
+
+n += 1;
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef INCLUDE_PCH_DECL_H
+#define INCLUDE_PCH_DECL_H
+
+#include <stddef.h>
+
+#define PCH_DECL_LENGTH 3
+
+typedef struct pch_list {
+	struct pch_list *next;
+	const char *name;
+	unsigned flag : 1, kind : 3;
+	union {
+		long l;
+		double d;
+	} value;
+} pch_list_t;
+
+struct pch_wide {
+	char a, b, c, d, e, f, g, h;
+	short i, j, k, l, m, n, o, p;
+	int q[PCH_DECL_LENGTH];
+	struct {
+		int r, s;
+	};
+};
+
+enum pch_color { PCH_RED, PCH_GREEN = 4, PCH_BLUE };
+
+typedef int (*pch_compare_t)(const void *, const void *);
+
+extern int pch_table[];
+
+extern const pch_list_t *volatile pch_head;
+
+int pch_sum(int count, ...);
+
+size_t pch_length(const struct pch_list *list);
+
+void pch_visit(struct pch_visitor *visitor, pch_compare_t compare);
+
+#endif
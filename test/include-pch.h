@@ -0,0 +1,22 @@
+#ifndef INCLUDE_PCH_H
+#define INCLUDE_PCH_H
+
+#define PCH_MAX(a, b) ((a) > (b) ? (a) : (b))
+#undef PCH_MAX
+#define PCH_MAX(a, b) ((a) < (b) ? (b) : (a))
+
+struct pch_point {
+	int x, y;
+};
+
+enum { PCH_ENUM = 'p' };
+
+static const char *pch_string = "pre" "compiled";
+
+static const double pch_number = 1.5e3;
+
+static int pch_max(int a, int b) {
+	return PCH_MAX(a, b) + (int) sizeof(struct pch_point);
+}
+
+#endif
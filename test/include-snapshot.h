@@ -0,0 +1,15 @@
+#ifndef INCLUDE_SNAPSHOT_H
+#define INCLUDE_SNAPSHOT_H
+
+#include "include-guard.h"
+#include "pragma-once.h"
+
+#define SNAPSHOT_MAX(a, b) ((a) > (b) ? (a) : (b))
+#undef SNAPSHOT_MAX
+#define SNAPSHOT_MAX(a, b) ((a) < (b) ? (b) : (a))
+
+static const char *snapshot_string = "snap" "shot";
+
+static int snapshot_max = SNAPSHOT_MAX(1, 0);
+
+#endif
@@ -0,0 +1,4 @@
+#ifndef INCLUDE_GUARD_H
+n += 10;
+#endif
+n += 100;
@@ -0,0 +1,13 @@
+#!/bin/sh
+# Dependencies written with -M, -MM, -MP and -MT, and as a side effect
+# of compiling with -MD.
+
+lacc="$1"
+dir="$2"
+file=test/include-guard.c
+
+$lacc -MM -MP -MT include-guard.o $file > $dir/actual.d || exit 1
+diff test/input/dependencies.d $dir/actual.d || exit 1
+$lacc -M -MT $dir/include-guard.o $file -o $dir/expected.d || exit 1
+$lacc -c -MD $file -o $dir/include-guard.o || exit 1
+diff $dir/expected.d $dir/include-guard.d
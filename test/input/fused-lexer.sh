@@ -0,0 +1,18 @@
+#!/bin/sh
+# Preprocessed output is the same when tokenizing directly from the
+# source buffer with -ffused-lexer.
+
+lacc="$1"
+dir="$2"
+retval=0
+files=$(find test/ src/ -path test/input -prune \
+	-o -type f -iname '*.c' -print)
+
+for file in $files ; do
+	$lacc -E -Iinclude $file > $dir/expected.i \
+		&& $lacc -E -Iinclude -ffused-lexer $file > $dir/actual.i \
+		&& cmp -s $dir/expected.i $dir/actual.i \
+		|| { echo "$file" >&2; retval=1; }
+done
+
+exit $retval
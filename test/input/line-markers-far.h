@@ -0,0 +1,13 @@
+/*
+ * Declaration is more than 8 lines after the start of the file, and
+ * is reached by a line marker instead of blank lines.
+ */
+
+
+
+
+
+
+
+
+int far;
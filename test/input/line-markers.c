@@ -0,0 +1,13 @@
+#include "line-markers.h"
+#define N 2
+int a = N;
+
+
+
+
+
+
+
+
+
+int b;
@@ -0,0 +1,5 @@
+/* Included by line-markers.c. */
+
+int h;
+#include "line-markers-far.h"
+int i;
@@ -0,0 +1,15 @@
+# 1 "test/input/line-markers.c"
+# 1 "test/input/line-markers.h" 1
+
+
+int h;
+# 1 "test/input/line-markers-far.h" 1
+# 13 "test/input/line-markers-far.h"
+int far;
+# 5 "test/input/line-markers.h" 2
+int i;
+# 2 "test/input/line-markers.c" 2
+
+int a = 2;
+# 13 "test/input/line-markers.c"
+int b;
@@ -0,0 +1,12 @@
+#!/bin/sh
+# Output of -E has line markers in the same format as GCC, or no line
+# markers with -P.
+
+lacc="$1"
+dir="$2"
+path=test/input/line-markers
+
+$lacc -E $path.c > $dir/actual.i || exit 1
+diff $path.i $dir/actual.i || exit 1
+$lacc -E -P $path.c > $dir/actual.i || exit 1
+grep -v -e '^#' -e '^$' $path.i | diff - $dir/actual.i
@@ -0,0 +1 @@
+int which = WHICH;
@@ -0,0 +1 @@
+#include "which.h"
@@ -0,0 +1,13 @@
+#!/bin/sh
+# Precompiled header is not used when include search paths resolve to
+# different files than when it was built.
+
+lacc="$1"
+dir="$2"
+path=test/input/pch-search-path
+
+$lacc -I$path/a -x c-header $path.h -o $dir/header.pch || exit 1
+$lacc -S -I$path/b -include $path.h $path.c -o $dir/expected.s || exit 1
+$lacc -S -I$path/b -include-pch $dir/header.pch $path.c \
+	-o $dir/actual.s 2> /dev/null || exit 1
+cmp $dir/expected.s $dir/actual.s
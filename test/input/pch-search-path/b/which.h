@@ -0,0 +1 @@
+#define WHICH 2
@@ -0,0 +1,25 @@
+#!/bin/sh
+# Compiling with -include-pch gives the same output as -include of the
+# header it was built from, both for headers stored as parsed
+# declarations and for headers stored as tokens.
+
+lacc="$1"
+dir="$2"
+retval=0
+files=$(find test/ -maxdepth 1 -iname '*.c' ! -name macro-predefined.c)
+
+for header in test/include-pch.h test/include-pch-decl.h ; do
+	$lacc -Iinclude -x c-header $header -o $dir/header.pch || exit 1
+	for file in $files ; do
+		if $lacc -S -Iinclude -include $header \
+			$file -o $dir/expected.s 2> /dev/null
+		then
+			$lacc -S -Iinclude -include-pch $dir/header.pch \
+				$file -o $dir/actual.s
+			cmp -s $dir/expected.s $dir/actual.s \
+				|| { echo "$header: $file" >&2; retval=1; }
+		fi
+	done
+done
+
+exit $retval
@@ -0,0 +1,2 @@
+int a;
+#error boom
@@ -0,0 +1,4 @@
+#include <stddef.h>
+int f(void) {
+    return 1 + ;
+}
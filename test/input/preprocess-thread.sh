@@ -0,0 +1,28 @@
+#!/bin/sh
+# Compiling with -fpreprocess-thread gives the same output and the same
+# diagnostics, in the same order, as preprocessing on the main thread.
+
+lacc="$1"
+dir="$2"
+path=test/input/preprocess-thread
+retval=0
+files=$(find test/ -maxdepth 1 -iname '*.c' ! -name macro-predefined.c)
+
+for file in $files $path-syntax.c $path-error.c $path-order.c ; do
+	$lacc -S -Iinclude $file -o $dir/expected.s 2> $dir/expected.err
+	$lacc -S -Iinclude -fpreprocess-thread $file -o $dir/actual.s \
+		2> $dir/actual.err
+	cmp -s $dir/expected.s $dir/actual.s \
+		&& cmp -s $dir/expected.err $dir/actual.err \
+		|| { echo "$file" >&2; retval=1; }
+done
+
+$lacc -S -fpreprocess-thread $path-syntax.c -o $dir/actual.s \
+	2> $dir/actual.err
+grep -q "^($path-syntax.c, 3) error" $dir/actual.err || retval=1
+
+$lacc -S -fpreprocess-thread $path-error.c -o $dir/actual.s \
+	2> $dir/actual.err
+grep -q "^($path-error.c, 2) error: boom" $dir/actual.err || retval=1
+
+exit $retval
@@ -0,0 +1,10 @@
+#!/bin/sh
+# Macro expansions are counted by --profile-macros.
+
+lacc="$1"
+dir="$2"
+
+$lacc -E --profile-macros=$dir/profile.json test/stringify.c \
+	> $dir/actual.i || exit 1
+grep -qF '"name": "STR", "expansions": 18, "produced": 18, "copied": 64, "max_depth": 1,' \
+	$dir/profile.json
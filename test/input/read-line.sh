@@ -0,0 +1,19 @@
+#!/bin/sh
+# Preprocessed output is the same when reading lines one character at
+# a time, in a build with -DREAD_LINE_SCALAR.
+
+lacc="$1"
+dir="$2"
+scalar=bin/scalar/lacc
+retval=0
+files=$(find test/ src/ -path test/input -prune \
+	-o -type f -iname '*.c' -print)
+
+for file in $files ; do
+	$lacc -E -Iinclude $file > $dir/expected.i \
+		&& $scalar -E -Iinclude $file > $dir/actual.i \
+		&& cmp -s $dir/expected.i $dir/actual.i \
+		|| { echo "$file" >&2; retval=1; }
+done
+
+exit $retval
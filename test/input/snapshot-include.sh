@@ -0,0 +1,18 @@
+#!/bin/sh
+# Preprocessing many inputs with -fsnapshot-include gives the same
+# output as reading the -include file again for each of them.
+
+lacc="$1"
+dir="$2"
+retval=0
+files=$(find test/ -maxdepth 1 -iname '*.c' ! -name macro-predefined.c)
+
+for flags in -P "" ; do
+	$lacc -E $flags -Iinclude -include test/include-snapshot.h \
+		$files > $dir/expected.i || exit 1
+	$lacc -E $flags -Iinclude -include test/include-snapshot.h \
+		-fsnapshot-include $files > $dir/actual.i || exit 1
+	cmp $dir/expected.i $dir/actual.i || retval=1
+done
+
+exit $retval
@@ -0,0 +1,2 @@
+int f(int a) { return a ? a + 1 : 2; }
+int g(int a) { return a ? a + 1 : 2; }
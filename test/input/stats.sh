@@ -0,0 +1,14 @@
+#!/bin/sh
+# Allocation statistics are reported by --stats. Temporaries of the
+# first function are released after it is compiled, and recycled for
+# the second. Counts are compared to each other rather than to fixed
+# numbers, which change with the parser.
+
+lacc="$1"
+dir="$2"
+
+$lacc -S --stats test/input/stats.c -o $dir/actual.s 2> $dir/stats.txt \
+	|| exit 1
+set -- $(grep '^Symbols: ' $dir/stats.txt)
+test "$3 $5 $7" = "allocated, recycled, slabs." || exit 1
+test $2 -gt 0 && test $4 -gt 0 && test $4 -lt $2 && test $6 -gt 0
@@ -0,0 +1,67 @@
+#!/bin/sh
+# Cache entries with inconsistent content are not used, and the header
+# is read again from source. Fields are written in the native layout of
+# x86_64; an int is 4 bytes and the header has 12 fields of 8 bytes
+# after the magic string padded to 16 bytes.
+
+lacc="$1"
+dir="$2"
+path=test/input/token-cache
+retval=0
+
+mkdir $dir/cache
+$lacc -E -P $path.c > $dir/expected.i || exit 1
+$lacc -E -P -ftoken-cache=$dir/cache $path.c > $dir/actual.i || exit 1
+cmp $dir/expected.i $dir/actual.i || exit 1
+entry=$(ls $dir/cache/*.tok) && cp $entry $dir/entry.tok || exit 1
+
+# Valid entry is loaded, and not replaced by writing a new file.
+inode=$(ls -i $entry)
+$lacc -E -P -ftoken-cache=$dir/cache $path.c > $dir/actual.i || exit 1
+cmp $dir/expected.i $dir/actual.i && test "$inode" = "$(ls -i $entry)" \
+	|| exit 1
+
+set -- $(od -A n -t d8 -j 16 -N 96 $entry)
+path_size=$7
+strings=$8
+chars=$9
+shift 9
+lines=$1
+tokens=$2
+lines_offset=$((112 + path_size + strings * 4 + chars))
+tokens_offset=$((lines_offset + lines * 12))
+
+# Index of first line stored as tokens, and first line stored as text.
+set -- $(od -A n -t d4 -v -j $lines_offset -N $((lines * 12)) $entry \
+	| tr -s ' \n' '\n\n' | grep . | awk '
+		NR % 3 == 2 && $1 != -1 && t == "" { t = (NR - 2) / 3 }
+		NR % 3 == 0 && $1 != -1 && s == "" { s = (NR - 3) / 3 }
+		END { print t, s }')
+token_line=$((lines_offset + $1 * 12))
+text_line=$((lines_offset + $2 * 12))
+
+# Overwrite int at offset with value, and preprocess using the entry.
+check()
+{
+	cp $dir/entry.tok $entry
+	printf "$(printf '\\%03o\\%03o\\%03o\\%03o' \
+		$(($2 & 255)) $((($2 >> 8) & 255)) \
+		$((($2 >> 16) & 255)) $((($2 >> 24) & 255)))" \
+		| dd of=$entry bs=1 seek=$1 conv=notrunc 2> /dev/null
+	$lacc -E -P -ftoken-cache=$dir/cache $path.c > $dir/actual.i \
+		&& cmp -s $dir/expected.i $dir/actual.i \
+		|| { echo "$3" >&2; retval=1; }
+}
+
+check 24 8 "token record size"
+check $((token_line + 4)) -2 "negative token offset"
+check $((token_line + 4)) $tokens "token offset out of range"
+check $((token_line + 4)) -1 "neither offset"
+check $((token_line + 8)) 0 "both offsets"
+check $((text_line + 8)) -2 "negative text offset"
+check $((text_line + 4)) 0 "both offsets"
+check $tokens_offset 127 "unknown token"
+check $tokens_offset 1000 "unknown token"
+check $((tokens_offset + (tokens - 1) * 16)) 59 "tokens not ending in END"
+
+exit $retval
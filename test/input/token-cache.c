@@ -0,0 +1,5 @@
+#include "token-cache.h"
+
+int cached(int a) {
+    return CACHED(a);
+}
@@ -0,0 +1,12 @@
+#ifndef TOKEN_CACHE_H
+#define TOKEN_CACHE_H
+
+#if 0
+skipped line
+#endif
+
+#define CACHED(a) (a + 1)
+
+int cached(int a);
+
+#endif
@@ -0,0 +1,19 @@
+#!/bin/sh
+# Preprocessed output is the same with -ftoken-cache, both for headers
+# stored to the cache and headers loaded from it by later inputs.
+
+lacc="$1"
+dir="$2"
+retval=0
+files=$(find test/ src/ -path test/input -prune \
+	-o -type f -iname '*.c' -print)
+
+mkdir $dir/cache
+for file in $files ; do
+	$lacc -E -Iinclude $file > $dir/expected.i \
+		&& $lacc -E -Iinclude -ftoken-cache=$dir/cache $file > $dir/actual.i \
+		&& cmp -s $dir/expected.i $dir/actual.i \
+		|| { echo "$file" >&2; retval=1; }
+done
+
+exit $retval
@@ -0,0 +1,11 @@
+#!/bin/sh
+# Included files are reported by --trace-includes with the chain of
+# files including them, and counts of what was read.
+
+lacc="$1"
+dir="$2"
+
+$lacc -E --trace-includes=$dir/trace.json test/include-guard.c \
+	> $dir/actual.i || exit 1
+grep -qF '"path": "test/pragma-once.h", "chain": ["test/include-guard.c", "test/pragma-once.h"], "opened": 1, "skipped": 2, "bytes": 25, "lines": 3, "tokens": 7,' \
+	$dir/trace.json
@@ -0,0 +1,10 @@
+#define EXPAND(x) x
+#define PICK(x) EXPAND
+#define OUTER(x) PICK(x)(x + 1)
+#define TWICE(x) OUTER(x) * 2
+
+int printf(const char *, ...);
+
+int main(void) {
+	return printf("%d %d %d\n", OUTER(1), TWICE(2), EXPAND(OUTER(3)));
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+n += 1000;
@@ -0,0 +1,28 @@
+int printf(const char *, ...);
+
+#if 0
+This is not C, and should never be tokenized: 1.0.0 @ $ ` 0x.p
+	indented text /* comment with
+#endif
+	inside */ still skipped
+"a string /* not a comment" and '"'
+// line comment \
+#endif
+  /* comment before */ # define A 1
+??= define B 2
+text \
+#endif
+#else
+# define C 3
+#endif
+
+#ifdef C
+int c = C;
+#endif
+
+int main(void) {
+#if defined(A) || defined(B)
+	return 1;
+#endif
+	return printf("%d, %d\n", c, __LINE__);
+}
@@ -0,0 +1,18 @@
+int printf(const char *, ...);
+unsigned long strlen(const char *s);
+
+#define S16 "0123456789abcdef"
+#define S64 S16 S16 S16 S16
+#define S256 S64 S64 S64 S64
+#define S1K S256 S256 S256 S256
+#define S4K S1K S1K S1K S1K
+#define S16K S4K S4K S4K S4K
+#define S64K S16K S16K S16K S16K
+
+static const char str[] = S64K "!" S16 "\0" S16;
+
+int main(void) {
+	printf("%lu %lu %c %c\n",
+		(unsigned long) sizeof(str), strlen(str), str[65535], str[65536]);
+	return str[65551] == 'f';
+}
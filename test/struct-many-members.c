@@ -0,0 +1,36 @@
+int printf(const char *, ...);
+
+struct header {
+	char a, b, c, d, e, f, g, h;
+	union {
+		int i;
+		struct {
+			short j, k;
+		};
+	};
+	long l, m, n, o, p, q, r, s, t, u;
+	struct {
+		char v;
+		double w;
+	};
+	int x, y, z;
+};
+
+static struct header init = {
+	.z = 26,
+	.a = 1,
+	.j = 10,
+	.w = 2.5,
+	.k = 11,
+	.u = 21
+};
+
+int main(void) {
+	struct header h = init, *p = &h;
+
+	p->v = 22;
+	h.x = p->a + p->u;
+	return printf("%d, %d, %d, %d, %ld, %d, %f, %d, %d, %lu\n",
+		h.a, p->j, h.k, p->i == init.i, p->u, h.v, h.w, p->x, h.z,
+		sizeof(h));
+}
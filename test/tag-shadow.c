@@ -0,0 +1,53 @@
+int printf(const char *, ...);
+
+struct s {
+	int a;
+} s = {1};
+
+enum e { A = 2 };
+
+static int f(int n) {
+	struct s t = {3};
+	int r = t.a;
+	{
+		struct u {
+			char b[7];
+		} u;
+		enum e { A = 8, s };
+		r += sizeof(u) + A + s;
+		{
+			enum e { A = 32 };
+			struct v {
+				long c;
+			} v = {16};
+			r += v.c + sizeof(struct u) + A;
+		}
+		r += A;
+	}
+	{
+		struct u {
+			short b[2];
+		} u = {{5, 6}};
+		r += u.b[1] + sizeof(struct u);
+	}
+	if (n) {
+		goto s;
+	}
+	r += 100;
+s:
+	return r + sizeof(struct s) + A;
+}
+
+static int g(void) {
+	int e = 1;
+	goto s;
+e:
+	return e;
+s:
+	e += sizeof(enum e);
+	goto e;
+}
+
+int main(void) {
+	return printf("%d, %d, %d, %d\n", f(0), f(1), g(), s.a);
+}
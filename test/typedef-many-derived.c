@@ -0,0 +1,39 @@
+int printf(const char *, ...);
+
+/*
+ * Declare 100000 distinct array types, pointers to pointers to each of
+ * them, and the same array types once more.
+ */
+#define T(a, b, c, d, e) \
+	typedef char t##a##b##c##d##e[1##a##b##c##d##e]; \
+	typedef char (**u##a##b##c##d##e)[1##a##b##c##d##e]; \
+	typedef char v##a##b##c##d##e[1##a##b##c##d##e];
+
+#define E(a, b, c, d) \
+	T(a, b, c, d, 0) T(a, b, c, d, 1) T(a, b, c, d, 2) T(a, b, c, d, 3) \
+	T(a, b, c, d, 4) T(a, b, c, d, 5) T(a, b, c, d, 6) T(a, b, c, d, 7) \
+	T(a, b, c, d, 8) T(a, b, c, d, 9)
+
+#define D(a, b, c) \
+	E(a, b, c, 0) E(a, b, c, 1) E(a, b, c, 2) E(a, b, c, 3) E(a, b, c, 4) \
+	E(a, b, c, 5) E(a, b, c, 6) E(a, b, c, 7) E(a, b, c, 8) E(a, b, c, 9)
+
+#define C(a, b) \
+	D(a, b, 0) D(a, b, 1) D(a, b, 2) D(a, b, 3) D(a, b, 4) \
+	D(a, b, 5) D(a, b, 6) D(a, b, 7) D(a, b, 8) D(a, b, 9)
+
+#define B(a) \
+	C(a, 0) C(a, 1) C(a, 2) C(a, 3) C(a, 4) \
+	C(a, 5) C(a, 6) C(a, 7) C(a, 8) C(a, 9)
+
+B(0) B(1) B(2) B(3) B(4) B(5) B(6) B(7) B(8) B(9)
+
+int main(void) {
+	static t01234 a;
+	v01234 *p = &a;
+	u99999 q = 0;
+	u00000 r = 0;
+
+	return printf("%lu, %lu, %lu, %lu\n",
+		sizeof(*p), sizeof(**q), sizeof(**r), sizeof(t54321));
+}